@@ -15,6 +15,7 @@
 #include <atomic>
 #include <chrono>  // NOLINT
 #include <cstdint>
+#include <string>
 
 /** Cycle detection is performed every CYCLE_DETECTION_INTERVAL milliseconds. */
 extern std::chrono::milliseconds cycle_detection_interval;
@@ -33,6 +34,13 @@ static constexpr int INVALID_LSN = -1;                                        //
 static constexpr int HEADER_PAGE_ID = 0;                                      // the header page id
 static constexpr int PAGE_SIZE = 4096;                                        // size of a data page in byte
 static constexpr int BUFFER_POOL_SIZE = 65536;                                // size of buffer pool
+static constexpr int BUFFER_POOL_INSTANCES = 16;                              // number of buffer pool shards
+static constexpr bool BUFFER_POOL_HUGE_PAGES = false;                         // back frame data with huge pages
+static constexpr int BUFFER_POOL_MAX_GROWTH = 4;      // default max size of an online resize, in multiples of the size
+static constexpr std::chrono::milliseconds BUFFER_POOL_DRAIN_TIMEOUT{1000};  // resize waits this long for pinned frames
+static constexpr bool ENABLE_OPTIMISTIC_LATCH = true;    // index lookups validate page versions instead of RLatch
+static constexpr int OPTIMISTIC_LATCH_RETRIES = 3;       // optimistic attempts before falling back to RLatch
+static constexpr int SCAN_RING_SIZE = 32;                                     // frames per shard used by a large scan
 static constexpr int LOG_BUFFER_SIZE = ((BUFFER_POOL_SIZE + 1) * PAGE_SIZE);  // size of a log buffer in byte
 static constexpr int BUCKET_SIZE = 50;                                        // size of extendible hash bucket
 
@@ -49,3 +57,29 @@ static const std::string LOG_FILE_NAME = "db.log";
 
 // replacer
 static const std::string REPLACER_TYPE = "LRU";
+static constexpr size_t LRUK_REPLACER_K = 2;  // number of historical accesses tracked by LRUKReplacer
+
+// background page cleaner
+static constexpr bool ENABLE_BG_CLEANER = true;                          // start a page cleaner per buffer pool shard
+static constexpr std::chrono::milliseconds BG_CLEANER_INTERVAL{100};     // the cleaner wakes up every interval
+static constexpr double BG_CLEANER_DIRTY_RATIO = 0.25;                   // target upper bound of dirty frames
+static constexpr size_t BG_CLEANER_SCAN_DEPTH = 64;                      // frames kept clean at the eviction end
+static constexpr size_t BG_CLEANER_MAX_PAGES = 128;                      // max pages written per round
+
+// sequential read-ahead
+static constexpr bool ENABLE_READ_AHEAD = true;  // prefetch pages ahead of sequential scans
+static constexpr int READ_AHEAD_TRIGGER = 2;     // consecutive accesses of a file before read-ahead starts
+static constexpr int READ_AHEAD_PAGES = 32;      // pages read ahead of a sequential scan
+
+// asynchronous disk I/O
+static const std::string ASYNC_IO_BACKEND = "io_uring";  // io_uring or threads, io_uring falls back to threads
+static constexpr size_t ASYNC_IO_QUEUE_DEPTH = 256;      // io_uring submission queue entries
+static constexpr size_t ASYNC_IO_THREADS = 4;            // pread/pwrite threads of the fallback backend
+
+// disk space management
+static constexpr int DISK_EXTENT_PAGES = 64;  // pages preallocated with fallocate when a file grows, 0 disables it
+static constexpr bool MMAP_READ_ONLY = false;  // open data files read-only and read pages through mmap
+static constexpr bool DIRECT_IO = false;       // bypass the kernel page cache with O_DIRECT for data files
+
+// compressed second-tier page cache
+static constexpr size_t COMPRESSED_CACHE_MB = 0;  // memory for compressed copies of evicted pages, 0 disables it
@@ -12,6 +12,23 @@ void ReaderWriterLatch::WLock() {
   while (reader_count_ > 0) {
     writer_.wait(latch);
   }
+  version_.fetch_add(1, std::memory_order_relaxed);
+  // the odd version must be visible before any write to the protected data
+  std::atomic_thread_fence(std::memory_order_release);
+}
+
+/**
+ * Try to acquire a write latch without waiting.
+ */
+bool ReaderWriterLatch::TryWLock() {
+  std::lock_guard<mutex_t> guard(mutex_);
+  if (writer_entered_ || reader_count_ > 0) {
+    return false;
+  }
+  writer_entered_ = true;
+  version_.fetch_add(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  return true;
 }
 
 /**
@@ -19,6 +36,7 @@ void ReaderWriterLatch::WLock() {
  */
 void ReaderWriterLatch::WUnlock() {
   std::lock_guard<mutex_t> guard(mutex_);
+  version_.fetch_add(1, std::memory_order_release);
   writer_entered_ = false;
   reader_.notify_all();
 }
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <climits>
 #include <condition_variable>  // NOLINT
 #include <mutex>               // NOLINT
@@ -20,6 +21,11 @@
 
 /**
  * Reader-Writer latch backed by std::mutex.
+ *
+ * The latch also keeps a version counter for optimistic readers: WLock makes the version odd and WUnlock makes it
+ * even again, so every write section changes it. An optimistic reader takes a snapshot of an even version, reads the
+ * protected data without touching the mutex, and then validates that the version is unchanged; on failure the data
+ * it read may be torn and must be discarded.
  */
 class ReaderWriterLatch {
   using mutex_t = std::mutex;
@@ -37,6 +43,12 @@ class ReaderWriterLatch {
    */
   void WLock();
 
+  /**
+   * Try to acquire a write latch without waiting.
+   * @return false if a reader or another writer holds the latch
+   */
+  bool TryWLock();
+
   /**
    * Release a write latch.
    */
@@ -52,10 +64,32 @@ class ReaderWriterLatch {
    */
   void RUnlock();
 
+  /**
+   * Begin an optimistic read without acquiring the latch.
+   * @param[out] version the version to validate against when the read is done
+   * @return false if a writer currently holds the latch
+   */
+  bool TryOptimisticRead(uint64_t *version) const {
+    *version = version_.load(std::memory_order_acquire);
+    return (*version & 1) == 0;
+  }
+
+  /**
+   * Validate an optimistic read started by TryOptimisticRead.
+   * @return true if no writer entered since the version was taken, so everything read in between is consistent
+   */
+  bool ValidateOptimisticRead(uint64_t version) const {
+    // order the reads of the protected data before the second read of the version
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return version_.load(std::memory_order_relaxed) == version;
+  }
+
  private:
   mutex_t mutex_;
   cond_t writer_;
   cond_t reader_;
   uint32_t reader_count_{0};
   bool writer_entered_{false};
+  /** odd while a writer holds the latch, only written by the writer */
+  std::atomic<uint64_t> version_{0};
 };
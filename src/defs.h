@@ -30,18 +30,25 @@ struct Rid {
 };
 
 enum ColType {
-    TYPE_INT, TYPE_FLOAT, TYPE_STRING
+    TYPE_INT, TYPE_FLOAT, TYPE_STRING, TYPE_VARCHAR
 };
 
 inline std::string coltype2str(ColType type) {
     std::map<ColType, std::string> m = {
-            {TYPE_INT,    "INT"},
-            {TYPE_FLOAT,  "FLOAT"},
-            {TYPE_STRING, "STRING"}
+            {TYPE_INT,     "INT"},
+            {TYPE_FLOAT,   "FLOAT"},
+            {TYPE_STRING,  "STRING"},
+            {TYPE_VARCHAR, "VARCHAR"}
     };
     return m.at(type);
 }
 
+/**
+ * @brief 列中值的类型
+ * @note VARCHAR列的值和CHAR列一样是以'\0'补齐到列长度的字符串, 只是在记录文件中按实际长度存放
+ */
+inline ColType value_type(ColType type) { return type == TYPE_VARCHAR ? TYPE_STRING : type; }
+
 class RecScan {
 public:
     virtual ~RecScan() = default;
@@ -34,6 +34,11 @@ class FileNotClosedError : public RedBaseError {
     FileNotClosedError(const std::string &filename) : RedBaseError("File is opened: " + filename) {}
 };
 
+class FileReadOnlyError : public RedBaseError {
+   public:
+    FileReadOnlyError(const std::string &filename) : RedBaseError("File is opened read-only: " + filename) {}
+};
+
 class FileExistsError : public RedBaseError {
    public:
     FileExistsError(const std::string &filename) : RedBaseError("File already exists: " + filename) {}
@@ -56,6 +61,12 @@ class InvalidRecordSizeError : public RedBaseError {
     InvalidRecordSizeError(int record_size) : RedBaseError("Invalid record size: " + std::to_string(record_size)) {}
 };
 
+class TooManyVarFieldsError : public RedBaseError {
+   public:
+    TooManyVarFieldsError(int num_fields)
+        : RedBaseError("Too many variable-length fields: " + std::to_string(num_fields)) {}
+};
+
 // IX errors
 class InvalidColLengthError : public RedBaseError {
    public:
@@ -131,4 +142,19 @@ class PageNotExistError : public RedBaseError {
    public:
     PageNotExistError(const std::string &table_name, int page_no)
         : RedBaseError("Page " + std::to_string(page_no) + " in table " + table_name + "not exits") {}
-};
\ No newline at end of file
+};
+
+class PageOutOfRangeError : public RedBaseError {
+   public:
+    PageOutOfRangeError(int fd, int page_no, int num_pages)
+        : RedBaseError("Page " + std::to_string(page_no) + " of fd " + std::to_string(fd) + " out of allocated range [0, " +
+                       std::to_string(num_pages) + ")") {}
+};
+// Config errors
+class ConfigError : public RedBaseError {
+   public:
+    ConfigError(const std::string &key) : RedBaseError("Invalid config option: " + key) {}
+
+    ConfigError(const std::string &key, const std::string &value)
+        : RedBaseError("Invalid value for config option " + key + ": " + value) {}
+};
@@ -3,21 +3,30 @@
 #include "execution.h"
 #include "gtest/gtest.h"
 #include "interp_test.h"
+#include "storage/buffer_pool_manager_instance.h"
 
 #define BUFFER_LENGTH 8192
 
 std::string db_name_ = "ExecutorTest_db";
-std::unique_ptr<DiskManager> disk_manager_ = std::make_unique<DiskManager>();
-std::unique_ptr<BufferPoolManager> buffer_pool_manager_ =
-    std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager_.get());
-std::unique_ptr<RmManager> rm_manager_ = std::make_unique<RmManager>(disk_manager_.get(), buffer_pool_manager_.get());
-std::unique_ptr<IxManager> ix_manager_ = std::make_unique<IxManager>(disk_manager_.get(), buffer_pool_manager_.get());
-std::unique_ptr<SmManager> sm_manager_ =
-    std::make_unique<SmManager>(disk_manager_.get(), buffer_pool_manager_.get(), rm_manager_.get(), ix_manager_.get());
-
-std::unique_ptr<QlManager> ql_manager_ = std::make_unique<QlManager>(sm_manager_.get());
-
-std::unique_ptr<InterpForTest> interp_ = std::make_unique<InterpForTest>(sm_manager_.get(), ql_manager_.get());
+// BufferPoolManagerInstance构造时读取buffer_pool_options, 不能在静态初始化阶段创建, 因此各模块在init_managers中创建
+std::unique_ptr<DiskManager> disk_manager_;
+std::unique_ptr<BufferPoolManager> buffer_pool_manager_;
+std::unique_ptr<RmManager> rm_manager_;
+std::unique_ptr<IxManager> ix_manager_;
+std::unique_ptr<SmManager> sm_manager_;
+std::unique_ptr<QlManager> ql_manager_;
+std::unique_ptr<InterpForTest> interp_;
+
+void init_managers() {
+    disk_manager_ = std::make_unique<DiskManager>();
+    buffer_pool_manager_ = std::make_unique<BufferPoolManagerInstance>(BUFFER_POOL_SIZE, disk_manager_.get());
+    rm_manager_ = std::make_unique<RmManager>(disk_manager_.get(), buffer_pool_manager_.get());
+    ix_manager_ = std::make_unique<IxManager>(disk_manager_.get(), buffer_pool_manager_.get());
+    sm_manager_ =
+        std::make_unique<SmManager>(disk_manager_.get(), buffer_pool_manager_.get(), rm_manager_.get(), ix_manager_.get());
+    ql_manager_ = std::make_unique<QlManager>(sm_manager_.get());
+    interp_ = std::make_unique<InterpForTest>(sm_manager_.get(), ql_manager_.get());
+}
 
 char *result = new char[BUFFER_LENGTH];
 int offset;
@@ -36,6 +45,7 @@ char *exec_sql(const std::string &sql) {
 };
 
 int main(int argc, char *argv[]) {
+    init_managers();
     if (argc == 2) {
         if (!sm_manager_->is_dir(db_name_)) {
             sm_manager_->create_db(db_name_);
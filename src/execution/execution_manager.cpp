@@ -61,7 +61,7 @@ std::vector<Condition> QlManager::check_where_clause(const std::vector<std::stri
         }
         TabMeta &lhs_tab = sm_manager_->db_.get_table(cond.lhs_col.tab_name);
         auto lhs_col = lhs_tab.get_col(cond.lhs_col.col_name);
-        ColType lhs_type = lhs_col->type;
+        ColType lhs_type = value_type(lhs_col->type);
         ColType rhs_type;
         if (cond.is_rhs_val) {
             cond.rhs_val.init_raw(lhs_col->len);
@@ -69,7 +69,7 @@ std::vector<Condition> QlManager::check_where_clause(const std::vector<std::stri
         } else {
             TabMeta &rhs_tab = sm_manager_->db_.get_table(cond.rhs_col.tab_name);
             auto rhs_col = rhs_tab.get_col(cond.rhs_col.col_name);
-            rhs_type = rhs_col->type;
+            rhs_type = value_type(rhs_col->type);
         }
         if (lhs_type != rhs_type) {
             throw IncompatibleTypeError(coltype2str(lhs_type), coltype2str(rhs_type));
@@ -144,7 +144,7 @@ void QlManager::update_set(const std::string &tab_name, std::vector<SetClause> s
     for (auto &set_clause : set_clauses) {
         if(DEBUG)std::cout<<set_clause.lhs.col_name<<std::endl;
         auto lhs_col = tab.get_col(set_clause.lhs.col_name);
-        if (lhs_col->type != set_clause.rhs.type) {
+        if (value_type(lhs_col->type) != set_clause.rhs.type) {
             throw IncompatibleTypeError(coltype2str(lhs_col->type), coltype2str(set_clause.rhs.type));
         }
         set_clause.rhs.init_raw(lhs_col->len);
@@ -307,7 +307,7 @@ void QlManager::select_from(std::vector<TabCol> sel_cols, const std::vector<std:
                 col_str = std::to_string(*(int *)rec_buf);
             } else if (col.type == TYPE_FLOAT) {
                 col_str = std::to_string(*(float *)rec_buf);
-            } else if (col.type == TYPE_STRING) {
+            } else if (value_type(col.type) == TYPE_STRING) {
                 col_str = std::string((char *)rec_buf, col.len);
                 col_str.resize(strlen(col_str.c_str()));
             }
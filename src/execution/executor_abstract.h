@@ -54,7 +54,7 @@ class AbstractExecutor {
                 val.set_int(*(int *)val_buf);
             } else if (col.type == TYPE_FLOAT) {
                 val.set_float(*(float *)val_buf);
-            } else if (col.type == TYPE_STRING) {
+            } else if (value_type(col.type) == TYPE_STRING) {
                 std::string str_val((char *)val_buf, col.len);
                 str_val.resize(strlen(str_val.c_str()));
                 val.set_str(str_val);
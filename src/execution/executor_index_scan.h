@@ -168,7 +168,7 @@ class IndexScanExecutor : public AbstractExecutor {
             rhs_type = rhs_col->type;
             rhs = rec->data + rhs_col->offset;
         }
-        assert(rhs_type == lhs_col->type);  // TODO convert to common type
+        assert(value_type(rhs_type) == value_type(lhs_col->type));  // TODO convert to common type
         int cmp = ix_compare(lhs, rhs, rhs_type, lhs_col->len);
         if (cond.op == OP_EQ) {
             return cmp == 0;
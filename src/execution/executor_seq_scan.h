@@ -16,7 +16,13 @@ class SeqScanExecutor : public AbstractExecutor {
     std::vector<Condition> fed_conds_;  // 实际扫描条件(可能由于连接运算动态改变)
 
     Rid rid_;                        // 当前扫描到的记录的rid
-    std::unique_ptr<RecScan> scan_;  // table_iterator
+    std::unique_ptr<RmScan> scan_;  // table_iterator
+    std::unique_ptr<BufferAccessStrategy> strategy_;  // 大表扫描使用的ring, 避免挤出缓冲池中的热点页面
+    // 以下两项固定着页面, 必须在strategy_之前释放
+    RmScanBatch batch_;  // 当前页面中所有记录的slot_no, 每个页面只访问一次缓冲池
+    size_t batch_idx_ = 0;  // rid_在batch_中的下标
+    RmRecordView view_;  // rid_处记录的视图, 谓词直接在页面上求值, 只有Next()时复制
+    bool end_ = true;
 
     SmManager *sm_manager_;
 
@@ -54,44 +60,52 @@ class SeqScanExecutor : public AbstractExecutor {
     void beginTuple() override {
         check_runtime_conds();
 
-        scan_ = std::make_unique<RmScan>(fh_);
+        // 先释放上一次扫描的view_, batch_和scan_, 再重建strategy_
+        view_.reset();
+        batch_.reset();
+        scan_.reset();
+        strategy_.reset();
+        if (BufferAccessStrategy::IsLargeScan(sm_manager_->get_bpm(), fh_->get_file_hdr().num_pages)) {
+            strategy_ = std::make_unique<BufferAccessStrategy>(sm_manager_->get_bpm());
+        }
+        scan_ = std::make_unique<RmScan>(fh_, strategy_.get());
 
         // 得到第一个满足fed_conds_条件的record,并把其rid赋给算子成员rid_
-        while (!scan_->is_end()) {
-            rid_ = scan_->rid();
-            try {
-                auto rec = fh_->get_record(rid_, context_);  // TableHeap->GetTuple() 当前扫描到的记录
-                // lab3 task2 todo
-                // 利用eval_conds判断是否当前记录(rec.get())满足谓词条件
-                // 满足则中止循环
-                // lab3 task2 todo end
-                if(eval_conds(cols_, fed_conds_, rec.get())) 
-                    break;
-            } catch (RecordNotFoundError &e) {
-                std::cerr << e.what() << std::endl;
-            }
-
-            scan_->next();  // 找下一个有record的位置
-        }
+        batch_idx_ = 0;
+        end_ = false;
+        find_next_tuple();
     }
 
     void nextTuple() override {
         check_runtime_conds();
         assert(!is_end());
-        for (scan_->next(); !scan_->is_end(); scan_->next()) {  // 用TableIterator遍历TableHeap中的所有Tuple
-            // lab3 task2 todo
-            // 获取当前记录(参考beginTuple())赋给算子成员rid_
-            // 利用eval_conds判断是否当前记录(rec.get())满足谓词条件
-            // 满足则中止循环
-            // lab3 task2 todo End
-            rid_ = scan_->rid();
-            auto rec = fh_->get_record(rid_, context_);
-            if(eval_conds(cols_, fed_conds_, rec.get())) 
-                break;
+        batch_idx_++;
+        find_next_tuple();
+    }
+
+    /**
+     * @brief 从batch_idx_开始找第一个满足fed_conds_条件的记录, 当前页面找完后取下一个页面的批次
+     * @note 扫描结束时batch_和view_均已释放, 不再固定任何页面
+     */
+    void find_next_tuple() {
+        while (true) {
+            for (; batch_idx_ < batch_.size(); batch_idx_++) {
+                rid_ = batch_.rid(batch_idx_);
+                view_ = batch_.get_record_view(batch_idx_);  // TableHeap->GetTuple() 当前扫描到的记录
+                if (eval_conds(cols_, fed_conds_, view_.data())) {
+                    return;
+                }
+            }
+            view_.reset();
+            batch_idx_ = 0;
+            if (!scan_->next_batch(&batch_)) {
+                end_ = true;
+                return;
+            }
         }
     }
 
-    bool is_end() const override { return scan_->is_end(); }
+    bool is_end() const override { return end_; }
 
     size_t tupleLen() const override { return len_; }
 
@@ -102,7 +116,7 @@ class SeqScanExecutor : public AbstractExecutor {
         // 利用fh_得到记录record
         // lab3 task2 todo end
         assert(!is_end());
-        return fh_->get_record(rid_, context_);
+        return view_.to_record();
     }
 
     void feed(const std::map<TabCol, Value> &feed_dict) override {
@@ -132,10 +146,10 @@ class SeqScanExecutor : public AbstractExecutor {
         }
     }
 
-    bool eval_cond(const std::vector<ColMeta> &rec_cols, const Condition &cond, const RmRecord *rec) {
+    bool eval_cond(const std::vector<ColMeta> &rec_cols, const Condition &cond, const char *rec_data) {
         auto lhs_col = get_col(rec_cols, cond.lhs_col);
-        char *lhs = rec->data + lhs_col->offset;
-        char *rhs;
+        const char *lhs = rec_data + lhs_col->offset;
+        const char *rhs;
         ColType rhs_type;
         if (cond.is_rhs_val) {
             rhs_type = cond.rhs_val.type;
@@ -144,9 +158,9 @@ class SeqScanExecutor : public AbstractExecutor {
             // rhs is a column
             auto rhs_col = get_col(rec_cols, cond.rhs_col);
             rhs_type = rhs_col->type;
-            rhs = rec->data + rhs_col->offset;
+            rhs = rec_data + rhs_col->offset;
         }
-        assert(rhs_type == lhs_col->type);  // TODO convert to common type
+        assert(value_type(rhs_type) == value_type(lhs_col->type));  // TODO convert to common type
         int cmp = ix_compare(lhs, rhs, rhs_type, lhs_col->len);
         if (cond.op == OP_EQ) {
             return cmp == 0;
@@ -165,8 +179,8 @@ class SeqScanExecutor : public AbstractExecutor {
         }
     }
 
-    bool eval_conds(const std::vector<ColMeta> &rec_cols, const std::vector<Condition> &conds, const RmRecord *rec) {
+    bool eval_conds(const std::vector<ColMeta> &rec_cols, const std::vector<Condition> &conds, const char *rec_data) {
         return std::all_of(conds.begin(), conds.end(),
-                           [&](const Condition &cond) { return eval_cond(rec_cols, cond, rec); });
+                           [&](const Condition &cond) { return eval_cond(rec_cols, cond, rec_data); });
     }
 };
\ No newline at end of file
@@ -21,6 +21,9 @@ const char *help_info =
     "  DELETE FROM table_name [WHERE where_clause]\n"
     "  UPDATE table_name SET column_name = value [, column_name = value ...] [WHERE where_clause]\n"
     "  SELECT selector FROM table_name [WHERE where_clause]\n"
+    "  SET buffer_pool_size = n\n"
+    "  SET table_name.buffer_pool_quota = n\n"
+    "  SHOW {buffer_pool_size | buffer_pool}\n"
     "type:\n"
     "  {INT | FLOAT | CHAR(n)}\n"
     "where_clause:\n"
@@ -51,6 +54,14 @@ class InterpForTest {
             // show tables;
             sm_manager_->show_tables(context);
 
+        } else if (auto x = std::dynamic_pointer_cast<ast::SetOption>(root)) {
+            // set option = value;
+            sm_manager_->set_option(x->tab_name, x->name, x->value, context);
+
+        } else if (auto x = std::dynamic_pointer_cast<ast::ShowOption>(root)) {
+            // show option;
+            sm_manager_->show_option(x->name, context);
+
         } else if (auto x = std::dynamic_pointer_cast<ast::DescTable>(root)) {
             // desc table;
 
@@ -137,7 +148,8 @@ class InterpForTest {
    private:
     ColType interp_sv_type(ast::SvType sv_type) {
         std::map<ast::SvType, ColType> m = {
-            {ast::SV_TYPE_INT, TYPE_INT}, {ast::SV_TYPE_FLOAT, TYPE_FLOAT}, {ast::SV_TYPE_STRING, TYPE_STRING}};
+            {ast::SV_TYPE_INT, TYPE_INT}, {ast::SV_TYPE_FLOAT, TYPE_FLOAT}, {ast::SV_TYPE_STRING, TYPE_STRING},
+            {ast::SV_TYPE_VARCHAR, TYPE_VARCHAR}};
         return m.at(sv_type);
     }
 
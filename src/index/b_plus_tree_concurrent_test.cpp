@@ -22,6 +22,8 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>  // NOLINT
 #include <cstdio>
 #include <functional>
@@ -34,7 +36,7 @@
 #include "ix.h"
 #undef private  // for use private variables in "ix.h"
 
-#include "storage/buffer_pool_manager.h"
+#include "storage/buffer_pool_manager_instance.h"
 
 const std::string TEST_DB_NAME = "BPlusTreeConcurrentTest_db";  // 以数据库名作为根目录
 const std::string TEST_FILE_NAME = "table1";                    // 测试文件名的前缀
@@ -60,7 +62,7 @@ class BPlusTreeConcurrentTest : public ::testing::Test {
         ::testing::Test::SetUp();
         // For each test, we create a new IxManager
         disk_manager_ = std::make_unique<DiskManager>();
-        buffer_pool_manager_ = std::make_unique<BufferPoolManager>(100, disk_manager_.get());
+        buffer_pool_manager_ = std::make_unique<BufferPoolManagerInstance>(100, disk_manager_.get());
         ix_manager_ = std::make_unique<IxManager>(disk_manager_.get(), buffer_pool_manager_.get());
         txn_ = std::make_unique<Transaction>(0);
 
@@ -361,3 +363,62 @@ TEST_F(BPlusTreeConcurrentTest, MixScaleTest) {
     }
     EXPECT_EQ(size, keys.size() - delete_keys.size());
 }
+
+/**
+ * @brief 并发插入的同时并发查找已插入的key, 查找走乐观版本校验路径, 不应因为结点分裂而漏掉key
+ */
+TEST_F(BPlusTreeConcurrentTest, OptimisticLookupTest) {
+    const int64_t scale = 4000;
+    const int reader_num = 4;
+    const int order = 128;
+
+    assert(order > 2 && order <= ih_->file_hdr_.btree_order);
+    ih_->file_hdr_.btree_order = order;
+
+    // 偶数key预先插入, 奇数key在查找的同时插入
+    std::vector<int64_t> even_keys;
+    std::vector<int64_t> odd_keys;
+    for (int64_t key = 1; key <= scale; key++) {
+        (key % 2 == 0 ? even_keys : odd_keys).push_back(key);
+    }
+    InsertHelper(ih_.get(), even_keys);
+    std::shuffle(odd_keys.begin(), odd_keys.end(), std::default_random_engine{});
+
+    std::atomic<bool> done{false};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < reader_num; i++) {
+        readers.emplace_back([&, i] {
+            Transaction transaction(0);
+            std::vector<Rid> rids;
+            size_t pos = i;
+            while (!done) {
+                int64_t key = even_keys[pos++ % even_keys.size()];
+                rids.clear();
+                EXPECT_EQ(true, ih_->GetValue((const char *)&key, &rids, &transaction));
+                ASSERT_EQ(rids.size(), 1);
+                EXPECT_EQ(rids[0].slot_no, key);
+            }
+        });
+    }
+    std::thread writer([&] {
+        Transaction transaction(0);
+        for (auto key : odd_keys) {
+            Rid rid = {.page_no = 0, .slot_no = static_cast<int32_t>(key)};
+            ih_->insert_entry((const char *)&key, rid, &transaction);
+        }
+        done = true;
+    });
+    writer.join();
+    for (auto &reader : readers) {
+        reader.join();
+    }
+
+    int64_t current_key = 1;
+    IxScan scan(ih_.get(), ih_->leaf_begin(), ih_->leaf_end(), buffer_pool_manager_.get());
+    while (!scan.is_end()) {
+        EXPECT_EQ(scan.rid().slot_no, current_key);
+        current_key++;
+        scan.next();
+    }
+    EXPECT_EQ(current_key, scale + 1);
+}
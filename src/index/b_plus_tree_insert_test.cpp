@@ -32,7 +32,7 @@
 #include "ix.h"
 #undef private  // for use private variables in "ix.h"
 
-#include "storage/buffer_pool_manager.h"
+#include "storage/buffer_pool_manager_instance.h"
 
 const std::string TEST_DB_NAME = "BPlusTreeInsertTest_db";  // 以数据库名作为根目录
 const std::string TEST_FILE_NAME = "table1";                // 测试文件名的前缀
@@ -58,7 +58,7 @@ class BPlusTreeTests : public ::testing::Test {
         ::testing::Test::SetUp();
         // For each test, we create a new IxManager
         disk_manager_ = std::make_unique<DiskManager>();
-        buffer_pool_manager_ = std::make_unique<BufferPoolManager>(100, disk_manager_.get());
+        buffer_pool_manager_ = std::make_unique<BufferPoolManagerInstance>(100, disk_manager_.get());
         ix_manager_ = std::make_unique<IxManager>(disk_manager_.get(), buffer_pool_manager_.get());
         txn_ = std::make_unique<Transaction>(0);
 
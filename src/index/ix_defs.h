@@ -5,7 +5,7 @@
 
 struct IxFileHdr {
     page_id_t first_free_page_no;
-    int num_pages;        // disk pages
+    page_id_t num_pages;  // disk pages
     page_id_t root_page;  // root page no
     ColType col_type;
     int col_len;      // ColMeta->len
@@ -6,8 +6,7 @@ IxIndexHandle::IxIndexHandle(DiskManager *disk_manager, BufferPoolManager *buffe
     : disk_manager_(disk_manager), buffer_pool_manager_(buffer_pool_manager), fd_(fd) {
     // init file_hdr_
     disk_manager_->read_page(fd, IX_FILE_HDR_PAGE, (char *)&file_hdr_, sizeof(file_hdr_));
-    // disk_manager管理的fd对应的文件中，设置从原来编号+1开始分配page_no
-    disk_manager_->set_fd2pageno(fd, disk_manager_->get_fd2pageno(fd) + 1);
+    // DiskManager::open_file已按文件大小设置fd2pageno, 新页面从文件末尾开始分配
 }
 
 
@@ -59,18 +58,14 @@ std::pair<IxNodeHandle*, bool> IxIndexHandle::FindLeafPage(const char *key, Oper
     if(operation == Operation::INSERT || operation == Operation::DELETE)
         is_root_latch = true;
     // not unpin leaf here
-    page_id_t root_page_no = file_hdr_.root_page;
+    page_id_t root_page_no = GetRootPageNo();
     IxNodeHandle* root = FetchNode(root_page_no);
     IxNodeHandle* cur = root;
     if(operation == Operation::FIND) cur->page->RLatch();
-    else { 
-        /*
-        if(Issafe(cur, operation)) {
-            root_latch_.unlock();
-            is_root_latch = false;
-        }
+    else {
+        // 根结点也需要加写锁, 使其版本号随修改而变化, 乐观查找才能发现根结点的分裂与合并
         cur->page->WLatch();
-        transaction->AddIntoPageSet(cur->page); */
+        transaction->AddIntoPageSet(cur->page);
     }
     while(!cur->IsLeafPage()) {
         IxNodeHandle* tmp = cur;
@@ -116,6 +111,16 @@ bool IxIndexHandle::GetValue(const char *key, std::vector<Rid> *result, Transact
     // 2. 在叶子节点中查找目标key值的位置，并读取key对应的rid
     // 3. 把rid存入result参数中
     // 提示：使用完buffer_pool提供的page之后，记得unpin page；记得处理并发的上锁
+    if (ENABLE_OPTIMISTIC_LATCH) {
+        for (int i = 0; i < OPTIMISTIC_LATCH_RETRIES; i++) {
+            Rid rid;
+            bool found;
+            if (OptimisticLookup(key, &rid, &found)) {
+                if (found) result->push_back(rid);
+                return found;
+            }
+        }
+    }
     std::pair<IxNodeHandle*, bool> tmp = FindLeafPage(key, Operation::FIND, transaction);
     IxNodeHandle* x = tmp.first;
     Rid* rid = nullptr;
@@ -130,6 +135,63 @@ bool IxIndexHandle::GetValue(const char *key, std::vector<Rid> *result, Transact
     return true;
 }
 
+/**
+ * @brief 乐观地查找key: 自根结点向下读取结点时不加读锁, 读完每个结点后校验其版本号
+ *
+ * @param key 查找的目标key值
+ * @param[out] rid key存在时对应的rid
+ * @param[out] found key是否存在
+ * @return 查找是否成功完成; 返回false表示路径上的结点被并发修改, 需要重试或改用加读锁的查找
+ * @note 校验之前读到的页面内容可能不一致, 因此使用num_key和孩子页号之前先检查其范围
+ * @note 查找过程不写任何共享内存(页面固定除外), 热点的根结点和内部结点不会在读者之间来回传递cache line
+ */
+bool IxIndexHandle::OptimisticLookup(const char *key, Rid *rid, bool *found) {
+    // 结构修改期间兄弟结点等不加写锁, 此时直接放弃乐观查找
+    uint64_t smo_version = smo_version_.load();
+    if (smo_in_progress_.load() > 0) return false;
+    page_id_t page_no = GetRootPageNo();
+    if (page_no < 0) return false;
+    Page *page = buffer_pool_manager_->FetchPage(PageId{fd_, page_no});
+    if (page == nullptr) return false;
+    uint64_t version;
+    // 取得版本号之后根结点未变, 说明这是当前的根结点; 之后根结点的分裂或合并会修改其版本号
+    if (!page->TryOptimisticLatch(&version) || page_no != GetRootPageNo()) {
+        buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+        return false;
+    }
+    while (true) {
+        IxNodeHandle node(&file_hdr_, page);
+        int size = node.GetSize();
+        bool valid = size >= 0 && size <= node.GetMaxSize();
+        if (valid && node.IsLeafPage()) {
+            Rid *value = nullptr;
+            *found = node.LeafLookup(key, &value);
+            if (*found) *rid = *value;
+            valid = page->ValidateOptimisticLatch(version) && smo_version_.load() == smo_version;
+            buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+            return valid;
+        }
+        page_id_t child_no = valid && size > 0 ? node.InternalLookup(key) : INVALID_PAGE_ID;
+        // child_no必须来自一致的父结点
+        if (!page->ValidateOptimisticLatch(version) || child_no < 0 || child_no >= disk_manager_->get_fd2pageno(fd_)) {
+            buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+            return false;
+        }
+        Page *child = buffer_pool_manager_->FetchPage(PageId{fd_, child_no});
+        uint64_t child_version = 0;
+        bool ok = child != nullptr && child->TryOptimisticLatch(&child_version);
+        // 取得孩子的版本号时父结点仍未被修改, 说明孩子结点此时仍在查找路径上
+        ok = ok && page->ValidateOptimisticLatch(version);
+        buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+        if (!ok) {
+            if (child != nullptr) buffer_pool_manager_->UnpinPage(child->GetPageId(), false);
+            return false;
+        }
+        page = child;
+        version = child_version;
+    }
+}
+
 /**
  * @brief 将指定键值对插入到B+树中
  *
@@ -138,6 +200,7 @@ bool IxIndexHandle::GetValue(const char *key, std::vector<Rid> *result, Transact
  * @return 是否插入成功
  */
 bool IxIndexHandle::insert_entry(const char *key, const Rid &value, Transaction *transaction) {
+    if (disk_manager_->is_read_only(fd_)) throw FileReadOnlyError(disk_manager_->GetFileName(fd_));
     // Todo:
     // 1. 查找key值应该插入到哪个叶子节点
     // 2. 在该叶子节点中插入键值对
@@ -154,10 +217,12 @@ bool IxIndexHandle::insert_entry(const char *key, const Rid &value, Transaction
         return false;
     }
     if(x->GetSize() == x->GetMaxSize()) {
+        BeginStructureModification();
         IxNodeHandle* new_node = Split(x);
         if(x->GetPageNo() == file_hdr_.last_leaf) file_hdr_.last_leaf = new_node->GetPageNo();
         // move first_key in new_node to its parent
         InsertIntoParent(x, new_node->get_key(0), new_node, transaction);
+        EndStructureModification();
         //buffer_pool_manager_->UnpinPage(new_node->GetPageId(), true);
     }
     if(tmp.second) root_latch_.unlock();
@@ -237,7 +302,7 @@ void IxIndexHandle::InsertIntoParent(IxNodeHandle *old_node, const char *key, Ix
         new_root_node->insert_pair(0, old_node->get_key(0), lson);
         new_root_node->insert_pair(1, key, rson);
         int new_root = new_root_node->GetPageNo();
-        file_hdr_.root_page = new_root;
+        UpdateRootPageNo(new_root);
         new_node->page_hdr->parent = new_root;
         old_node->page_hdr->parent = new_root;
         //buffer_pool_manager_->UnpinPage(new_node->GetPageId(), true);
@@ -261,6 +326,7 @@ void IxIndexHandle::InsertIntoParent(IxNodeHandle *old_node, const char *key, Ix
  * @return 是否删除成功
  */
 bool IxIndexHandle::delete_entry(const char *key, Transaction *transaction) {
+    if (disk_manager_->is_read_only(fd_)) throw FileReadOnlyError(disk_manager_->GetFileName(fd_));
     // Todo:
     // 1. 获取该键值对所在的叶子结点
     // 2. 在该叶子结点中删除键值对
@@ -276,7 +342,10 @@ bool IxIndexHandle::delete_entry(const char *key, Transaction *transaction) {
         UnLatchParentPage(transaction);
         return false;
     }
+    // 合并, 重分配以及maintain_parent都会修改路径之外或未加写锁的结点
+    BeginStructureModification();
     CoalesceOrRedistribute(x);
+    EndStructureModification();
     if(tmp.second) root_latch_.unlock();
     UnLatchParentPage(transaction);
     //buffer_pool_manager_->UnpinPage(x->GetPageId(), true);
@@ -344,14 +413,14 @@ bool IxIndexHandle::AdjustRoot(IxNodeHandle *old_root_node) {
     if(old_root_node->IsLeafPage()) {
         if(!old_root_node->page_hdr->num_key) {
             release_node_handle(*old_root_node);
-            file_hdr_.root_page = INVALID_PAGE_ID;
+            UpdateRootPageNo(INVALID_PAGE_ID);
             return true;
         }
     }
     else if(old_root_node->page_hdr->num_key == 1) {
         IxNodeHandle* new_root = FetchNode(old_root_node->ValueAt(0));
         release_node_handle(*old_root_node);
-        file_hdr_.root_page = new_root->GetPageNo();
+        UpdateRootPageNo(new_root->GetPageNo());
         new_root->SetParentPageNo(INVALID_PAGE_ID);
         //buffer_pool_manager_->UnpinPage(new_root->GetPageId(), true);
         return true;
@@ -456,10 +525,16 @@ IxNodeHandle *IxIndexHandle::FetchNode(int page_no) const {
  */
 IxNodeHandle *IxIndexHandle::CreateNode() {
     file_hdr_.num_pages++;
+    if (file_hdr_.first_free_page_no != IX_NO_PAGE) {
+        // 优先复用被删除的结点, 删除后结点仍被固定在缓冲池中, 因此在文件内部的空闲链表中复用, 文件不再增长
+        IxNodeHandle *node = FetchNode(file_hdr_.first_free_page_no);
+        file_hdr_.first_free_page_no = node->page_hdr->next_free_page_no;
+        node->page_hdr->next_free_page_no = IX_NO_PAGE;
+        return node;
+    }
     PageId new_page_id = {.fd = fd_, .page_no = INVALID_PAGE_ID};
     // 从3开始分配page_no，第一次分配之后，new_page_id.page_no=3，file_hdr_.num_pages=4
     Page *page = buffer_pool_manager_->NewPage(&new_page_id);
-    // 注意，和Record的free_page定义不同，此处【不能】加上：file_hdr_.first_free_page_no = page->GetPageId().page_no
     IxNodeHandle *node = new IxNodeHandle(&file_hdr_, page);
     return node;
 }
@@ -507,11 +582,15 @@ void IxIndexHandle::erase_leaf(IxNodeHandle *leaf) {
 }
 
 /**
- * @brief 删除node时，更新file_hdr_.num_pages
+ * @brief 删除node时，更新file_hdr_.num_pages，并将node放入空闲链表的头部，之后由CreateNode复用
  *
  * @param node
  */
-void IxIndexHandle::release_node_handle(IxNodeHandle &node) { file_hdr_.num_pages--; }
+void IxIndexHandle::release_node_handle(IxNodeHandle &node) {
+    file_hdr_.num_pages--;
+    node.page_hdr->next_free_page_no = file_hdr_.first_free_page_no;
+    file_hdr_.first_free_page_no = node.GetPageNo();
+}
 
 /**
  * @brief 将node的第child_idx个孩子结点的父节点置为node
@@ -563,6 +642,7 @@ Iid IxIndexHandle::lower_bound(const char *key) {
     Iid iid = {.page_no = node->GetPageNo(), .slot_no = key_idx};
 
     // unpin leaf node
+    node->page->RUnlatch();
     buffer_pool_manager_->UnpinPage(node->GetPageId(), false);
     return iid;
 }
@@ -589,6 +669,7 @@ Iid IxIndexHandle::upper_bound(const char *key) {
     }
 
     // unpin leaf node
+    node->page->RUnlatch();
     buffer_pool_manager_->UnpinPage(node->GetPageId(), false);
     return iid;
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+
 #include "ix_defs.h"
 #include "ix_node_handle.h"
 #include "transaction/transaction.h"
@@ -19,15 +21,23 @@ class IxIndexHandle {
     int fd_;
     IxFileHdr file_hdr_;  // 存了root_page，但root_page初始化为2（第0页存FILE_HDR_PAGE，第1页存LEAF_HEADER_PAGE）
     std::mutex root_latch_;  // 用于索引并发（请自行选择并发粒度在 Tree级 或 Page级 ）
+    /**
+     * 结构修改(分裂, 合并, 重分配, 更换根结点)期间修改的兄弟, 父亲, 孩子结点和重用的空闲结点不加写锁,
+     * 版本号不变, 因此乐观查找改为校验下面两个计数: 开始时没有进行中的结构修改, 结束时结构版本号未变
+     */
+    std::atomic<int> smo_in_progress_{0};
+    std::atomic<uint64_t> smo_version_{0};
 
    public:
     IxIndexHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd);
 
+    int GetFd() const { return fd_; }
+
     // for search
     bool GetValue(const char *key, std::vector<Rid> *result, Transaction *transaction);
 
     std::pair<IxNodeHandle*, bool> FindLeafPage(const char *key, Operation operation, Transaction *transaction);
-    std::pair<IxNodeHandle*, bool> check_optimism(const char *key, IxNodeHandle* root, Operation operation);
+    bool OptimisticLookup(const char *key, Rid *rid, bool *found);
     // for insert
     bool insert_entry(const char *key, const Rid &value, Transaction *transaction);
 
@@ -58,9 +68,22 @@ class IxIndexHandle {
 
    private:
     // 辅助函数
-    void UpdateRootPageNo(page_id_t root) { file_hdr_.root_page = root; }
+    // 乐观查找不加锁读取根结点页号, 因此根结点页号的读写都是原子的
+    void UpdateRootPageNo(page_id_t root) { __atomic_store_n(&file_hdr_.root_page, root, __ATOMIC_RELEASE); }
+
+    page_id_t GetRootPageNo() const { return __atomic_load_n(&file_hdr_.root_page, __ATOMIC_ACQUIRE); }
+
+    void BeginStructureModification() {
+        smo_in_progress_.fetch_add(1);
+        smo_version_.fetch_add(1);
+    }
+
+    void EndStructureModification() {
+        smo_version_.fetch_add(1);
+        smo_in_progress_.fetch_sub(1);
+    }
 
-    bool IsEmpty() const { return file_hdr_.root_page == IX_NO_PAGE; }
+    bool IsEmpty() const { return GetRootPageNo() == IX_NO_PAGE; }
 
     // for get/create node
     IxNodeHandle *FetchNode(int page_no) const;
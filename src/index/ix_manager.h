@@ -31,6 +31,8 @@ class IxManager {
         disk_manager_->create_file(ix_name);
         // Open index file
         int fd = disk_manager_->open_file(ix_name);
+        // 分配file header, leaf header和root node三个页面
+        disk_manager_->set_fd2pageno(fd, IX_INIT_NUM_PAGES);
         // Create file header and write to file
         // Theoretically we have: |page_hdr| + (|attr| + |rid|) * n <= PAGE_SIZE
         // but we reserve one slot for convenient inserting and deleting, i.e.
@@ -92,8 +94,6 @@ class IxManager {
             disk_manager_->write_page(fd, IX_INIT_ROOT_PAGE, page_buf, PAGE_SIZE);
         }
 
-        disk_manager_->set_fd2pageno(fd, IX_INIT_NUM_PAGES - 1);  // DEBUG
-
         // Close index file
         disk_manager_->close_file(fd);
     }
@@ -104,16 +104,25 @@ class IxManager {
     }
 
     // 注意这里打开文件，创建并返回了index file handle的指针
-    std::unique_ptr<IxIndexHandle> open_index(const std::string &filename, int index_no) {
+    // read_only为true时只读打开, 结点直接从文件的内存映射中访问, 插入删除时抛出FileReadOnlyError
+    // direct_io为true时用O_DIRECT读写结点, 结点只缓存在缓冲池中
+    std::unique_ptr<IxIndexHandle> open_index(const std::string &filename, int index_no, bool read_only = false,
+                                              bool direct_io = false) {
         std::string ix_name = get_index_name(filename, index_no);
-        int fd = disk_manager_->open_file(ix_name);
+        int fd = disk_manager_->open_file(ix_name, read_only, direct_io);
         return std::make_unique<IxIndexHandle>(disk_manager_, buffer_pool_manager_, fd);
     }
 
     void close_index(const IxIndexHandle *ih) {
-        disk_manager_->write_page(ih->fd_, IX_FILE_HDR_PAGE, (const char *)&ih->file_hdr_, sizeof(ih->file_hdr_));
+        if (!disk_manager_->is_read_only(ih->fd_)) {
+            disk_manager_->write_page(ih->fd_, IX_FILE_HDR_PAGE, (const char *)&ih->file_hdr_, sizeof(ih->file_hdr_));
+        }
         // 缓冲区的所有页刷到磁盘，注意这句话必须写在close_file前面
+        buffer_pool_manager_->CancelPrefetch(ih->fd_);
+        buffer_pool_manager_->DropCompressedPages(ih->fd_);
+        buffer_pool_manager_->SetFileQuota(ih->fd_, 0);
         buffer_pool_manager_->FlushAllPages(ih->fd_);
+        buffer_pool_manager_->DiscardPages(ih->fd_);
         disk_manager_->close_file(ih->fd_);
     }
 };
@@ -7,7 +7,7 @@
 namespace ast {
 
 enum SvType {
-    SV_TYPE_INT, SV_TYPE_FLOAT, SV_TYPE_STRING
+    SV_TYPE_INT, SV_TYPE_FLOAT, SV_TYPE_STRING, SV_TYPE_VARCHAR
 };
 
 enum SvCompOp {
@@ -28,6 +28,25 @@ struct ShowTables : public TreeNode {
 struct TxnBegin : public TreeNode {
 };
 
+// SET [table.]option = value; 管理命令, 在线修改运行时配置或表的配置
+struct SetOption : public TreeNode {
+    std::string tab_name;  // 为空表示全局配置
+    std::string name;
+    int value;
+
+    SetOption(std::string name_, int value_) : name(std::move(name_)), value(value_) {}
+
+    SetOption(std::string tab_name_, std::string name_, int value_) :
+            tab_name(std::move(tab_name_)), name(std::move(name_)), value(value_) {}
+};
+
+// SHOW option; 管理命令, 显示运行时配置或状态
+struct ShowOption : public TreeNode {
+    std::string name;
+
+    ShowOption(std::string name_) : name(std::move(name_)) {}
+};
+
 struct TxnCommit : public TreeNode {
 };
 
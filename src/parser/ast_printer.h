@@ -37,6 +37,7 @@ private:
                 {SV_TYPE_INT,    "INT"},
                 {SV_TYPE_FLOAT,  "FLOAT"},
                 {SV_TYPE_STRING, "STRING"},
+                {SV_TYPE_VARCHAR, "VARCHAR"},
         };
         return m.at(type);
     }
@@ -70,6 +71,14 @@ private:
             std::cout << "HELP\n";
         } else if (auto x = std::dynamic_pointer_cast<ShowTables>(node)) {
             std::cout << "SHOW_TABLES\n";
+        } else if (auto x = std::dynamic_pointer_cast<ShowOption>(node)) {
+            std::cout << "SHOW_OPTION\n";
+            print_val(x->name, offset);
+        } else if (auto x = std::dynamic_pointer_cast<SetOption>(node)) {
+            std::cout << "SET_OPTION\n";
+            print_val(x->tab_name, offset);
+            print_val(x->name, offset);
+            print_val(x->value, offset);
         } else if (auto x = std::dynamic_pointer_cast<CreateTable>(node)) {
             std::cout << "CREATE_TABLE\n";
             print_val(x->tab_name, offset);
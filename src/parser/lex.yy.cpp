@@ -616,6 +616,7 @@ char *yytext;
     /* enable location */
 #include "ast.h"
 #include "yacc.tab.h"
+#include <strings.h>
 #include <iostream>
 
 // automatically update location
@@ -1144,6 +1145,7 @@ case 42:
 YY_RULE_SETUP
 #line 95 "lex.l"
 {
+    if (strcasecmp(yytext, "VARCHAR") == 0) return VARCHAR;
     yylval->sv_str = yytext;
     return IDENTIFIER;
 }
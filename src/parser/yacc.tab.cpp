@@ -1,8 +1,8 @@
-/* A Bison parser, made by GNU Bison 3.5.1.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2020 Free Software Foundation,
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
    Inc.
 
    This program is free software: you can redistribute it and/or modify
@@ -16,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -34,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -41,14 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Undocumented macros, especially those whose name start with YY_,
-   are private implementation details.  Do not rely on them.  */
-
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.5.1"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -66,10 +67,11 @@
 
 
 /* First part of user prologue.  */
-#line 1 "/home/long/rucbase/src/parser/yacc.y"
+#line 1 "/root/repo/src/parser/yacc.y"
 
 #include "ast.h"
 #include "yacc.tab.h"
+
 #include <iostream>
 #include <memory>
 
@@ -81,7 +83,7 @@ void yyerror(YYLTYPE *locp, const char* s) {
 
 using namespace ast;
 
-#line 85 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 87 "/root/repo/src/parser/yacc.tab.cpp"
 
 # ifndef YY_CAST
 #  ifdef __cplusplus
@@ -104,95 +106,97 @@ using namespace ast;
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 1
-#endif
-
-/* Use api.header.include to #include this header
-   instead of duplicating it here.  */
-#ifndef YY_YY_HOME_LONG_RUCBASE_SRC_PARSER_YACC_TAB_H_INCLUDED
-# define YY_YY_HOME_LONG_RUCBASE_SRC_PARSER_YACC_TAB_H_INCLUDED
-/* Debug traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-#if YYDEBUG
-extern int yydebug;
-#endif
-
-/* Token type.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-  enum yytokentype
-  {
-    SHOW = 258,
-    TABLES = 259,
-    CREATE = 260,
-    TABLE = 261,
-    DROP = 262,
-    DESC = 263,
-    ASC = 264,
-    LIMIT = 265,
-    INSERT = 266,
-    INTO = 267,
-    VALUES = 268,
-    DELETE = 269,
-    FROM = 270,
-    ORDER = 271,
-    WHERE = 272,
-    UPDATE = 273,
-    SET = 274,
-    SELECT = 275,
-    INT = 276,
-    CHAR = 277,
-    FLOAT = 278,
-    INDEX = 279,
-    AND = 280,
-    JOIN = 281,
-    EXIT = 282,
-    HELP = 283,
-    TXN_BEGIN = 284,
-    TXN_COMMIT = 285,
-    TXN_ABORT = 286,
-    TXN_ROLLBACK = 287,
-    LEQ = 288,
-    NEQ = 289,
-    GEQ = 290,
-    T_EOF = 291,
-    IDENTIFIER = 292,
-    VALUE_STRING = 293,
-    VALUE_INT = 294,
-    VALUE_FLOAT = 295
-  };
-#endif
-
-/* Value type.  */
-
-/* Location type.  */
-#if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
-typedef struct YYLTYPE YYLTYPE;
-struct YYLTYPE
+#include "yacc.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
 {
-  int first_line;
-  int first_column;
-  int last_line;
-  int last_column;
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_SHOW = 3,                       /* SHOW  */
+  YYSYMBOL_TABLES = 4,                     /* TABLES  */
+  YYSYMBOL_CREATE = 5,                     /* CREATE  */
+  YYSYMBOL_TABLE = 6,                      /* TABLE  */
+  YYSYMBOL_DROP = 7,                       /* DROP  */
+  YYSYMBOL_DESC = 8,                       /* DESC  */
+  YYSYMBOL_ASC = 9,                        /* ASC  */
+  YYSYMBOL_LIMIT = 10,                     /* LIMIT  */
+  YYSYMBOL_INSERT = 11,                    /* INSERT  */
+  YYSYMBOL_INTO = 12,                      /* INTO  */
+  YYSYMBOL_VALUES = 13,                    /* VALUES  */
+  YYSYMBOL_DELETE = 14,                    /* DELETE  */
+  YYSYMBOL_FROM = 15,                      /* FROM  */
+  YYSYMBOL_ORDER = 16,                     /* ORDER  */
+  YYSYMBOL_WHERE = 17,                     /* WHERE  */
+  YYSYMBOL_UPDATE = 18,                    /* UPDATE  */
+  YYSYMBOL_SET = 19,                       /* SET  */
+  YYSYMBOL_SELECT = 20,                    /* SELECT  */
+  YYSYMBOL_INT = 21,                       /* INT  */
+  YYSYMBOL_CHAR = 22,                      /* CHAR  */
+  YYSYMBOL_FLOAT = 23,                     /* FLOAT  */
+  YYSYMBOL_VARCHAR = 24,                   /* VARCHAR  */
+  YYSYMBOL_INDEX = 25,                     /* INDEX  */
+  YYSYMBOL_AND = 26,                       /* AND  */
+  YYSYMBOL_JOIN = 27,                      /* JOIN  */
+  YYSYMBOL_EXIT = 28,                      /* EXIT  */
+  YYSYMBOL_HELP = 29,                      /* HELP  */
+  YYSYMBOL_TXN_BEGIN = 30,                 /* TXN_BEGIN  */
+  YYSYMBOL_TXN_COMMIT = 31,                /* TXN_COMMIT  */
+  YYSYMBOL_TXN_ABORT = 32,                 /* TXN_ABORT  */
+  YYSYMBOL_TXN_ROLLBACK = 33,              /* TXN_ROLLBACK  */
+  YYSYMBOL_LEQ = 34,                       /* LEQ  */
+  YYSYMBOL_NEQ = 35,                       /* NEQ  */
+  YYSYMBOL_GEQ = 36,                       /* GEQ  */
+  YYSYMBOL_T_EOF = 37,                     /* T_EOF  */
+  YYSYMBOL_IDENTIFIER = 38,                /* IDENTIFIER  */
+  YYSYMBOL_VALUE_STRING = 39,              /* VALUE_STRING  */
+  YYSYMBOL_VALUE_INT = 40,                 /* VALUE_INT  */
+  YYSYMBOL_VALUE_FLOAT = 41,               /* VALUE_FLOAT  */
+  YYSYMBOL_42_ = 42,                       /* ';'  */
+  YYSYMBOL_43_ = 43,                       /* '='  */
+  YYSYMBOL_44_ = 44,                       /* '.'  */
+  YYSYMBOL_45_ = 45,                       /* '('  */
+  YYSYMBOL_46_ = 46,                       /* ')'  */
+  YYSYMBOL_47_ = 47,                       /* ','  */
+  YYSYMBOL_48_ = 48,                       /* '<'  */
+  YYSYMBOL_49_ = 49,                       /* '>'  */
+  YYSYMBOL_50_ = 50,                       /* '*'  */
+  YYSYMBOL_YYACCEPT = 51,                  /* $accept  */
+  YYSYMBOL_start = 52,                     /* start  */
+  YYSYMBOL_stmt = 53,                      /* stmt  */
+  YYSYMBOL_txnStmt = 54,                   /* txnStmt  */
+  YYSYMBOL_dbStmt = 55,                    /* dbStmt  */
+  YYSYMBOL_ddl = 56,                       /* ddl  */
+  YYSYMBOL_dml = 57,                       /* dml  */
+  YYSYMBOL_OrderName = 58,                 /* OrderName  */
+  YYSYMBOL_optLimitClause = 59,            /* optLimitClause  */
+  YYSYMBOL_preOrderClause = 60,            /* preOrderClause  */
+  YYSYMBOL_optOrderClause = 61,            /* optOrderClause  */
+  YYSYMBOL_OrderClause = 62,               /* OrderClause  */
+  YYSYMBOL_fieldList = 63,                 /* fieldList  */
+  YYSYMBOL_field = 64,                     /* field  */
+  YYSYMBOL_type = 65,                      /* type  */
+  YYSYMBOL_valueList = 66,                 /* valueList  */
+  YYSYMBOL_value = 67,                     /* value  */
+  YYSYMBOL_condition = 68,                 /* condition  */
+  YYSYMBOL_optWhereClause = 69,            /* optWhereClause  */
+  YYSYMBOL_whereClause = 70,               /* whereClause  */
+  YYSYMBOL_col = 71,                       /* col  */
+  YYSYMBOL_colList = 72,                   /* colList  */
+  YYSYMBOL_op = 73,                        /* op  */
+  YYSYMBOL_expr = 74,                      /* expr  */
+  YYSYMBOL_setClauses = 75,                /* setClauses  */
+  YYSYMBOL_setClause = 76,                 /* setClause  */
+  YYSYMBOL_selector = 77,                  /* selector  */
+  YYSYMBOL_tableList = 78,                 /* tableList  */
+  YYSYMBOL_tbName = 79,                    /* tbName  */
+  YYSYMBOL_colName = 80                    /* colName  */
 };
-# define YYLTYPE_IS_DECLARED 1
-# define YYLTYPE_IS_TRIVIAL 1
-#endif
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
 
 
-int yyparse (void);
-
-#endif /* !YY_YY_HOME_LONG_RUCBASE_SRC_PARSER_YACC_TAB_H_INCLUDED  */
-
-
 
 #ifdef short
 # undef short
@@ -231,6 +235,18 @@ typedef int_least16_t yytype_int16;
 typedef short yytype_int16;
 #endif
 
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
 #if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
 typedef __UINT_LEAST8_TYPE__ yytype_uint8;
 #elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
@@ -290,6 +306,7 @@ typedef int yytype_uint16;
 
 #define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
 
+
 /* Stored state numbers (used for stacks). */
 typedef yytype_uint8 yy_state_t;
 
@@ -308,6 +325,7 @@ typedef int yy_state_fast_t;
 # endif
 #endif
 
+
 #ifndef YY_ATTRIBUTE_PURE
 # if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
 #  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
@@ -326,17 +344,23 @@ typedef int yy_state_fast_t;
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && ! defined __ICC && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                            \
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
     _Pragma ("GCC diagnostic push")                                     \
     _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
 # define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
@@ -365,7 +389,7 @@ typedef int yy_state_fast_t;
 
 #define YY_ASSERT(E) ((void) (0 && (E)))
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#if 1
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -430,8 +454,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* 1 */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -497,27 +520,29 @@ union yyalloc
 #endif /* !YYCOPY_NEEDED */
 
 /* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  39
+#define YYFINAL  43
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   109
+#define YYLAST   123
 
 /* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS  50
+#define YYNTOKENS  51
 /* YYNNTS -- Number of nonterminals.  */
 #define YYNNTS  30
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  71
+#define YYNRULES  75
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  129
+#define YYNSTATES  143
 
-#define YYUNDEFTOK  2
-#define YYMAXUTOK   295
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   296
 
 
 /* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
    as returned by yylex, with out-of-bounds checking.  */
-#define YYTRANSLATE(YYX)                                                \
-  (0 <= (YYX) && (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
    as returned by yylex.  */
@@ -527,9 +552,9 @@ static const yytype_int8 yytranslate[] =
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-      42,    43,    49,     2,    44,     2,    45,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,    41,
-      47,    46,    48,     2,     2,     2,     2,     2,     2,     2,
+      45,    46,    50,     2,    47,     2,    44,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,    42,
+      48,    43,    49,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -552,209 +577,221 @@ static const yytype_int8 yytranslate[] =
        5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
       15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
       25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
-      35,    36,    37,    38,    39,    40
+      35,    36,    37,    38,    39,    40,    41
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_int16 yyrline[] =
 {
-       0,    58,    58,    63,    68,    73,    81,    82,    83,    84,
-      88,    92,    96,   100,   107,   114,   118,   122,   126,   130,
-     137,   141,   145,   149,   157,   160,   164,   171,   174,   181,
-     189,   192,   199,   203,   210,   214,   221,   228,   232,   236,
-     243,   247,   254,   258,   262,   269,   276,   277,   284,   288,
-     295,   299,   306,   310,   317,   321,   325,   329,   333,   337,
-     344,   348,   355,   359,   366,   373,   377,   381,   385,   389,
-     395,   397
+       0,    59,    59,    64,    69,    74,    82,    83,    84,    85,
+      89,    93,    97,   101,   108,   112,   116,   120,   127,   131,
+     135,   139,   143,   150,   154,   158,   162,   170,   173,   177,
+     184,   187,   194,   202,   205,   212,   216,   223,   227,   234,
+     241,   245,   249,   253,   260,   264,   271,   275,   279,   286,
+     293,   294,   301,   305,   312,   316,   323,   327,   334,   338,
+     342,   346,   350,   354,   361,   365,   372,   376,   383,   390,
+     394,   398,   402,   406,   412,   414
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 1
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "SHOW", "TABLES", "CREATE", "TABLE",
-  "DROP", "DESC", "ASC", "LIMIT", "INSERT", "INTO", "VALUES", "DELETE",
-  "FROM", "ORDER", "WHERE", "UPDATE", "SET", "SELECT", "INT", "CHAR",
-  "FLOAT", "INDEX", "AND", "JOIN", "EXIT", "HELP", "TXN_BEGIN",
-  "TXN_COMMIT", "TXN_ABORT", "TXN_ROLLBACK", "LEQ", "NEQ", "GEQ", "T_EOF",
-  "IDENTIFIER", "VALUE_STRING", "VALUE_INT", "VALUE_FLOAT", "';'", "'('",
-  "')'", "','", "'.'", "'='", "'<'", "'>'", "'*'", "$accept", "start",
-  "stmt", "txnStmt", "dbStmt", "ddl", "dml", "OrderName", "optLimitClause",
-  "preOrderClause", "optOrderClause", "OrderClause", "fieldList", "field",
-  "type", "valueList", "value", "condition", "optWhereClause",
-  "whereClause", "col", "colList", "op", "expr", "setClauses", "setClause",
-  "selector", "tableList", "tbName", "colName", YY_NULLPTR
+  "\"end of file\"", "error", "\"invalid token\"", "SHOW", "TABLES",
+  "CREATE", "TABLE", "DROP", "DESC", "ASC", "LIMIT", "INSERT", "INTO",
+  "VALUES", "DELETE", "FROM", "ORDER", "WHERE", "UPDATE", "SET", "SELECT",
+  "INT", "CHAR", "FLOAT", "VARCHAR", "INDEX", "AND", "JOIN", "EXIT",
+  "HELP", "TXN_BEGIN", "TXN_COMMIT", "TXN_ABORT", "TXN_ROLLBACK", "LEQ",
+  "NEQ", "GEQ", "T_EOF", "IDENTIFIER", "VALUE_STRING", "VALUE_INT",
+  "VALUE_FLOAT", "';'", "'='", "'.'", "'('", "')'", "','", "'<'", "'>'",
+  "'*'", "$accept", "start", "stmt", "txnStmt", "dbStmt", "ddl", "dml",
+  "OrderName", "optLimitClause", "preOrderClause", "optOrderClause",
+  "OrderClause", "fieldList", "field", "type", "valueList", "value",
+  "condition", "optWhereClause", "whereClause", "col", "colList", "op",
+  "expr", "setClauses", "setClause", "selector", "tableList", "tbName",
+  "colName", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_int16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,    59,    40,    41,    44,    46,    61,    60,    62,    42
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-#define YYPACT_NINF (-68)
+#define YYPACT_NINF (-79)
 
 #define yypact_value_is_default(Yyn) \
   ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF (-71)
+#define YYTABLE_NINF (-75)
 
 #define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int8 yypact[] =
 {
-      27,    15,     4,     7,   -26,    13,    29,   -26,    12,   -68,
-     -68,   -68,   -68,   -68,   -68,   -68,    48,     9,   -68,   -68,
-     -68,   -68,   -68,   -26,   -26,   -26,   -26,   -68,   -68,   -26,
-     -26,    43,    40,   -68,   -68,    42,    69,    44,   -68,   -68,
-     -68,    45,    46,   -68,    49,    77,    76,    57,    58,   -26,
-      57,    57,    57,    57,    54,    58,   -68,   -68,    -5,   -68,
-      51,   -68,    -2,   -68,   -68,   -27,   -68,    50,    55,    56,
-      39,   -68,    75,    18,    57,   -68,    39,   -26,   -26,    85,
-     -68,    57,   -68,    60,   -68,   -68,   -68,   -68,   -68,   -68,
-     -68,    37,   -68,    58,   -68,   -68,   -68,   -68,   -68,   -68,
-      30,   -68,   -68,   -68,   -68,    57,   -68,   -68,    64,   -68,
-      39,   -68,   -68,   -68,   -68,   -68,    -7,    74,    61,   -68,
-      66,    57,   -68,   -68,   -68,   -68,   -68,   -68,   -68
+      43,     9,     5,    10,   -23,    26,    16,   -23,    15,   -24,
+     -79,   -79,   -79,   -79,   -79,   -79,   -79,    34,     1,   -79,
+     -79,   -79,   -79,   -79,   -79,   -23,   -23,   -23,   -23,   -79,
+     -79,   -23,   -23,    49,    23,    33,    35,   -79,   -79,    31,
+      55,    37,   -79,   -79,   -79,    41,    42,   -79,    50,    69,
+      79,    60,    59,    62,    66,   -23,    60,    60,    60,    60,
+      61,    66,   -79,   -79,    -5,   -79,    64,   -79,    65,   -79,
+      22,   -79,   -79,   -10,   -79,    -4,    63,    67,    19,   -79,
+      84,    54,    60,   -79,    19,    71,   -23,   -23,    89,   -79,
+      60,   -79,    70,   -79,    72,   -79,   -79,   -79,   -79,   -79,
+     -79,    18,   -79,    66,   -79,   -79,   -79,   -79,   -79,   -79,
+      53,   -79,   -79,   -79,   -79,   -79,    60,   -79,   -79,    74,
+      76,   -79,    19,   -79,   -79,   -79,   -79,   -79,    -7,    47,
+      73,    75,   -79,    78,    60,   -79,   -79,   -79,   -79,   -79,
+     -79,   -79,   -79
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
 static const yytype_int8 yydefact[] =
 {
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     4,
-       3,    10,    11,    12,    13,     5,     0,     0,     9,     6,
-       7,     8,    14,     0,     0,     0,     0,    70,    17,     0,
-       0,     0,    71,    65,    52,    66,     0,     0,    51,     1,
-       2,     0,     0,    16,     0,     0,    46,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,    21,    71,    46,    62,
-       0,    53,    46,    67,    50,     0,    34,     0,     0,     0,
-       0,    48,    47,     0,     0,    22,     0,     0,     0,    30,
-      15,     0,    37,     0,    39,    36,    18,    19,    44,    42,
-      43,     0,    40,     0,    58,    57,    59,    54,    55,    56,
-       0,    63,    64,    69,    68,     0,    23,    35,     0,    20,
-       0,    49,    60,    61,    45,    32,    27,    24,     0,    41,
-       0,     0,    31,    26,    25,    29,    38,    28,    33
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       4,     3,    10,    11,    12,    13,     5,     0,     0,     9,
+       6,     7,     8,    14,    15,     0,     0,     0,     0,    74,
+      20,     0,     0,     0,    74,     0,    75,    69,    56,    70,
+       0,     0,    55,     1,     2,     0,     0,    19,     0,     0,
+      50,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,    24,    75,    50,    66,     0,    16,     0,    57,
+      50,    71,    54,     0,    37,     0,     0,     0,     0,    52,
+      51,     0,     0,    25,     0,     0,     0,     0,    33,    18,
+       0,    40,     0,    42,     0,    39,    21,    22,    48,    46,
+      47,     0,    44,     0,    62,    61,    63,    58,    59,    60,
+       0,    67,    68,    17,    73,    72,     0,    26,    38,     0,
+       0,    23,     0,    53,    64,    65,    49,    35,    30,    27,
+       0,     0,    45,     0,     0,    34,    29,    28,    32,    41,
+      43,    31,    36
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
-     -68,   -68,   -68,   -68,   -68,   -68,   -68,   -68,   -68,   -15,
-     -68,   -68,   -68,    26,   -68,   -68,   -67,    16,   -44,   -68,
-      -8,   -68,   -68,   -68,   -68,    34,   -68,   -68,    -3,   -45
+     -79,   -79,   -79,   -79,   -79,   -79,   -79,   -79,   -79,   -22,
+     -79,   -79,   -79,    30,   -79,   -79,   -78,    20,   -43,   -79,
+      -9,   -79,   -79,   -79,   -79,    40,   -79,   -79,    -3,   -49
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int8 yydefgoto[] =
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_uint8 yydefgoto[] =
 {
-      -1,    16,    17,    18,    19,    20,    21,   125,   122,   115,
-     106,   116,    65,    66,    85,    91,    92,    71,    56,    72,
-      73,    35,   100,   114,    58,    59,    36,    62,    37,    38
+       0,    17,    18,    19,    20,    21,    22,   138,   135,   127,
+     117,   128,    73,    74,    95,   101,   102,    79,    62,    80,
+      81,    39,   110,   126,    64,    65,    40,    70,    41,    42
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int16 yytable[] =
 {
-      34,    28,    60,   120,    31,    64,    67,    68,    69,   102,
-      23,    27,    55,    25,    75,    55,    80,    81,    79,    22,
-      41,    42,    43,    44,    77,    29,    45,    46,    24,    60,
-       1,    26,     2,   112,     3,     4,    67,   121,     5,    74,
-      61,     6,    78,   119,    30,     7,    63,     8,    39,    32,
-      40,    94,    95,    96,     9,    10,    11,    12,    13,    14,
-     117,    33,    47,    15,    97,    98,    99,    32,    88,    89,
-      90,    82,    83,    84,   103,   104,   117,    88,    89,    90,
-     109,   110,   123,   124,    49,   -70,    48,    51,    52,    50,
-      54,    53,   113,    55,    57,    32,    70,    76,    86,    87,
-      93,   105,   108,   118,   126,   127,   128,   107,   101,   111
+      38,    30,    66,   133,    33,    35,   112,    72,    75,    76,
+      77,    25,    61,    23,    36,    29,    27,    91,    92,    93,
+      94,    83,    45,    46,    47,    48,    37,    88,    49,    50,
+      26,    32,   124,    66,    43,    28,    89,    90,    31,    61,
+     134,    75,    82,    44,   132,    69,     1,    24,     2,    86,
+       3,     4,    71,    34,     5,   136,   137,     6,    98,    99,
+     100,     7,     8,     9,   121,   122,    52,   129,    51,    87,
+      55,    10,    11,    12,    13,    14,    15,    53,    54,   -74,
+      16,    56,    60,   114,   115,   129,    57,    58,   104,   105,
+     106,    36,    98,    99,   100,    59,    61,   107,    63,    67,
+      68,   125,   108,   109,    36,   116,    78,    84,    85,    96,
+     103,   113,   142,    97,   130,   119,   131,   120,   141,   139,
+     118,   140,   111,   123
 };
 
-static const yytype_int8 yycheck[] =
+static const yytype_uint8 yycheck[] =
 {
-       8,     4,    47,    10,     7,    50,    51,    52,    53,    76,
-       6,    37,    17,     6,    58,    17,    43,    44,    62,     4,
-      23,    24,    25,    26,    26,    12,    29,    30,    24,    74,
-       3,    24,     5,   100,     7,     8,    81,    44,    11,    44,
-      48,    14,    44,   110,    15,    18,    49,    20,     0,    37,
-      41,    33,    34,    35,    27,    28,    29,    30,    31,    32,
-     105,    49,    19,    36,    46,    47,    48,    37,    38,    39,
-      40,    21,    22,    23,    77,    78,   121,    38,    39,    40,
-      43,    44,     8,     9,    15,    45,    44,    42,    42,    45,
-      13,    42,   100,    17,    37,    37,    42,    46,    43,    43,
-      25,    16,    42,    39,    43,    39,   121,    81,    74,    93
+       9,     4,    51,    10,     7,     8,    84,    56,    57,    58,
+      59,     6,    17,     4,    38,    38,     6,    21,    22,    23,
+      24,    64,    25,    26,    27,    28,    50,    70,    31,    32,
+      25,    15,   110,    82,     0,    25,    46,    47,    12,    17,
+      47,    90,    47,    42,   122,    54,     3,    38,     5,    27,
+       7,     8,    55,    38,    11,     8,     9,    14,    39,    40,
+      41,    18,    19,    20,    46,    47,    43,   116,    19,    47,
+      15,    28,    29,    30,    31,    32,    33,    44,    47,    44,
+      37,    44,    13,    86,    87,   134,    45,    45,    34,    35,
+      36,    38,    39,    40,    41,    45,    17,    43,    38,    40,
+      38,   110,    48,    49,    38,    16,    45,    43,    43,    46,
+      26,    40,   134,    46,    40,    45,    40,    45,    40,    46,
+      90,    46,    82,   103
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
 static const yytype_int8 yystos[] =
 {
-       0,     3,     5,     7,     8,    11,    14,    18,    20,    27,
-      28,    29,    30,    31,    32,    36,    51,    52,    53,    54,
-      55,    56,     4,     6,    24,     6,    24,    37,    78,    12,
-      15,    78,    37,    49,    70,    71,    76,    78,    79,     0,
-      41,    78,    78,    78,    78,    78,    78,    19,    44,    15,
-      45,    42,    42,    42,    13,    17,    68,    37,    74,    75,
-      79,    70,    77,    78,    79,    62,    63,    79,    79,    79,
-      42,    67,    69,    70,    44,    68,    46,    26,    44,    68,
-      43,    44,    21,    22,    23,    64,    43,    43,    38,    39,
-      40,    65,    66,    25,    33,    34,    35,    46,    47,    48,
-      72,    75,    66,    78,    78,    16,    60,    63,    42,    43,
-      44,    67,    66,    70,    73,    59,    61,    79,    39,    66,
-      10,    44,    58,     8,     9,    57,    43,    39,    59
+       0,     3,     5,     7,     8,    11,    14,    18,    19,    20,
+      28,    29,    30,    31,    32,    33,    37,    52,    53,    54,
+      55,    56,    57,     4,    38,     6,    25,     6,    25,    38,
+      79,    12,    15,    79,    38,    79,    38,    50,    71,    72,
+      77,    79,    80,     0,    42,    79,    79,    79,    79,    79,
+      79,    19,    43,    44,    47,    15,    44,    45,    45,    45,
+      13,    17,    69,    38,    75,    76,    80,    40,    38,    71,
+      78,    79,    80,    63,    64,    80,    80,    80,    45,    68,
+      70,    71,    47,    69,    43,    43,    27,    47,    69,    46,
+      47,    21,    22,    23,    24,    65,    46,    46,    39,    40,
+      41,    66,    67,    26,    34,    35,    36,    43,    48,    49,
+      73,    76,    67,    40,    79,    79,    16,    61,    64,    45,
+      45,    46,    47,    68,    67,    71,    74,    60,    62,    80,
+      40,    40,    67,    10,    47,    59,     8,     9,    58,    46,
+      46,    40,    60
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr1[] =
 {
-       0,    50,    51,    51,    51,    51,    52,    52,    52,    52,
-      53,    53,    53,    53,    54,    55,    55,    55,    55,    55,
-      56,    56,    56,    56,    57,    57,    57,    58,    58,    59,
-      60,    60,    61,    61,    62,    62,    63,    64,    64,    64,
-      65,    65,    66,    66,    66,    67,    68,    68,    69,    69,
-      70,    70,    71,    71,    72,    72,    72,    72,    72,    72,
-      73,    73,    74,    74,    75,    76,    76,    77,    77,    77,
-      78,    79
+       0,    51,    52,    52,    52,    52,    53,    53,    53,    53,
+      54,    54,    54,    54,    55,    55,    55,    55,    56,    56,
+      56,    56,    56,    57,    57,    57,    57,    58,    58,    58,
+      59,    59,    60,    61,    61,    62,    62,    63,    63,    64,
+      65,    65,    65,    65,    66,    66,    67,    67,    67,    68,
+      69,    69,    70,    70,    71,    71,    72,    72,    73,    73,
+      73,    73,    73,    73,    74,    74,    75,    75,    76,    77,
+      77,    78,    78,    78,    79,    80
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr2[] =
 {
        0,     2,     2,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     2,     6,     3,     2,     6,     6,
-       7,     4,     5,     6,     0,     1,     1,     0,     2,     2,
-       0,     3,     1,     3,     1,     3,     2,     1,     4,     1,
-       1,     3,     1,     1,     1,     3,     0,     2,     1,     3,
-       3,     1,     1,     3,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     3,     3,     1,     1,     1,     3,     3,
-       1,     1
+       1,     1,     1,     1,     2,     2,     4,     6,     6,     3,
+       2,     6,     6,     7,     4,     5,     6,     0,     1,     1,
+       0,     2,     2,     0,     3,     1,     3,     1,     3,     2,
+       1,     4,     1,     4,     1,     3,     1,     1,     1,     3,
+       0,     2,     1,     3,     3,     1,     1,     3,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     3,     3,     1,
+       1,     1,     3,     3,     1,     1
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
 #define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
@@ -776,10 +813,9 @@ static const yytype_int8 yyr2[] =
       }                                                           \
   while (0)
 
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 /* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
    If N is 0, then set CURRENT to the empty location which ends
@@ -823,12 +859,19 @@ do {                                            \
 } while (0)
 
 
-/* YY_LOCATION_PRINT -- Print the location on the stream.
+/* YYLOCATION_PRINT -- Print the location on the stream.
    This macro was not mandated originally: define only if we know
    we won't break user code: when these are the locations we know.  */
 
-#ifndef YY_LOCATION_PRINT
-# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+# ifndef YYLOCATION_PRINT
+
+#  if defined YY_LOCATION_PRINT
+
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
+
+#  elif defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
 
 /* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
 
@@ -856,24 +899,32 @@ yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
         res += YYFPRINTF (yyo, "-%d", end_col);
     }
   return res;
- }
+}
 
-#  define YY_LOCATION_PRINT(File, Loc)          \
-  yy_location_print_ (File, &(Loc))
+#   define YYLOCATION_PRINT  yy_location_print_
 
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
 
+#  else
+
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+#  endif
+# endif /* !defined YYLOCATION_PRINT */
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value, Location); \
+                  Kind, Value, Location); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
@@ -884,19 +935,16 @@ do {                                                                      \
 `-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
 {
   FILE *yyoutput = yyo;
-  YYUSE (yyoutput);
-  YYUSE (yylocationp);
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyo, yytoknum[yytype], *yyvaluep);
-# endif
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
@@ -906,14 +954,15 @@ yy_symbol_value_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep, YY
 `---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
 {
   YYFPRINTF (yyo, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  YY_LOCATION_PRINT (yyo, *yylocationp);
+  YYLOCATION_PRINT (yyo, yylocationp);
   YYFPRINTF (yyo, ": ");
-  yy_symbol_value_print (yyo, yytype, yyvaluep, yylocationp);
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp);
   YYFPRINTF (yyo, ")");
 }
 
@@ -946,7 +995,8 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
+                 int yyrule)
 {
   int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
@@ -958,9 +1008,9 @@ yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[+yyssp[yyi + 1 - yynrhs]],
-                       &yyvsp[(yyi + 1) - (yynrhs)]
-                       , &(yylsp[(yyi + 1) - (yynrhs)])                       );
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)],
+                       &(yylsp[(yyi + 1) - (yynrhs)]));
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -975,8 +1025,8 @@ do {                                    \
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
@@ -999,12 +1049,61 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yysymbol_kind_t yytoken;
+  YYLTYPE *yylloc;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  int yyn = yypact[+*yyctx->yyssp];
+  if (!yypact_value_is_default (yyn))
+    {
+      /* Start YYX at -YYN if negative to avoid negative indexes in
+         YYCHECK.  In other words, skip the first -YYN actions for
+         this state because they are default actions.  */
+      int yyxbegin = yyn < 0 ? -yyn : 0;
+      /* Stay within bounds of both yycheck and yytname.  */
+      int yychecklim = YYLAST - yyn + 1;
+      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+      int yyx;
+      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
+        if (yycheck[yyx + yyn] == yyx && yyx != YYSYMBOL_YYerror
+            && !yytable_value_is_error (yytable[yyx + yyn]))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
-#  else
+
+
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
 /* Return the length of YYSTR.  */
 static YYPTRDIFF_T
 yystrlen (const char *yystr)
@@ -1014,13 +1113,13 @@ yystrlen (const char *yystr)
     continue;
   return yylen;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
 /* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
    YYDEST.  */
 static char *
@@ -1034,10 +1133,10 @@ yystpcpy (char *yydest, const char *yysrc)
 
   return yyd - 1;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yytnamerr
+#ifndef yytnamerr
 /* Copy to YYRES the contents of YYSTR after stripping away unnecessary
    quotes and backslashes, so that it's suitable for yyerror.  The
    heuristic is that double-quoting is unnecessary unless the string
@@ -1052,7 +1151,6 @@ yytnamerr (char *yyres, const char *yystr)
     {
       YYPTRDIFF_T yyn = 0;
       char const *yyp = yystr;
-
       for (;;)
         switch (*++yyp)
           {
@@ -1086,31 +1184,15 @@ yytnamerr (char *yyres, const char *yystr)
   else
     return yystrlen (yystr);
 }
-# endif
+#endif
 
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
 
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
 static int
-yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
-                yy_state_t *yyssp, int yytoken)
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
 {
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat: reported tokens (one for the "unexpected",
-     one per "expected"). */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
   /* Actual size of YYARG. */
   int yycount = 0;
-  /* Cumulated lengths of YYARG.  */
-  YYPTRDIFF_T yysize = 0;
-
   /* There are many possibilities here to consider:
      - If this state is a consistent state with a default action, then
        the only way this function was invoked is if the default action
@@ -1134,52 +1216,54 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
        one exception: it will still contain any token that will not be
        accepted due to an error action in a later state.
   */
-  if (yytoken != YYEMPTY)
-    {
-      int yyn = yypact[+*yyssp];
-      YYPTRDIFF_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-      yysize = yysize0;
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYPTRDIFF_T yysize1
-                    = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
-                    yysize = yysize1;
-                  else
-                    return 2;
-                }
-              }
-        }
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
+    {
+      int yyn;
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else
+        yycount += yyn;
     }
+  return yycount;
+}
+
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.
+
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
 
   switch (yycount)
     {
-# define YYCASE_(N, S)                      \
+#define YYCASE_(N, S)                       \
       case N:                               \
         yyformat = S;                       \
-      break
+        break
     default: /* Avoid compiler warnings. */
       YYCASE_(0, YY_("syntax error"));
       YYCASE_(1, YY_("syntax error, unexpected %s"));
@@ -1187,17 +1271,23 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
       YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
       YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
       YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
+#undef YYCASE_
     }
 
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
   {
-    /* Don't count the "%s"s in the final size, but reserve room for
-       the terminator.  */
-    YYPTRDIFF_T yysize1 = yysize + (yystrlen (yyformat) - 2 * yycount) + 1;
-    if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
-      yysize = yysize1;
-    else
-      return 2;
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
   }
 
   if (*yymsg_alloc < yysize)
@@ -1206,7 +1296,7 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
       if (! (yysize <= *yymsg_alloc
              && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
         *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
+      return -1;
     }
 
   /* Avoid sprintf, as that infringes on the user's name space.
@@ -1218,7 +1308,7 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
     while ((*yyp = *yyformat) != '\0')
       if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
         {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
           yyformat += 2;
         }
       else
@@ -1229,29 +1319,32 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
   }
   return 0;
 }
-#endif /* YYERROR_VERBOSE */
+
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, YYLTYPE *yylocationp)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp)
 {
-  YYUSE (yyvaluep);
-  YYUSE (yylocationp);
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
 
 
+
+
 /*----------.
 | yyparse.  |
 `----------*/
@@ -1259,7 +1352,7 @@ yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, YYLTYPE *yylocatio
 int
 yyparse (void)
 {
-/* The lookahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
 
@@ -1278,55 +1371,50 @@ static YYLTYPE yyloc_default
 YYLTYPE yylloc = yyloc_default;
 
     /* Number of syntax errors so far.  */
-    int yynerrs;
+    int yynerrs = 0;
 
-    yy_state_fast_t yystate;
+    yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
+    int yyerrstatus = 0;
 
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
-       'yyls': related to locations.
-
-       Refer to the stacks through separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
     yy_state_t yyssa[YYINITDEPTH];
-    yy_state_t *yyss;
-    yy_state_t *yyssp;
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    /* The semantic value stack.  */
+    /* The semantic value stack: array, bottom, top.  */
     YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
-    /* The location stack.  */
+    /* The location stack: array, bottom, top.  */
     YYLTYPE yylsa[YYINITDEPTH];
-    YYLTYPE *yyls;
-    YYLTYPE *yylsp;
-
-    /* The locations where the error started and ended.  */
-    YYLTYPE yyerror_range[3];
-
-    YYPTRDIFF_T yystacksize;
+    YYLTYPE *yyls = yylsa;
+    YYLTYPE *yylsp = yyls;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
   YYLTYPE yyloc;
 
-#if YYERROR_VERBOSE
+  /* The locations where the error started and ended.  */
+  YYLTYPE yyerror_range[3];
+
   /* Buffer for error messages, and its allocated size.  */
   char yymsgbuf[128];
   char *yymsg = yymsgbuf;
   YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
-#endif
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
 
@@ -1334,17 +1422,10 @@ YYLTYPE yylloc = yyloc_default;
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yylsp = yyls = yylsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   yylsp[0] = yylloc;
   goto yysetstate;
 
@@ -1367,10 +1448,11 @@ yysetstate:
   YY_IGNORE_USELESS_CAST_BEGIN
   *yyssp = YY_CAST (yy_state_t, yystate);
   YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
 #if !defined yyoverflow && !defined YYSTACK_RELOCATE
-    goto yyexhaustedlab;
+    YYNOMEM;
 #else
     {
       /* Get the current used size of the three stacks, in elements.  */
@@ -1401,7 +1483,7 @@ yysetstate:
 # else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
@@ -1412,11 +1494,11 @@ yysetstate:
           YY_CAST (union yyalloc *,
                    YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
         YYSTACK_RELOCATE (yyls_alloc, yyls);
-# undef YYSTACK_RELOCATE
+#  undef YYSTACK_RELOCATE
         if (yyss1 != yyssa)
           YYSTACK_FREE (yyss1);
       }
@@ -1436,6 +1518,7 @@ yysetstate:
     }
 #endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
+
   if (yystate == YYFINAL)
     YYACCEPT;
 
@@ -1456,18 +1539,30 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
+      YYDPRINTF ((stderr, "Reading a token\n"));
       yychar = yylex (&yylval, &yylloc);
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      yyerror_range[1] = yylloc;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1539,514 +1634,546 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-  case 2:
-#line 59 "/home/long/rucbase/src/parser/yacc.y"
+  case 2: /* start: stmt ';'  */
+#line 60 "/root/repo/src/parser/yacc.y"
     {
         parse_tree = (yyvsp[-1].sv_node);
         YYACCEPT;
     }
-#line 1549 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1644 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 3:
-#line 64 "/home/long/rucbase/src/parser/yacc.y"
+  case 3: /* start: HELP  */
+#line 65 "/root/repo/src/parser/yacc.y"
     {
         parse_tree = std::make_shared<Help>();
         YYACCEPT;
     }
-#line 1558 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1653 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 4:
-#line 69 "/home/long/rucbase/src/parser/yacc.y"
+  case 4: /* start: EXIT  */
+#line 70 "/root/repo/src/parser/yacc.y"
     {
         parse_tree = nullptr;
         YYACCEPT;
     }
-#line 1567 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1662 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 5:
-#line 74 "/home/long/rucbase/src/parser/yacc.y"
+  case 5: /* start: T_EOF  */
+#line 75 "/root/repo/src/parser/yacc.y"
     {
         parse_tree = nullptr;
         YYACCEPT;
     }
-#line 1576 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1671 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 10:
-#line 89 "/home/long/rucbase/src/parser/yacc.y"
+  case 10: /* txnStmt: TXN_BEGIN  */
+#line 90 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnBegin>();
     }
-#line 1584 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1679 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 11:
-#line 93 "/home/long/rucbase/src/parser/yacc.y"
+  case 11: /* txnStmt: TXN_COMMIT  */
+#line 94 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnCommit>();
     }
-#line 1592 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1687 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 12:
-#line 97 "/home/long/rucbase/src/parser/yacc.y"
+  case 12: /* txnStmt: TXN_ABORT  */
+#line 98 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnAbort>();
     }
-#line 1600 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1695 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 13:
-#line 101 "/home/long/rucbase/src/parser/yacc.y"
+  case 13: /* txnStmt: TXN_ROLLBACK  */
+#line 102 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnRollback>();
     }
-#line 1608 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1703 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 14:
-#line 108 "/home/long/rucbase/src/parser/yacc.y"
+  case 14: /* dbStmt: SHOW TABLES  */
+#line 109 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<ShowTables>();
     }
-#line 1616 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1711 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 15: /* dbStmt: SHOW IDENTIFIER  */
+#line 113 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<ShowOption>((yyvsp[0].sv_str));
+    }
+#line 1719 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 16: /* dbStmt: SET IDENTIFIER '=' VALUE_INT  */
+#line 117 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<SetOption>((yyvsp[-2].sv_str), (yyvsp[0].sv_int));
+    }
+#line 1727 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 15:
-#line 115 "/home/long/rucbase/src/parser/yacc.y"
+  case 17: /* dbStmt: SET tbName '.' IDENTIFIER '=' VALUE_INT  */
+#line 121 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<SetOption>((yyvsp[-4].sv_str), (yyvsp[-2].sv_str), (yyvsp[0].sv_int));
+    }
+#line 1735 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 18: /* ddl: CREATE TABLE tbName '(' fieldList ')'  */
+#line 128 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<CreateTable>((yyvsp[-3].sv_str), (yyvsp[-1].sv_fields));
     }
-#line 1624 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1743 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 16:
-#line 119 "/home/long/rucbase/src/parser/yacc.y"
+  case 19: /* ddl: DROP TABLE tbName  */
+#line 132 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DropTable>((yyvsp[0].sv_str));
     }
-#line 1632 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1751 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 17:
-#line 123 "/home/long/rucbase/src/parser/yacc.y"
+  case 20: /* ddl: DESC tbName  */
+#line 136 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DescTable>((yyvsp[0].sv_str));
     }
-#line 1640 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1759 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 18:
-#line 127 "/home/long/rucbase/src/parser/yacc.y"
+  case 21: /* ddl: CREATE INDEX tbName '(' colName ')'  */
+#line 140 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<CreateIndex>((yyvsp[-3].sv_str), (yyvsp[-1].sv_str));
     }
-#line 1648 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1767 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 19:
-#line 131 "/home/long/rucbase/src/parser/yacc.y"
+  case 22: /* ddl: DROP INDEX tbName '(' colName ')'  */
+#line 144 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DropIndex>((yyvsp[-3].sv_str), (yyvsp[-1].sv_str));
     }
-#line 1656 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1775 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 20:
-#line 138 "/home/long/rucbase/src/parser/yacc.y"
+  case 23: /* dml: INSERT INTO tbName VALUES '(' valueList ')'  */
+#line 151 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<InsertStmt>((yyvsp[-4].sv_str), (yyvsp[-1].sv_vals));
     }
-#line 1664 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1783 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 21:
-#line 142 "/home/long/rucbase/src/parser/yacc.y"
+  case 24: /* dml: DELETE FROM tbName optWhereClause  */
+#line 155 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DeleteStmt>((yyvsp[-1].sv_str), (yyvsp[0].sv_conds));
     }
-#line 1672 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1791 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 22:
-#line 146 "/home/long/rucbase/src/parser/yacc.y"
+  case 25: /* dml: UPDATE tbName SET setClauses optWhereClause  */
+#line 159 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<UpdateStmt>((yyvsp[-3].sv_str), (yyvsp[-1].sv_set_clauses), (yyvsp[0].sv_conds));
     }
-#line 1680 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1799 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 23:
-#line 150 "/home/long/rucbase/src/parser/yacc.y"
+  case 26: /* dml: SELECT selector FROM tableList optWhereClause optOrderClause  */
+#line 163 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<SelectStmt>((yyvsp[-4].sv_cols), (yyvsp[-2].sv_strs), (yyvsp[-1].sv_conds), (yyvsp[0].sv_limit));
     }
-#line 1688 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1807 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 24:
-#line 157 "/home/long/rucbase/src/parser/yacc.y"
+  case 27: /* OrderName: %empty  */
+#line 170 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_str) = "ASC";
     }
-#line 1696 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1815 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 25:
-#line 161 "/home/long/rucbase/src/parser/yacc.y"
+  case 28: /* OrderName: ASC  */
+#line 174 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_str) = "ASC";
     }
-#line 1704 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1823 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 26:
-#line 165 "/home/long/rucbase/src/parser/yacc.y"
+  case 29: /* OrderName: DESC  */
+#line 178 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_str) = "DESC";
     }
-#line 1712 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1831 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 27:
-#line 171 "/home/long/rucbase/src/parser/yacc.y"
+  case 30: /* optLimitClause: %empty  */
+#line 184 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_int) = -1;
     }
-#line 1720 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1839 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 28:
-#line 175 "/home/long/rucbase/src/parser/yacc.y"
+  case 31: /* optLimitClause: LIMIT VALUE_INT  */
+#line 188 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_int) = (yyvsp[0].sv_int);
     }
-#line 1728 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1847 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 29:
-#line 182 "/home/long/rucbase/src/parser/yacc.y"
+  case 32: /* preOrderClause: colName OrderName  */
+#line 195 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_order) = std::make_shared<OrderExpr>((yyvsp[-1].sv_str), (yyvsp[0].sv_str));
     }
-#line 1736 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1855 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 30:
-#line 189 "/home/long/rucbase/src/parser/yacc.y"
+  case 33: /* optOrderClause: %empty  */
+#line 202 "/root/repo/src/parser/yacc.y"
     { 
         (yyval.sv_limit) = std::make_shared<Order2Limit>(std::vector<std::shared_ptr<OrderExpr>>{}, -1);
     }
-#line 1744 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1863 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 31:
-#line 193 "/home/long/rucbase/src/parser/yacc.y"
+  case 34: /* optOrderClause: ORDER OrderClause optLimitClause  */
+#line 206 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_limit) = std::make_shared<Order2Limit>((yyvsp[-1].sv_orders), (yyvsp[0].sv_int));
     }
-#line 1752 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1871 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 32:
-#line 200 "/home/long/rucbase/src/parser/yacc.y"
+  case 35: /* OrderClause: preOrderClause  */
+#line 213 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_orders) = std::vector<std::shared_ptr<OrderExpr>>{(yyvsp[0].sv_order)};
     }
-#line 1760 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1879 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 33:
-#line 204 "/home/long/rucbase/src/parser/yacc.y"
+  case 36: /* OrderClause: OrderClause ',' preOrderClause  */
+#line 217 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_orders).push_back((yyvsp[0].sv_order));
     }
-#line 1768 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1887 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 34:
-#line 211 "/home/long/rucbase/src/parser/yacc.y"
+  case 37: /* fieldList: field  */
+#line 224 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_fields) = std::vector<std::shared_ptr<Field>>{(yyvsp[0].sv_field)};
     }
-#line 1776 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1895 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 35:
-#line 215 "/home/long/rucbase/src/parser/yacc.y"
+  case 38: /* fieldList: fieldList ',' field  */
+#line 228 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_fields).push_back((yyvsp[0].sv_field));
     }
-#line 1784 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1903 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 36:
-#line 222 "/home/long/rucbase/src/parser/yacc.y"
+  case 39: /* field: colName type  */
+#line 235 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_field) = std::make_shared<ColDef>((yyvsp[-1].sv_str), (yyvsp[0].sv_type_len));
     }
-#line 1792 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1911 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 37:
-#line 229 "/home/long/rucbase/src/parser/yacc.y"
+  case 40: /* type: INT  */
+#line 242 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_INT, sizeof(int));
     }
-#line 1800 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1919 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 38:
-#line 233 "/home/long/rucbase/src/parser/yacc.y"
+  case 41: /* type: CHAR '(' VALUE_INT ')'  */
+#line 246 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_STRING, (yyvsp[-1].sv_int));
     }
-#line 1808 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1927 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 39:
-#line 237 "/home/long/rucbase/src/parser/yacc.y"
+  case 42: /* type: FLOAT  */
+#line 250 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_FLOAT, sizeof(float));
     }
-#line 1816 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1935 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 43: /* type: VARCHAR '(' VALUE_INT ')'  */
+#line 254 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_VARCHAR, (yyvsp[-1].sv_int));
+    }
+#line 1943 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 40:
-#line 244 "/home/long/rucbase/src/parser/yacc.y"
+  case 44: /* valueList: value  */
+#line 261 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_vals) = std::vector<std::shared_ptr<Value>>{(yyvsp[0].sv_val)};
     }
-#line 1824 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1951 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 41:
-#line 248 "/home/long/rucbase/src/parser/yacc.y"
+  case 45: /* valueList: valueList ',' value  */
+#line 265 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_vals).push_back((yyvsp[0].sv_val));
     }
-#line 1832 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1959 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 42:
-#line 255 "/home/long/rucbase/src/parser/yacc.y"
+  case 46: /* value: VALUE_INT  */
+#line 272 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<IntLit>((yyvsp[0].sv_int));
     }
-#line 1840 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1967 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 43:
-#line 259 "/home/long/rucbase/src/parser/yacc.y"
+  case 47: /* value: VALUE_FLOAT  */
+#line 276 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<FloatLit>((yyvsp[0].sv_float));
     }
-#line 1848 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1975 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 44:
-#line 263 "/home/long/rucbase/src/parser/yacc.y"
+  case 48: /* value: VALUE_STRING  */
+#line 280 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<StringLit>((yyvsp[0].sv_str));
     }
-#line 1856 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1983 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 45:
-#line 270 "/home/long/rucbase/src/parser/yacc.y"
+  case 49: /* condition: col op expr  */
+#line 287 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_cond) = std::make_shared<BinaryExpr>((yyvsp[-2].sv_col), (yyvsp[-1].sv_comp_op), (yyvsp[0].sv_expr));
     }
-#line 1864 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1991 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 46:
-#line 276 "/home/long/rucbase/src/parser/yacc.y"
+  case 50: /* optWhereClause: %empty  */
+#line 293 "/root/repo/src/parser/yacc.y"
                       { /* ignore*/ }
-#line 1870 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 1997 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 47:
-#line 278 "/home/long/rucbase/src/parser/yacc.y"
+  case 51: /* optWhereClause: WHERE whereClause  */
+#line 295 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_conds) = (yyvsp[0].sv_conds);
     }
-#line 1878 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 2005 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 48:
-#line 285 "/home/long/rucbase/src/parser/yacc.y"
+  case 52: /* whereClause: condition  */
+#line 302 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_conds) = std::vector<std::shared_ptr<BinaryExpr>>{(yyvsp[0].sv_cond)};
     }
-#line 1886 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 2013 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 49:
-#line 289 "/home/long/rucbase/src/parser/yacc.y"
+  case 53: /* whereClause: whereClause AND condition  */
+#line 306 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_conds).push_back((yyvsp[0].sv_cond));
     }
-#line 1894 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 2021 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 50:
-#line 296 "/home/long/rucbase/src/parser/yacc.y"
+  case 54: /* col: tbName '.' colName  */
+#line 313 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>((yyvsp[-2].sv_str), (yyvsp[0].sv_str));
     }
-#line 1902 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 2029 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 51:
-#line 300 "/home/long/rucbase/src/parser/yacc.y"
+  case 55: /* col: colName  */
+#line 317 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>("", (yyvsp[0].sv_str));
     }
-#line 1910 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 2037 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 52:
-#line 307 "/home/long/rucbase/src/parser/yacc.y"
+  case 56: /* colList: col  */
+#line 324 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_cols) = std::vector<std::shared_ptr<Col>>{(yyvsp[0].sv_col)};
     }
-#line 1918 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 2045 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 53:
-#line 311 "/home/long/rucbase/src/parser/yacc.y"
+  case 57: /* colList: colList ',' col  */
+#line 328 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_cols).push_back((yyvsp[0].sv_col));
     }
-#line 1926 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 2053 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 54:
-#line 318 "/home/long/rucbase/src/parser/yacc.y"
+  case 58: /* op: '='  */
+#line 335 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_EQ;
     }
-#line 1934 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 2061 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 55:
-#line 322 "/home/long/rucbase/src/parser/yacc.y"
+  case 59: /* op: '<'  */
+#line 339 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_LT;
     }
-#line 1942 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 2069 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 56:
-#line 326 "/home/long/rucbase/src/parser/yacc.y"
+  case 60: /* op: '>'  */
+#line 343 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_GT;
     }
-#line 1950 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 2077 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 57:
-#line 330 "/home/long/rucbase/src/parser/yacc.y"
+  case 61: /* op: NEQ  */
+#line 347 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_NE;
     }
-#line 1958 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 2085 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 58:
-#line 334 "/home/long/rucbase/src/parser/yacc.y"
+  case 62: /* op: LEQ  */
+#line 351 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_LE;
     }
-#line 1966 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 2093 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 59:
-#line 338 "/home/long/rucbase/src/parser/yacc.y"
+  case 63: /* op: GEQ  */
+#line 355 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_GE;
     }
-#line 1974 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 2101 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 60:
-#line 345 "/home/long/rucbase/src/parser/yacc.y"
+  case 64: /* expr: value  */
+#line 362 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_expr) = std::static_pointer_cast<Expr>((yyvsp[0].sv_val));
     }
-#line 1982 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 2109 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 61:
-#line 349 "/home/long/rucbase/src/parser/yacc.y"
+  case 65: /* expr: col  */
+#line 366 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_expr) = std::static_pointer_cast<Expr>((yyvsp[0].sv_col));
     }
-#line 1990 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 2117 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 62:
-#line 356 "/home/long/rucbase/src/parser/yacc.y"
+  case 66: /* setClauses: setClause  */
+#line 373 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_set_clauses) = std::vector<std::shared_ptr<SetClause>>{(yyvsp[0].sv_set_clause)};
     }
-#line 1998 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 2125 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 63:
-#line 360 "/home/long/rucbase/src/parser/yacc.y"
+  case 67: /* setClauses: setClauses ',' setClause  */
+#line 377 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_set_clauses).push_back((yyvsp[0].sv_set_clause));
     }
-#line 2006 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 2133 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 64:
-#line 367 "/home/long/rucbase/src/parser/yacc.y"
+  case 68: /* setClause: colName '=' value  */
+#line 384 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_set_clause) = std::make_shared<SetClause>((yyvsp[-2].sv_str), (yyvsp[0].sv_val));
     }
-#line 2014 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 2141 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 65:
-#line 374 "/home/long/rucbase/src/parser/yacc.y"
+  case 69: /* selector: '*'  */
+#line 391 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_cols) = {};
     }
-#line 2022 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 2149 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 67:
-#line 382 "/home/long/rucbase/src/parser/yacc.y"
+  case 71: /* tableList: tbName  */
+#line 399 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_strs) = std::vector<std::string>{(yyvsp[0].sv_str)};
     }
-#line 2030 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 2157 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 68:
-#line 386 "/home/long/rucbase/src/parser/yacc.y"
+  case 72: /* tableList: tableList ',' tbName  */
+#line 403 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_strs).push_back((yyvsp[0].sv_str));
     }
-#line 2038 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 2165 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 69:
-#line 390 "/home/long/rucbase/src/parser/yacc.y"
+  case 73: /* tableList: tableList JOIN tbName  */
+#line 407 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_strs).push_back((yyvsp[0].sv_str));
     }
-#line 2046 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 2173 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
 
-#line 2050 "/home/long/rucbase/src/parser/yacc.tab.cpp"
+#line 2177 "/root/repo/src/parser/yacc.tab.cpp"
 
       default: break;
     }
@@ -2061,11 +2188,10 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
   *++yylsp = yyloc;
@@ -2090,50 +2216,45 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (&yylloc, YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
       {
+        yypcontext_t yyctx
+          = {yyssp, yytoken, &yylloc};
         char const *yymsgp = YY_("syntax error");
         int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
         if (yysyntax_error_status == 0)
           yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
+        else if (yysyntax_error_status == -1)
           {
             if (yymsg != yymsgbuf)
               YYSTACK_FREE (yymsg);
-            yymsg = YY_CAST (char *, YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
-            if (!yymsg)
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
               {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
               }
             else
               {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
               }
           }
         yyerror (&yylloc, yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
       }
-# undef YYSYNTAX_ERROR
-#endif
     }
 
   yyerror_range[1] = yylloc;
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
@@ -2166,6 +2287,7 @@ yyerrorlab:
      label yyerrorlab therefore never appears in user code.  */
   if (0)
     YYERROR;
+  ++yynerrs;
 
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
@@ -2182,13 +2304,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -2202,7 +2325,7 @@ yyerrlab1:
 
       yyerror_range[1] = *yylsp;
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp, yylsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -2213,13 +2336,11 @@ yyerrlab1:
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
   yyerror_range[2] = yylloc;
-  /* Using YYLLOC is tempting, but would change the location of
-     the lookahead.  YYLOC is available though.  */
-  YYLLOC_DEFAULT (yyloc, yyerror_range, 2);
-  *++yylsp = yyloc;
+  ++yylsp;
+  YYLLOC_DEFAULT (*yylsp, yyerror_range, 2);
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2230,7 +2351,7 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
 
 
 /*-----------------------------------.
@@ -2238,24 +2359,22 @@ yyacceptlab:
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (&yylloc, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
 
 
-/*-----------------------------------------------------.
-| yyreturn -- parsing is finished, return the result.  |
-`-----------------------------------------------------*/
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
@@ -2271,18 +2390,17 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[+*yyssp], yyvsp, yylsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
   if (yymsg != yymsgbuf)
     YYSTACK_FREE (yymsg);
-#endif
   return yyresult;
 }
-#line 398 "/home/long/rucbase/src/parser/yacc.y"
+
+#line 415 "/root/repo/src/parser/yacc.y"
 
@@ -1,6 +1,7 @@
 %{
 #include "ast.h"
 #include "yacc.tab.h"
+
 #include <iostream>
 #include <memory>
 
@@ -22,7 +23,7 @@ using namespace ast;
 
 // keywords
 %token SHOW TABLES CREATE TABLE DROP DESC ASC LIMIT INSERT INTO VALUES DELETE FROM ORDER
-WHERE UPDATE SET SELECT INT CHAR FLOAT INDEX AND JOIN EXIT HELP TXN_BEGIN TXN_COMMIT TXN_ABORT TXN_ROLLBACK
+WHERE UPDATE SET SELECT INT CHAR FLOAT VARCHAR INDEX AND JOIN EXIT HELP TXN_BEGIN TXN_COMMIT TXN_ABORT TXN_ROLLBACK
 // non-keywords
 %token LEQ NEQ GEQ T_EOF
 
@@ -108,6 +109,18 @@ dbStmt:
     {
         $$ = std::make_shared<ShowTables>();
     }
+    |   SHOW IDENTIFIER
+    {
+        $$ = std::make_shared<ShowOption>($2);
+    }
+    |   SET IDENTIFIER '=' VALUE_INT
+    {
+        $$ = std::make_shared<SetOption>($2, $4);
+    }
+    |   SET tbName '.' IDENTIFIER '=' VALUE_INT
+    {
+        $$ = std::make_shared<SetOption>($2, $4, $6);
+    }
     ;
 
 ddl:
@@ -237,6 +250,10 @@ type:
     {
         $$ = std::make_shared<TypeLen>(SV_TYPE_FLOAT, sizeof(float));
     }
+    |   VARCHAR '(' VALUE_INT ')'
+    {
+        $$ = std::make_shared<TypeLen>(SV_TYPE_VARCHAR, $3);
+    }
     ;
 
 valueList:
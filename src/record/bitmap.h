@@ -3,6 +3,10 @@
 #include <cinttypes>
 #include <cstring>
 
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
 static constexpr int BITMAP_WIDTH = 8;
 static constexpr unsigned BITMAP_HIGHEST_BIT = 0x80u;  // 128 (2^7)
 
@@ -27,12 +31,27 @@ class Bitmap {
      * @param max_n 要找的从起始地址开始的偏移为[curr+1,max_n)
      * @param curr 要找的从起始地址开始的偏移为[curr+1,max_n)
      * @return 找到了就返回偏移位置，没找到就返回max_n
+     * @note 每次检查64位: 按大端读入一个word后, 第一个满足条件的位即最高的1位(__builtin_clzll);
+     * 支持AVX2时先以256位为单位跳过全0(找1时)或全1(找0时)的区域
      */
     static int next_bit(bool bit, const char *bm, int max_n, int curr) {
-        for (int i = curr + 1; i < max_n; i++) {
-            if (is_set(bm, i) == bit) {
-                return i;
+        int pos = curr + 1;
+        while (pos < max_n) {
+            if (pos % BITMAP_WIDTH == 0 && pos + AVX2_BITS <= max_n && has_avx2() &&
+                all_bits_avx2(!bit, bm + get_bucket(pos))) {
+                pos += AVX2_BITS;
+                continue;
+            }
+            // word覆盖[base, base + 64)位, 清除pos之前的位; 读入的字节超出bitmap时补0, 找0时取反后为1, 结果>=max_n
+            int base = pos - pos % BITMAP_WIDTH;
+            uint64_t word = load_word(bm + get_bucket(base), get_bucket(max_n - 1) - get_bucket(base) + 1);
+            if (!bit) word = ~word;
+            word &= ~uint64_t{0} >> (pos - base);
+            if (word != 0) {
+                int found = base + __builtin_clzll(word);
+                return found < max_n ? found : max_n;
             }
+            pos = base + WORD_BITS;
         }
         return max_n;
     }
@@ -45,7 +64,37 @@ class Bitmap {
     // rid_.slot_no); int slot_no = Bitmap::first_bit(false, page_handle.bitmap, file_hdr_.num_records_per_page);
 
    private:
+    static constexpr int WORD_BITS = 64;
+    static constexpr int AVX2_BITS = 256;
+
     static int get_bucket(int pos) { return pos / BITMAP_WIDTH; }
 
+    // 按大端读入从bm开始的min(num_bytes, 8)个字节, 使第一个字节位于最高位, 不足8字节时低位补0
+    static uint64_t load_word(const char *bm, int num_bytes) {
+        uint64_t word = 0;
+        memcpy(&word, bm, num_bytes < 8 ? num_bytes : 8);
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        word = __builtin_bswap64(word);
+#endif
+        return word;
+    }
+
+#if defined(__x86_64__)
+    static bool has_avx2() {
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+    }
+
+    // 从bm开始的32个字节是否全为bit
+    __attribute__((target("avx2"))) static bool all_bits_avx2(bool bit, const char *bm) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bm));
+        return bit ? _mm256_testc_si256(v, _mm256_set1_epi8(-1)) : _mm256_testz_si256(v, v);
+    }
+#else
+    static bool has_avx2() { return false; }
+
+    static bool all_bits_avx2(bool bit, const char *bm) { return false; }
+#endif
+
     static char get_bit(int pos) { return BITMAP_HIGHEST_BIT >> static_cast<char>(pos % BITMAP_WIDTH); }
 };
@@ -0,0 +1,150 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Rucbase
+//
+// bitmap_benchmark.cpp
+//
+// Identification: src/record/bitmap_benchmark.cpp
+//
+// Copyright (c) 2022, RUC Deke Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "bitmap.h"
+#include "gtest/gtest.h"
+#include "rm_defs.h"
+
+/**
+ * @brief 逐位检查的next_bit, 作为对照
+ */
+static int NaiveNextBit(bool bit, const char *bm, int max_n, int curr) {
+    for (int i = curr + 1; i < max_n; i++) {
+        if (Bitmap::is_set(bm, i) == bit) {
+            return i;
+        }
+    }
+    return max_n;
+}
+
+using NextBitFn = int (*)(bool, const char *, int, int);
+
+/**
+ * @brief 一组页面的bitmap, 每页num_slots个slot, 记录大小为8字节时每页约500个slot
+ */
+class BitmapBenchmark : public ::testing::Test {
+   public:
+    static constexpr int NUM_PAGES = 1024;
+    static constexpr int RECORD_SIZE = 8;
+    int num_slots_ = (BITMAP_WIDTH * (PAGE_SIZE - 1 - (int)sizeof(RmPageHdr)) + 1) / (1 + RECORD_SIZE * BITMAP_WIDTH);
+    int bitmap_size_ = (num_slots_ + BITMAP_WIDTH - 1) / BITMAP_WIDTH;
+    std::vector<char> bitmaps_;
+    std::default_random_engine rng_{15445};
+
+    char *GetBitmap(int page) { return bitmaps_.data() + page * bitmap_size_; }
+
+    /**
+     * @brief 每个slot以概率fill_ratio被使用
+     */
+    void Fill(double fill_ratio) {
+        bitmaps_.assign(static_cast<size_t>(NUM_PAGES) * bitmap_size_, 0);
+        std::bernoulli_distribution used(fill_ratio);
+        for (int page = 0; page < NUM_PAGES; page++) {
+            for (int slot = 0; slot < num_slots_; slot++) {
+                if (used(rng_)) Bitmap::set(GetBitmap(page), slot);
+            }
+        }
+    }
+
+    /**
+     * @brief 模拟insert_record: 在每个页面中找第一个空闲slot
+     * @return 耗时(秒), checksum为找到的slot之和
+     */
+    double FindFree(NextBitFn next_bit, int rounds, uint64_t *checksum) {
+        *checksum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < rounds; round++) {
+            for (int page = 0; page < NUM_PAGES; page++) {
+                *checksum += next_bit(false, GetBitmap(page), num_slots_, -1);
+            }
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+
+    /**
+     * @brief 模拟RmScan::next: 依次找出每个页面中所有被使用的slot
+     * @return 耗时(秒), checksum为找到的slot之和
+     */
+    double ScanUsed(NextBitFn next_bit, int rounds, uint64_t *checksum) {
+        *checksum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < rounds; round++) {
+            for (int page = 0; page < NUM_PAGES; page++) {
+                for (int slot = next_bit(true, GetBitmap(page), num_slots_, -1); slot < num_slots_;
+                     slot = next_bit(true, GetBitmap(page), num_slots_, slot)) {
+                    *checksum += slot;
+                }
+            }
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+
+    /**
+     * @brief 分别用逐位检查和Bitmap::next_bit执行run, 输出耗时并检查两者结果相同
+     */
+    template <typename Run>
+    void Compare(const char *name, Run run) {
+        uint64_t naive_sum, word_sum;
+        double naive_time = run(NaiveNextBit, &naive_sum);
+        double word_time = run(Bitmap::next_bit, &word_sum);
+        printf("%-24s slots/page: %d   bit-by-bit: %8.4fs   word: %8.4fs   speedup: %6.1fx\n", name, num_slots_,
+               naive_time, word_time, naive_time / word_time);
+        EXPECT_EQ(naive_sum, word_sum);
+    }
+};
+
+/**
+ * @brief 各种位置和填充率下的结果与逐位检查一致, 包括不足一个word的结尾
+ */
+TEST_F(BitmapBenchmark, CorrectnessTest) {
+    for (double fill_ratio : {0.0, 0.01, 0.5, 0.99, 1.0}) {
+        Fill(fill_ratio);
+        for (int page = 0; page < 16; page++) {
+            for (int max_n : {1, 7, 63, 64, 65, 255, 256, 257, num_slots_}) {
+                for (int curr = -1; curr < max_n; curr++) {
+                    for (bool bit : {false, true}) {
+                        ASSERT_EQ(NaiveNextBit(bit, GetBitmap(page), max_n, curr),
+                                  Bitmap::next_bit(bit, GetBitmap(page), max_n, curr));
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief 插入: 页面几乎已满时找第一个空闲slot
+ */
+TEST_F(BitmapBenchmark, FindFreeSlotTest) {
+    Fill(0.995);
+    Compare("find free (99.5% full)",
+            [this](NextBitFn next_bit, uint64_t *checksum) { return FindFree(next_bit, 200, checksum); });
+}
+
+/**
+ * @brief 顺序扫描: 半满和稀疏的页面中找出所有记录
+ */
+TEST_F(BitmapBenchmark, ScanUsedSlotsTest) {
+    Fill(0.5);
+    Compare("scan (50% full)",
+            [this](NextBitFn next_bit, uint64_t *checksum) { return ScanUsed(next_bit, 20, checksum); });
+    Fill(0.02);
+    Compare("scan (2% full)",
+            [this](NextBitFn next_bit, uint64_t *checksum) { return ScanUsed(next_bit, 20, checksum); });
+}
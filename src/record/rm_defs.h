@@ -8,23 +8,59 @@ constexpr int RM_NO_PAGE = -1;
 constexpr int RM_FILE_HDR_PAGE = 0;
 constexpr int RM_FIRST_RECORD_PAGE = 1;
 constexpr int RM_MAX_RECORD_SIZE = 512;
+constexpr int RM_MAX_VAR_FIELDS = 32;
+
+// 记录中的一个变长字段(VARCHAR), 字段的实际长度为第一个'\0'之前的字节数
+struct RmVarField {
+    int offset;  // 字段在记录中的偏移量
+    int len;     // 字段的最大长度
+};
 
 // record file header（RmManager::create_file函数初始化，并写入磁盘文件中的第0页）
 struct RmFileHdr {
     int record_size;  // 元组大小（长度不固定，由上层进行初始化）
     // std::atomic<page_id_t> num_pages;
-    int num_pages;             // 文件中当前分配的page个数（初始化为1）
-    int num_records_per_page;  // 每个page最多能存储的元组个数
-    int first_free_page_no;    // 文件中当前第一个可用的page no（初始化为-1）
-    int bitmap_size;           // bitmap大小
+    page_id_t num_pages;           // 文件中当前分配的page个数（初始化为1）
+    int num_records_per_page;      // 每个page最多能存储的元组个数
+    page_id_t first_free_page_no;  // 不再使用, 始终为-1; 页面的空闲空间由RmFreeSpaceMap记录
+    int bitmap_size;               // bitmap大小
+    /**
+     * 变长字段个数, 为0时每个slot存放一条定长的记录; 否则使用slotted page格式, 记录中的变长字段按实际长度存放.
+     * 旧版本的文件头中没有这两项, 读出时为0
+     */
+    int num_var_fields;
+    RmVarField var_fields[RM_MAX_VAR_FIELDS];  // 按offset排序
 };
 
 // record page header（RmFileHandle::create_page函数进行初始化）
 struct RmPageHdr {
-    int next_free_page_no;  // 当前page满了之后，下一个可用的page no（初始化为-1）
+    int next_free_page_no;  // 不再使用, 空闲页链表已由RmFreeSpaceMap代替
     int num_records;        // 当前page中当前分配的record个数（初始化为0）
 };
 
+/**
+ * @brief slotted page格式的页面中紧跟RmPageHdr的部分
+ * @note 页面布局: RmPageHdr, RmSlottedPageHdr, bitmap, slot目录(num_slots个RmSlot, 向后增长), 空闲空间,
+ * 元组数据(从页面末尾向前增长). bitmap中的位表示slot中是否有一条记录, 与定长格式相同, 顺序扫描时只读bitmap
+ */
+struct RmSlottedPageHdr {
+    int num_slots;     // slot目录的长度, 末尾的空slot在删除时回收
+    int data_begin;    // 元组数据区的起始偏移量, 初始化为PAGE_SIZE
+    int used_bytes;    // 所有元组占用的字节数, 删除或缩短元组留下的空洞不计入, 空间不足时整理页面
+};
+
+// slot目录中的一项
+struct RmSlot {
+    uint16_t offset;       // 元组在页面中的偏移量, 为0表示slot未使用
+    uint16_t size : 14;    // 元组的字节数
+    uint16_t forward : 1;  // 记录更新后变长, 本页面放不下, 元组存放在其他页面, 这里存放的是它的Rid
+    uint16_t moved : 1;    // 这里存放的是其他页面中forward记录的元组, 不是一条独立的记录, bitmap中对应的位为0
+};
+static_assert(sizeof(RmSlot) == 4 && PAGE_SIZE < (1 << 14), "RmSlot must address every byte of a page");
+
+// slotted page中每个元组至少占用的字节数, 保证记录移到其他页面时原位置放得下转发的Rid
+constexpr int RM_MIN_TUPLE_SIZE = sizeof(Rid);
+
 // 类似于Tuple
 struct RmRecord {
     char *data;  // data初始化分配size个字节的空间
@@ -1,4 +1,8 @@
 #include "rm_file_handle.h"
+
+#include <algorithm>
+#include <limits>
+
 #define DEBUG 0
 int ONCE = 0;
 /**
@@ -11,38 +15,58 @@ std::unique_ptr<RmRecord> RmFileHandle::get_record(const Rid &rid, Context *cont
     // Todo:
     // 1. 获取指定记录所在的page handle
     // 2. 初始化一个指向RmRecord的指针（赋值其内部的data和size）
-    if(RmFileHandle::is_record(rid)) {
-        RmPageHandle page_handle = fetch_page_handle(rid.page_no);
-        return std::unique_ptr<RmRecord>(new RmRecord({file_hdr_.record_size, page_handle.get_slot(rid.slot_no)}));
+    // 记录数据会被复制到RmRecord中, 因此复制后即可解除固定
+    if(is_slotted()) return get_slotted_record(rid);
+    RmPageHandle page_handle = fetch_page_handle(rid.page_no);
+    if(!Bitmap::is_set(page_handle.bitmap, rid.slot_no)) {
+        buffer_pool_manager_->UnpinPage(page_handle.page->GetPageId(), false);
+        throw RecordNotFoundError(rid.page_no, rid.slot_no);
     }
-    return std::unique_ptr<RmRecord>(new RmRecord({file_hdr_.record_size, nullptr}));
+    auto record = std::make_unique<RmRecord>(file_hdr_.record_size, page_handle.get_slot(rid.slot_no));
+    buffer_pool_manager_->UnpinPage(page_handle.page->GetPageId(), false);
+    return record;
 }
 
 /**
- * @brief 在该记录文件（RmFileHandle）中插入一条记录
+ * @brief 由Rid得到记录的只读视图, 视图存在期间记录所在的页面保持固定
  *
- * @param buf 要插入的数据的地址
- * @return Rid 插入记录的位置
+ * @param strategy 缓冲区访问策略, 顺序扫描时与RmScan使用同一个
+ * @note 定长格式中不分配内存也不复制记录
  */
+RmRecordView RmFileHandle::get_record_view(const Rid &rid, BufferAccessStrategy *strategy) const {
+    if (is_slotted()) return RmRecordView(get_slotted_record(rid));
+    RmPageHandle page_handle = fetch_page_handle(rid.page_no, strategy);
+    if (!Bitmap::is_set(page_handle.bitmap, rid.slot_no)) {
+        buffer_pool_manager_->UnpinPage(page_handle.page->GetPageId(), false);
+        throw RecordNotFoundError(rid.page_no, rid.slot_no);
+    }
+    return RmRecordView(buffer_pool_manager_, page_handle.page, page_handle.get_slot(rid.slot_no),
+                        file_hdr_.record_size);
+}
+
 Rid RmFileHandle::insert_record(char *buf, Context *context) {
+    check_writable();
+    load_free_space_map();
     // Todo:
     // 1. 获取当前未满的page handle
     // 2. 在page handle中找到空闲slot位置
     // 3. 将buf复制到空闲slot位置
     // 4. 更新page_handle.page_hdr中的数据结构
-    // 注意考虑插入一条记录后页面已满的情况，需要更新file_hdr_.first_free_page_no
+    // 注意考虑插入一条记录后页面已满的情况，需要更新空闲空间映射
     if(!(--ONCE)) std::cout<<"max_record_size:"<<file_hdr_.num_records_per_page<<std::endl;
-    RmPageHandle page_handle = create_page_handle();
-    int new_slot_no = Bitmap::first_bit(0, page_handle.bitmap, file_hdr_.num_records_per_page);
+    if(is_slotted()) return insert_slotted_record(buf);
+    std::shared_lock<std::shared_mutex> lock(pages_latch_);
+    int new_slot_no;
+    RmPageHandle page_handle = create_page_handle(file_hdr_.record_size, &new_slot_no);
     Bitmap::set(page_handle.bitmap, new_slot_no);
     memcpy(page_handle.get_slot(new_slot_no), buf, file_hdr_.record_size);
     page_handle.page_hdr->num_records++;
     if(DEBUG) std::cout<<"insert_record: "<<page_handle.page_hdr->num_records<<" in "<<page_handle.page->GetPageId().page_no<<std::endl;
-    if(page_handle.page_hdr->num_records == file_hdr_.num_records_per_page)
-        file_hdr_.first_free_page_no = page_handle.page_hdr->next_free_page_no;
+    update_free_space(page_handle);
+    Rid rid{page_handle.page->GetPageId().page_no, new_slot_no};
+    page_handle.page->WUnlatch();
     buffer_pool_manager_->UnpinPage(page_handle.page->GetPageId(), true);
-    if(DEBUG) std::cout<<"here: "<<new_slot_no<<" in "<<page_handle.page->GetPageId().page_no<<std::endl;
-    return Rid{page_handle.page->GetPageId().page_no, new_slot_no};
+    return rid;
 }
 
 /**
@@ -51,17 +75,27 @@ Rid RmFileHandle::insert_record(char *buf, Context *context) {
  * @param rid 要删除的记录所在的指定位置
  */
 void RmFileHandle::delete_record(const Rid &rid, Context *context) {
+    check_writable();
+    load_free_space_map();
     // Todo:
     // 1. 获取指定记录所在的page handle
     // 2. 更新page_handle.page_hdr中的数据结构
-    // 注意考虑删除一条记录后页面未满的情况，需要调用release_page_handle()
-    RmPageHandle page_handle = fetch_page_handle(rid.page_no);
-    Bitmap::reset(page_handle.bitmap, rid.slot_no);
-    page_handle.page_hdr->num_records--;
-    if(DEBUG) std::cout<<"del: "<<page_handle.page->GetPageId().page_no<<std::endl;
-    if(page_handle.page_hdr->num_records + 1 == file_hdr_.num_records_per_page)
-        release_page_handle(page_handle);
-    buffer_pool_manager_->UnpinPage(page_handle.page->GetPageId(), true);
+    // 注意考虑删除一条记录后页面未满的情况，需要更新空闲空间映射
+    if(is_slotted()) return delete_slotted_record(rid);
+    bool page_empty;
+    {
+        std::shared_lock<std::shared_mutex> lock(pages_latch_);
+        RmPageHandle page_handle = fetch_page_handle(rid.page_no);
+        page_handle.page->WLatch();
+        Bitmap::reset(page_handle.bitmap, rid.slot_no);
+        page_handle.page_hdr->num_records--;
+        if(DEBUG) std::cout<<"del: "<<page_handle.page->GetPageId().page_no<<std::endl;
+        update_free_space(page_handle);
+        page_empty = page_handle.page_hdr->num_records == 0;
+        page_handle.page->WUnlatch();
+        buffer_pool_manager_->UnpinPage(page_handle.page->GetPageId(), true);
+    }
+    if(page_empty) release_trailing_pages();
 }
 
 /**
@@ -71,29 +105,44 @@ void RmFileHandle::delete_record(const Rid &rid, Context *context) {
  * @param buf 新记录的数据的地址
  */
 void RmFileHandle::update_record(const Rid &rid, char *buf, Context *context) {
+    check_writable();
+    load_free_space_map();
     // Todo:
     // 1. 获取指定记录所在的page handle
     // 2. 更新记录
+    if(is_slotted()) return update_slotted_record(rid, buf);
+    std::shared_lock<std::shared_mutex> lock(pages_latch_);
     RmPageHandle page_handle = fetch_page_handle(rid.page_no);
+    page_handle.page->WLatch();
     memcpy(page_handle.get_slot(rid.slot_no), buf, file_hdr_.record_size);
     if(DEBUG) std::cout<<"update:"<<rid.slot_no<<" in "<<rid.page_no<<std::endl;
+    page_handle.page->WUnlatch();
     buffer_pool_manager_->UnpinPage(page_handle.page->GetPageId(), true);
 }
 
 /** -- 以下为辅助函数 -- */
+/**
+ * @brief 只读打开的文件中的页面直接指向文件的内存映射, 不能修改
+ * @throw FileReadOnlyError
+ */
+void RmFileHandle::check_writable() const {
+    if (disk_manager_->is_read_only(fd_)) throw FileReadOnlyError(disk_manager_->GetFileName(fd_));
+}
+
 /**
  * @brief 获取指定页面编号的page handle
  *
  * @param page_no 要获取的页面编号
+ * @param strategy 缓冲区访问策略, 大表顺序扫描时传入以免挤出缓冲池中的其他页面
  * @return RmPageHandle 返回给上层的page_handle
  * @note pin the page, remember to unpin it outside!
  */
-RmPageHandle RmFileHandle::fetch_page_handle(int page_no) const {
+RmPageHandle RmFileHandle::fetch_page_handle(int page_no, BufferAccessStrategy *strategy) const {
     // Todo:
     // 使用缓冲池获取指定页面，并生成page_handle返回给上层
     // if page_no is invalid, throw PageNotExistError exception
     if(page_no == INVALID_PAGE_ID) throw(PageNotExistError("hhh",page_no));
-    Page* page = buffer_pool_manager_->FetchPage(PageId{fd_, page_no});
+    Page* page = buffer_pool_manager_->FetchPage(PageId{fd_, page_no}, strategy);
     //if(DEBUG) std::cout<<"fetch: "<<page->GetPageId().page_no<<std::endl;
     return RmPageHandle(&file_hdr_, page);
 }
@@ -101,71 +150,521 @@ RmPageHandle RmFileHandle::fetch_page_handle(int page_no) const {
 /**
  * @brief 创建一个新的page handle
  *
- * @return RmPageHandle
+ * @return RmPageHandle 已加写锁, 空闲空间映射中的等级为0, 调用者插入后调用update_free_space
+ * @note pin the page and latch it, remember to unlatch and unpin it outside!
  */
 RmPageHandle RmFileHandle::create_new_page_handle() {
     // Todo:
     // 1.使用缓冲池来创建一个新page
     // 2.更新page handle中的相关信息
     // 3.更新file_hdr_
-    Page* new_page = buffer_pool_manager_->NewPage(new PageId({fd_}));
+    std::scoped_lock lock{alloc_latch_};
+    PageId page_id = {.fd = fd_, .page_no = INVALID_PAGE_ID};
+    Page* new_page = buffer_pool_manager_->NewPage(&page_id);
+    new_page->WLatch();
     RmPageHandle new_page_handle = RmPageHandle(&file_hdr_, new_page);
-    new_page_handle.page_hdr->next_free_page_no = file_hdr_.first_free_page_no;
-    file_hdr_.first_free_page_no = new_page->GetPageId().page_no;
-    if(DEBUG) std::cout<<"create: "<<file_hdr_.first_free_page_no<<"->"<<new_page_handle.page_hdr->next_free_page_no<<std::endl;
+    new_page_handle.page_hdr->next_free_page_no = RM_NO_PAGE;
     new_page_handle.page_hdr->num_records = 0;
+    if(DEBUG) std::cout<<"create: "<<page_id.page_no<<std::endl;
     file_hdr_.num_pages++;
+    fsm_.resize(file_hdr_.num_pages);
     Bitmap::init(new_page_handle.bitmap, file_hdr_.bitmap_size);
+    if(is_slotted()) {
+        *new_page_handle.slotted_hdr = RmSlottedPageHdr{.num_slots = 0, .data_begin = PAGE_SIZE, .used_bytes = 0};
+    }
     return new_page_handle;
 }
 
 /**
- * @brief 创建或获取一个空闲的page handle
+ * @brief 获取一个放得下size字节记录的page handle
  *
- * @return RmPageHandle 返回生成的空闲page handle
- * @note pin the page, remember to unpin it outside!
+ * @param[out] slot_no 页面中存放记录的slot
+ * @return RmPageHandle 已加写锁
+ * @note 从上一次插入的页面开始按空闲空间映射查找, 被其他线程锁住的页面直接跳过,
+ * 并发的插入因此分散到不同的页面; 都放不下时创建新页面. pin the page and latch it, remember to unlatch and unpin it outside!
  */
-RmPageHandle RmFileHandle::create_page_handle() {
+RmPageHandle RmFileHandle::create_page_handle(int size, int *slot_no) {
     // Todo:
-    // 1. 判断file_hdr_中是否还有空闲页
+    // 1. 判断是否还有空闲页
     //     1.1 没有空闲页：使用缓冲池来创建一个新page；可直接调用create_new_page_handle()
-    //     1.2 有空闲页：直接获取第一个空闲页
+    //     1.2 有空闲页：获取空闲页
     // 2. 生成page handle并返回给上层
-    if(file_hdr_.first_free_page_no == -1)
-        return create_new_page_handle();
-    return fetch_page_handle(file_hdr_.first_free_page_no);
+    int min_category = RmFreeSpaceMap::category(page_space_needed(size), page_capacity());
+    page_id_t hint = insert_hint_.load(std::memory_order_relaxed);
+    for (int pass = 0; pass < 2; pass++) {
+        page_id_t begin = pass == 0 ? hint : RM_FIRST_RECORD_PAGE;
+        page_id_t end = pass == 0 ? std::numeric_limits<page_id_t>::max() : hint;
+        for (page_id_t page_no = fsm_.find(min_category, begin, end); page_no != INVALID_PAGE_ID;
+             page_no = fsm_.find(min_category, page_no + 1, end)) {
+            RmPageHandle page_handle = fetch_page_handle(page_no);
+            if (page_handle.page->TryWLatch()) {
+                *slot_no = find_free_slot(page_handle, size);
+                if (*slot_no >= 0) {
+                    insert_hint_.store(page_no, std::memory_order_relaxed);
+                    return page_handle;
+                }
+                // 映射中的等级只是近似值: 页面放不下时将等级降到min_category以下, 同样大小的插入不再尝试该页面
+                fsm_.set(page_no, std::min(fsm_.get(page_no), min_category - 1));
+                page_handle.page->WUnlatch();
+            }
+            buffer_pool_manager_->UnpinPage(page_handle.page->GetPageId(), false);
+        }
+    }
+    RmPageHandle page_handle = create_new_page_handle();
+    *slot_no = find_free_slot(page_handle, size);
+    insert_hint_.store(page_handle.page->GetPageId().page_no, std::memory_order_relaxed);
+    return page_handle;
 }
 
 /**
- * @brief 当page handle中的page从已满变成未满的时候调用
- *
- * @param page_handle
- * @note only used in delete_record()
+ * @brief 页面中存放size字节的记录的slot
+ * @return slot_no, 页面放不下时返回-1; 定长格式中size就是record_size
  */
-void RmFileHandle::release_page_handle(RmPageHandle &page_handle) {
-    // Todo:
-    // 当page从已满变成未满，考虑如何更新：
-    // 1. page_handle.page_hdr->next_free_page_no
-    // 2. file_hdr_.first_free_page_no
-    page_handle.page_hdr->next_free_page_no = file_hdr_.first_free_page_no;
-    file_hdr_.first_free_page_no = page_handle.page->GetPageId().page_no;
-    if(DEBUG) std::cout<<"release: "<<file_hdr_.first_free_page_no<<std::endl;
+int RmFileHandle::find_free_slot(const RmPageHandle &page_handle, int size) const {
+    int max_n = file_hdr_.num_records_per_page;
+    if (page_handle.page_hdr->num_records == max_n) return -1;
+    if (!is_slotted()) return Bitmap::first_bit(false, page_handle.bitmap, max_n);
+    // bitmap中为0的slot可能存放着其他页面的元组, 没有未使用的slot时在目录末尾增加一个
+    int num_slots = page_handle.slotted_hdr->num_slots;
+    int slot_no = Bitmap::first_bit(false, page_handle.bitmap, num_slots);
+    while (slot_no < num_slots && page_handle.get_slot_entry(slot_no)->offset != 0) {
+        slot_no = Bitmap::next_bit(false, page_handle.bitmap, num_slots, slot_no);
+    }
+    int need = size + (slot_no == num_slots ? static_cast<int>(sizeof(RmSlot)) : 0);
+    return slot_no < max_n && page_handle.get_free_space() >= need ? slot_no : -1;
+}
+
+/** @return 空闲空间映射使用的页面容量: 定长格式中为slot数, slotted page格式中为可存放slot目录和元组的字节数 */
+int RmFileHandle::page_capacity() const {
+    if (!is_slotted()) return file_hdr_.num_records_per_page;
+    return PAGE_SIZE - Page::OFFSET_PAGE_HDR - static_cast<int>(sizeof(RmPageHdr) + sizeof(RmSlottedPageHdr)) -
+           file_hdr_.bitmap_size;
+}
+
+/** @return 插入size字节的记录需要的空闲空间, 单位与page_capacity相同 */
+int RmFileHandle::page_space_needed(int size) const {
+    return is_slotted() ? size + static_cast<int>(sizeof(RmSlot)) : 1;
+}
+
+/**
+ * @brief 按页面当前的空闲空间更新空闲空间映射, 调用者持有页面的写锁
+ */
+void RmFileHandle::update_free_space(const RmPageHandle &page_handle) {
+    int free = file_hdr_.num_records_per_page - page_handle.page_hdr->num_records;
+    if (is_slotted() && free > 0) free = page_handle.get_free_space();
+    fsm_.set(page_handle.page->GetPageId().page_no, RmFreeSpaceMap::category(free, page_capacity()));
+}
+
+/**
+ * @brief 将文件末尾连续的空页面归还给DiskManager, 减小file_hdr_.num_pages, 顺序扫描不再读取这些页面
+ * @note 在删除记录清空一个页面后调用, 持有pages_latch_的写锁, 期间没有其他线程修改页面; 仍被固定的页面不释放
+ */
+void RmFileHandle::release_trailing_pages() {
+    std::unique_lock<std::shared_mutex> pages_lock(pages_latch_);
+    std::scoped_lock alloc_lock{alloc_latch_};
+    page_id_t num_pages = file_hdr_.num_pages;
+    while (num_pages > RM_FIRST_RECORD_PAGE) {
+        RmPageHandle page_handle = fetch_page_handle(num_pages - 1);
+        int num_records = page_handle.page_hdr->num_records;
+        buffer_pool_manager_->UnpinPage(page_handle.page->GetPageId(), false);
+        if (num_records > 0 || !buffer_pool_manager_->DeletePage(PageId{fd_, num_pages - 1})) break;
+        num_pages--;
+    }
+    if (num_pages == file_hdr_.num_pages) return;
+    file_hdr_.num_pages = num_pages;
+    fsm_.resize(num_pages);
+}
+
+/**
+ * @brief 第一次修改记录前读入关闭文件时写出的空闲空间映射, 读入后删除附属文件
+ * @note 附属文件只在正常关闭时写入; 不存在或已过时(例如崩溃后)时读取所有页面重建映射.
+ * 只读取记录的文件不需要映射, 打开文件时不读入
+ */
+void RmFileHandle::load_free_space_map() {
+    std::call_once(fsm_loaded_, [this]() {
+        std::string path = disk_manager_->GetFileName(fd_) + RmFreeSpaceMap::FSM_SUFFIX;
+        bool loaded = false;
+        if (disk_manager_->is_file(path)) {
+            loaded = fsm_.load(path, file_hdr_.num_pages);
+            disk_manager_->destroy_file(path);
+        }
+        if (!loaded) {
+            fsm_.resize(file_hdr_.num_pages);
+            for (page_id_t page_no = RM_FIRST_RECORD_PAGE; page_no < file_hdr_.num_pages; page_no++) {
+                RmPageHandle page_handle = fetch_page_handle(page_no);
+                update_free_space(page_handle);
+                buffer_pool_manager_->UnpinPage(page_handle.page->GetPageId(), false);
+            }
+        }
+        fsm_valid_ = true;
+    });
+}
+
+/**
+ * @brief 关闭文件时将空闲空间映射写入附属文件; 映射未读入时附属文件保持不变
+ */
+void RmFileHandle::save_free_space_map() const {
+    if (!fsm_valid_) return;
+    fsm_.save(disk_manager_->GetFileName(fd_) + RmFreeSpaceMap::FSM_SUFFIX);
 }
 
 // used for recovery (lab4)
 void RmFileHandle::insert_record(const Rid &rid, char *buf) {
-    if (rid.page_no < file_hdr_.num_pages) {
-        create_new_page_handle();
+    check_writable();
+    load_free_space_map();
+    if (is_slotted()) return insert_slotted_record(rid, buf);
+    std::shared_lock<std::shared_mutex> lock(pages_latch_);
+    while (rid.page_no >= file_hdr_.num_pages) {
+        RmPageHandle page_handle = create_new_page_handle();
+        update_free_space(page_handle);
+        page_handle.page->WUnlatch();
+        buffer_pool_manager_->UnpinPage(page_handle.page->GetPageId(), true);
     }
     RmPageHandle pageHandle = fetch_page_handle(rid.page_no);
-    Bitmap::set(pageHandle.bitmap, rid.slot_no);
-    pageHandle.page_hdr->num_records++;
-    if (pageHandle.page_hdr->num_records == file_hdr_.num_records_per_page) {
-        file_hdr_.first_free_page_no = pageHandle.page_hdr->next_free_page_no;
+    pageHandle.page->WLatch();
+    if (!Bitmap::is_set(pageHandle.bitmap, rid.slot_no)) {
+        Bitmap::set(pageHandle.bitmap, rid.slot_no);
+        pageHandle.page_hdr->num_records++;
     }
 
     char *slot = pageHandle.get_slot(rid.slot_no);
     memcpy(slot, buf, file_hdr_.record_size);
 
+    update_free_space(pageHandle);
+    pageHandle.page->WUnlatch();
     buffer_pool_manager_->UnpinPage(pageHandle.page->GetPageId(), true);
-}
\ No newline at end of file
+}
+
+/** -- 以下为slotted page格式的实现 -- */
+/**
+ * @brief 将定长的记录编码为元组: 各变长字段的实际长度(uint16_t), 定长字段, 各变长字段的内容
+ * @param tuple 至少PAGE_SIZE字节
+ * @return 元组的字节数, 不足RM_MIN_TUPLE_SIZE时补0
+ */
+int RmFileHandle::encode_tuple(const char *buf, char *tuple) const {
+    int num_fields = file_hdr_.num_var_fields;
+    char *dst = tuple + num_fields * sizeof(uint16_t);
+    int pos = 0;
+    for (int i = 0; i < num_fields; i++) {
+        const RmVarField &field = file_hdr_.var_fields[i];
+        memcpy(dst, buf + pos, field.offset - pos);
+        dst += field.offset - pos;
+        pos = field.offset + field.len;
+    }
+    memcpy(dst, buf + pos, file_hdr_.record_size - pos);
+    dst += file_hdr_.record_size - pos;
+    for (int i = 0; i < num_fields; i++) {
+        const RmVarField &field = file_hdr_.var_fields[i];
+        auto len = static_cast<uint16_t>(strnlen(buf + field.offset, field.len));
+        memcpy(tuple + i * sizeof(uint16_t), &len, sizeof(len));
+        memcpy(dst, buf + field.offset, len);
+        dst += len;
+    }
+    int size = static_cast<int>(dst - tuple);
+    if (size < RM_MIN_TUPLE_SIZE) {
+        memset(dst, 0, RM_MIN_TUPLE_SIZE - size);
+        size = RM_MIN_TUPLE_SIZE;
+    }
+    return size;
+}
+
+/**
+ * @brief 将slot_no的元组解码为定长的记录, 变长字段之后补'\0'
+ * @note 调用者持有页面的读锁或写锁, compact_page会在写锁下移动元组
+ * @return false表示元组超出页面, 或变长字段的长度超出元组或字段的定义长度, 此时buf的内容无意义
+ */
+bool RmFileHandle::decode_tuple(const RmPageHandle &page_handle, int slot_no, char *buf) const {
+    if (slot_no < 0 || slot_no >= page_handle.slotted_hdr->num_slots) return false;
+    const RmSlot *slot = page_handle.get_slot_entry(slot_no);
+    if (slot->offset == 0 || slot->offset + slot->size > PAGE_SIZE) return false;
+    const char *tuple = page_handle.page->GetData() + slot->offset;
+    const char *end = tuple + slot->size;
+    int num_fields = file_hdr_.num_var_fields;
+    const char *src = tuple + num_fields * sizeof(uint16_t);
+    int fixed_size = file_hdr_.record_size;
+    for (int i = 0; i < num_fields; i++) fixed_size -= file_hdr_.var_fields[i].len;
+    if (src + fixed_size > end) return false;
+    int pos = 0;
+    for (int i = 0; i < num_fields; i++) {
+        const RmVarField &field = file_hdr_.var_fields[i];
+        memcpy(buf + pos, src, field.offset - pos);
+        src += field.offset - pos;
+        pos = field.offset + field.len;
+    }
+    memcpy(buf + pos, src, file_hdr_.record_size - pos);
+    src += file_hdr_.record_size - pos;
+    for (int i = 0; i < num_fields; i++) {
+        const RmVarField &field = file_hdr_.var_fields[i];
+        uint16_t len;
+        memcpy(&len, tuple + i * sizeof(uint16_t), sizeof(len));
+        if (len > field.len || src + len > end) return false;
+        memcpy(buf + field.offset, src, len);
+        memset(buf + field.offset + len, 0, field.len - len);
+        src += len;
+    }
+    return true;
+}
+
+
+/**
+ * @brief 为slot_no分配size字节的元组空间, 连续的空闲空间不足时先整理页面
+ * @param slot_no 未使用的slot, 或等于num_slots表示在目录末尾增加一个slot
+ * @return 元组的地址
+ * @note 调用者需保证get_free_space()足够
+ */
+char *RmFileHandle::alloc_tuple(RmPageHandle &page_handle, int slot_no, int size) {
+    RmSlottedPageHdr *hdr = page_handle.slotted_hdr;
+    int new_slot = slot_no == hdr->num_slots ? static_cast<int>(sizeof(RmSlot)) : 0;
+    if (hdr->data_begin - page_handle.get_slots_end() < size + new_slot) compact_page(page_handle);
+    if (new_slot > 0) hdr->num_slots++;
+    assert(hdr->data_begin - page_handle.get_slots_end() >= size);
+    hdr->data_begin -= size;
+    hdr->used_bytes += size;
+    RmSlot *slot = page_handle.get_slot_entry(slot_no);
+    *slot = RmSlot{};
+    slot->offset = static_cast<uint16_t>(hdr->data_begin);
+    slot->size = static_cast<uint16_t>(size);
+    return page_handle.page->GetData() + hdr->data_begin;
+}
+
+/**
+ * @brief 释放slot_no的元组空间; 目录末尾未使用的slot一并回收
+ * @note 元组位于数据区开头时直接归还, 否则留下空洞, 由compact_page回收
+ */
+void RmFileHandle::free_tuple(RmPageHandle &page_handle, int slot_no) {
+    RmSlottedPageHdr *hdr = page_handle.slotted_hdr;
+    RmSlot *slot = page_handle.get_slot_entry(slot_no);
+    hdr->used_bytes -= slot->size;
+    if (slot->offset == hdr->data_begin) hdr->data_begin += slot->size;
+    if (hdr->used_bytes == 0) hdr->data_begin = PAGE_SIZE;
+    *slot = RmSlot{};
+    while (hdr->num_slots > 0 && page_handle.get_slot_entry(hdr->num_slots - 1)->offset == 0 &&
+           !Bitmap::is_set(page_handle.bitmap, hdr->num_slots - 1)) {
+        hdr->num_slots--;
+    }
+}
+
+/**
+ * @brief 整理页面: 将所有元组移到页面末尾连续存放, 回收元组之间的空洞
+ */
+void RmFileHandle::compact_page(RmPageHandle &page_handle) {
+    RmSlottedPageHdr *hdr = page_handle.slotted_hdr;
+    char *data = page_handle.page->GetData();
+    char buf[PAGE_SIZE];
+    int data_begin = PAGE_SIZE;
+    for (int i = 0; i < hdr->num_slots; i++) {
+        RmSlot *slot = page_handle.get_slot_entry(i);
+        if (slot->offset == 0) continue;
+        data_begin -= slot->size;
+        memcpy(buf + data_begin, data + slot->offset, slot->size);
+        slot->offset = static_cast<uint16_t>(data_begin);
+    }
+    memcpy(data + data_begin, buf + data_begin, PAGE_SIZE - data_begin);
+    hdr->data_begin = data_begin;
+}
+
+/**
+ * @brief 在空闲空间映射中找到的第一个放得下的页面中存放元组
+ * @param moved 元组属于其他页面中的forward记录, 不在bitmap中标记
+ * @return 元组的位置
+ * @note 调用者持有pages_latch_的读锁. 更新记录时调用者持有记录所在页面的写锁, 该页面会被跳过
+ */
+Rid RmFileHandle::insert_tuple(const char *tuple, int size, bool moved) {
+    int slot_no;
+    RmPageHandle page_handle = create_page_handle(size, &slot_no);
+    memcpy(alloc_tuple(page_handle, slot_no, size), tuple, size);
+    if (moved) {
+        page_handle.get_slot_entry(slot_no)->moved = 1;
+    } else {
+        Bitmap::set(page_handle.bitmap, slot_no);
+    }
+    page_handle.page_hdr->num_records++;
+    update_free_space(page_handle);
+    Rid rid{page_handle.page->GetPageId().page_no, slot_no};
+    page_handle.page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(page_handle.page->GetPageId(), true);
+    return rid;
+}
+
+/**
+ * @brief 删除forward记录存放在其他页面中的元组
+ * @return 该页面是否成为空页面
+ */
+bool RmFileHandle::delete_moved_tuple(const Rid &rid) {
+    RmPageHandle page_handle = fetch_page_handle(rid.page_no);
+    page_handle.page->WLatch();
+    free_tuple(page_handle, rid.slot_no);
+    page_handle.page_hdr->num_records--;
+    update_free_space(page_handle);
+    bool page_empty = page_handle.page_hdr->num_records == 0;
+    page_handle.page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(page_handle.page->GetPageId(), true);
+    return page_empty;
+}
+
+/**
+ * @note 在页面的读锁下读取slot和元组; forward记录先读出转发的Rid, 释放本页面后再读其他页面中的元组
+ */
+std::unique_ptr<RmRecord> RmFileHandle::get_slotted_record(const Rid &rid) const {
+    RmPageHandle page_handle = fetch_page_handle(rid.page_no);
+    page_handle.page->RLatch();
+    if (!Bitmap::is_set(page_handle.bitmap, rid.slot_no)) {
+        page_handle.page->RUnlatch();
+        buffer_pool_manager_->UnpinPage(page_handle.page->GetPageId(), false);
+        throw RecordNotFoundError(rid.page_no, rid.slot_no);
+    }
+    auto record = std::make_unique<RmRecord>(file_hdr_.record_size);
+    const RmSlot *slot = page_handle.get_slot_entry(rid.slot_no);
+    bool forward = slot->forward;
+    bool valid = true;
+    Rid moved_rid{};
+    if (!forward) {
+        valid = decode_tuple(page_handle, rid.slot_no, record->data);
+    } else if (slot->offset == 0 || slot->offset + sizeof(Rid) > PAGE_SIZE) {
+        valid = false;
+    } else {
+        memcpy(&moved_rid, page_handle.get_slot(rid.slot_no), sizeof(Rid));
+    }
+    page_handle.page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(page_handle.page->GetPageId(), false);
+    if (!valid) throw InternalError("Corrupt slotted tuple");
+    if (!forward) return record;
+
+    RmPageHandle moved_handle = fetch_page_handle(moved_rid.page_no);
+    moved_handle.page->RLatch();
+    valid = decode_tuple(moved_handle, moved_rid.slot_no, record->data);
+    moved_handle.page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(moved_handle.page->GetPageId(), false);
+    if (!valid) throw InternalError("Corrupt slotted tuple");
+    return record;
+}
+
+Rid RmFileHandle::insert_slotted_record(char *buf) {
+    char tuple[PAGE_SIZE];
+    int size = encode_tuple(buf, tuple);
+    std::shared_lock<std::shared_mutex> lock(pages_latch_);
+    return insert_tuple(tuple, size, false);
+}
+
+void RmFileHandle::delete_slotted_record(const Rid &rid) {
+    bool page_empty;
+    {
+        std::shared_lock<std::shared_mutex> lock(pages_latch_);
+        RmPageHandle page_handle = fetch_page_handle(rid.page_no);
+        page_handle.page->WLatch();
+        if (!Bitmap::is_set(page_handle.bitmap, rid.slot_no)) {
+            page_handle.page->WUnlatch();
+            buffer_pool_manager_->UnpinPage(page_handle.page->GetPageId(), false);
+            throw RecordNotFoundError(rid.page_no, rid.slot_no);
+        }
+        bool forward = page_handle.get_slot_entry(rid.slot_no)->forward;
+        Rid moved_rid;
+        if (forward) memcpy(&moved_rid, page_handle.get_slot(rid.slot_no), sizeof(Rid));
+        Bitmap::reset(page_handle.bitmap, rid.slot_no);
+        free_tuple(page_handle, rid.slot_no);
+        page_handle.page_hdr->num_records--;
+        update_free_space(page_handle);
+        page_empty = page_handle.page_hdr->num_records == 0;
+        page_handle.page->WUnlatch();
+        buffer_pool_manager_->UnpinPage(page_handle.page->GetPageId(), true);
+        // 不同时持有两个页面的写锁
+        if (forward) page_empty |= delete_moved_tuple(moved_rid);
+    }
+    if (page_empty) release_trailing_pages();
+}
+
+/**
+ * @brief 更新记录, Rid不变
+ * @note 新元组不长于原元组时原地覆盖; 否则在本页面重新分配空间; 本页面放不下时元组存放到其他页面,
+ * 原位置改为存放转发的Rid(forward). 已经forward的记录更新时先按同样的方式存放, 再删除其他页面中的原元组
+ */
+void RmFileHandle::update_slotted_record(const Rid &rid, char *buf) {
+    char tuple[PAGE_SIZE];
+    int size = encode_tuple(buf, tuple);
+    bool page_empty = false;
+    {
+        std::shared_lock<std::shared_mutex> lock(pages_latch_);
+        RmPageHandle page_handle = fetch_page_handle(rid.page_no);
+        page_handle.page->WLatch();
+        if (!Bitmap::is_set(page_handle.bitmap, rid.slot_no)) {
+            page_handle.page->WUnlatch();
+            buffer_pool_manager_->UnpinPage(page_handle.page->GetPageId(), false);
+            throw RecordNotFoundError(rid.page_no, rid.slot_no);
+        }
+        RmSlot *slot = page_handle.get_slot_entry(rid.slot_no);
+        bool forward = slot->forward;
+        Rid old_moved_rid;
+        if (forward) {
+            memcpy(&old_moved_rid, page_handle.get_slot(rid.slot_no), sizeof(Rid));
+            free_tuple(page_handle, rid.slot_no);
+        } else if (size <= slot->size) {
+            memcpy(page_handle.get_slot(rid.slot_no), tuple, size);
+            page_handle.slotted_hdr->used_bytes -= slot->size - size;
+            slot->size = static_cast<uint16_t>(size);
+        } else {
+            free_tuple(page_handle, rid.slot_no);
+        }
+        if (page_handle.get_slot_entry(rid.slot_no)->offset == 0) {
+            if (page_handle.get_free_space() >= size) {
+                memcpy(alloc_tuple(page_handle, rid.slot_no, size), tuple, size);
+            } else {
+                // 释放的原元组至少RM_MIN_TUPLE_SIZE字节, 一定放得下转发的Rid;
+                // 本页面持有写锁, insert_tuple尝试加锁失败会跳过它
+                Rid moved_rid = insert_tuple(tuple, size, true);
+                memcpy(alloc_tuple(page_handle, rid.slot_no, sizeof(Rid)), &moved_rid, sizeof(Rid));
+                page_handle.get_slot_entry(rid.slot_no)->forward = 1;
+            }
+        }
+        update_free_space(page_handle);
+        page_handle.page->WUnlatch();
+        buffer_pool_manager_->UnpinPage(page_handle.page->GetPageId(), true);
+        if (forward) page_empty = delete_moved_tuple(old_moved_rid);
+    }
+    if (page_empty) release_trailing_pages();
+}
+
+/**
+ * @brief 在指定位置恢复一条记录, 页面放不下时与update_slotted_record一样存放到其他页面
+ * @throw InternalError 该slot已被使用, 或页面中连转发的Rid都放不下
+ */
+void RmFileHandle::insert_slotted_record(const Rid &rid, char *buf) {
+    char tuple[PAGE_SIZE];
+    int size = encode_tuple(buf, tuple);
+    std::shared_lock<std::shared_mutex> lock(pages_latch_);
+    while (rid.page_no >= file_hdr_.num_pages) {
+        RmPageHandle page_handle = create_new_page_handle();
+        update_free_space(page_handle);
+        page_handle.page->WUnlatch();
+        buffer_pool_manager_->UnpinPage(page_handle.page->GetPageId(), true);
+    }
+    RmPageHandle page_handle = fetch_page_handle(rid.page_no);
+    page_handle.page->WLatch();
+    RmSlottedPageHdr *hdr = page_handle.slotted_hdr;
+    int new_slots = std::max(rid.slot_no + 1 - hdr->num_slots, 0);
+    int free_space = page_handle.get_free_space() - new_slots * static_cast<int>(sizeof(RmSlot));
+    if ((new_slots == 0 && page_handle.get_slot_entry(rid.slot_no)->offset != 0) ||
+        free_space < std::min<int>(size, sizeof(Rid))) {
+        page_handle.page->WUnlatch();
+        buffer_pool_manager_->UnpinPage(page_handle.page->GetPageId(), false);
+        throw InternalError("RmFileHandle::insert_record: cannot restore record at slot " + std::to_string(rid.slot_no));
+    }
+    // 补齐slot目录, 之后rid.slot_no为目录中未使用的slot
+    if (new_slots > 0) {
+        if (hdr->data_begin - page_handle.get_slots_end() < new_slots * static_cast<int>(sizeof(RmSlot))) {
+            compact_page(page_handle);
+        }
+        for (int i = 0; i < new_slots; i++) *page_handle.get_slot_entry(hdr->num_slots++) = RmSlot{};
+    }
+    Bitmap::set(page_handle.bitmap, rid.slot_no);
+    page_handle.page_hdr->num_records++;
+    if (free_space >= size) {
+        memcpy(alloc_tuple(page_handle, rid.slot_no, size), tuple, size);
+    } else {
+        Rid moved_rid = insert_tuple(tuple, size, true);
+        memcpy(alloc_tuple(page_handle, rid.slot_no, sizeof(Rid)), &moved_rid, sizeof(Rid));
+        page_handle.get_slot_entry(rid.slot_no)->forward = 1;
+    }
+    update_free_space(page_handle);
+    page_handle.page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(page_handle.page->GetPageId(), true);
+}
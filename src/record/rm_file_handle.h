@@ -2,11 +2,16 @@
 
 #include <assert.h>
 
+#include <atomic>
 #include <memory>
+#include <mutex>  // NOLINT
+#include <shared_mutex>
+#include <utility>
 
 #include "bitmap.h"
 #include "common/context.h"
 #include "rm_defs.h"
+#include "rm_free_space_map.h"
 
 class RmManager;
 
@@ -15,24 +20,103 @@ struct RmPageHandle {
     const RmFileHdr *file_hdr;  // 用到了file_hdr的bitmap_size, record_size
     Page *page;                 // 指向单个page
     RmPageHdr *page_hdr;        // page->data的第一部分，指针指向首地址，长度为sizeof(RmPageHdr)
+    RmSlottedPageHdr *slotted_hdr = nullptr;  // 只在slotted page格式中存在, 紧跟page_hdr
     char *bitmap;               // page->data的第二部分，指针指向首地址，长度为file_hdr->bitmap_size
-    char *slots;  // page->data的第三部分，指针指向首地址，每个slot的长度为file_hdr->record_size
+    /**
+     * page->data的第三部分，指针指向首地址: 定长格式中每个slot的长度为file_hdr->record_size;
+     * slotted page格式中为slot目录, 每项为一个RmSlot
+     */
+    char *slots;
 
     RmPageHandle(const RmFileHdr *fhdr_, Page *page_) : file_hdr(fhdr_), page(page_) {
         page_hdr = reinterpret_cast<RmPageHdr *>(page->GetData() + page->OFFSET_PAGE_HDR);
         bitmap = page->GetData() + sizeof(RmPageHdr) + page->OFFSET_PAGE_HDR;
+        if (file_hdr->num_var_fields > 0) {
+            slotted_hdr = reinterpret_cast<RmSlottedPageHdr *>(bitmap);
+            bitmap += sizeof(RmSlottedPageHdr);
+        }
         slots = bitmap + file_hdr->bitmap_size;
     }
 
-    // 返回位于slot_no的record的地址
+    // 返回位于slot_no的record的地址; slotted page格式中为元组的地址
     char *get_slot(int slot_no) const {
+        if (slotted_hdr != nullptr) return page->GetData() + get_slot_entry(slot_no)->offset;
         return slots + slot_no * file_hdr->record_size;  // slots的首地址 + slot个数 * 每个slot的大小(每个record的大小)
     }
+
+    // slotted page格式中slot目录的第slot_no项
+    RmSlot *get_slot_entry(int slot_no) const { return reinterpret_cast<RmSlot *>(slots) + slot_no; }
+
+    // slotted page格式中slot目录的末尾在页面中的偏移量
+    int get_slots_end() const {
+        return static_cast<int>(slots - page->GetData()) + slotted_hdr->num_slots * static_cast<int>(sizeof(RmSlot));
+    }
+
+    // slotted page格式中可用于存放元组的字节数, 包括空洞
+    int get_free_space() const { return PAGE_SIZE - get_slots_end() - slotted_hdr->used_bytes; }
+};
+
+/**
+ * @brief 记录的只读视图, 直接指向缓冲池页面中的记录并固定(pin)该页面, 析构或reset时解除固定
+ * @note 避免get_record的堆分配和复制; 记录需要在解除固定后继续使用时调用to_record复制.
+ * slotted page格式中记录需要解码, 视图持有解码后的副本, 不固定页面
+ */
+class RmRecordView {
+   public:
+    RmRecordView() = default;
+
+    RmRecordView(BufferPoolManager *buffer_pool_manager, Page *page, const char *data, int size)
+        : buffer_pool_manager_(buffer_pool_manager), page_(page), data_(data), size_(size) {}
+
+    explicit RmRecordView(std::unique_ptr<RmRecord> record)
+        : data_(record->data), size_(record->size), owned_(std::move(record)) {}
+
+    RmRecordView(RmRecordView &&other) noexcept { *this = std::move(other); }
+
+    RmRecordView &operator=(RmRecordView &&other) noexcept {
+        if (this != &other) {
+            reset();
+            buffer_pool_manager_ = other.buffer_pool_manager_;
+            page_ = std::exchange(other.page_, nullptr);
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = other.size_;
+            owned_ = std::move(other.owned_);
+        }
+        return *this;
+    }
+
+    ~RmRecordView() { reset(); }
+
+    DISALLOW_COPY(RmRecordView);
+
+    const char *data() const { return data_; }
+
+    int size() const { return size_; }
+
+    bool empty() const { return data_ == nullptr; }
+
+    // 复制出一条独立于页面的记录
+    std::unique_ptr<RmRecord> to_record() const { return std::make_unique<RmRecord>(size_, const_cast<char *>(data_)); }
+
+    void reset() {
+        if (page_ != nullptr) buffer_pool_manager_->UnpinPage(page_->GetPageId(), false);
+        page_ = nullptr;
+        data_ = nullptr;
+        owned_.reset();
+    }
+
+   private:
+    BufferPoolManager *buffer_pool_manager_ = nullptr;
+    Page *page_ = nullptr;  // 被固定的页面, 视图持有副本时为nullptr
+    const char *data_ = nullptr;
+    int size_ = 0;
+    std::unique_ptr<RmRecord> owned_;
 };
 
 // 每个RmFileHandle对应一个文件，里面有多个page，每个page的数据封装在RmPageHandle
 class RmFileHandle {      // TableHeap
     friend class RmScan;  // TableIterator
+    friend class RmScanBatch;
     friend class RmManager;
 
    private:
@@ -41,9 +125,19 @@ class RmFileHandle {      // TableHeap
     int fd_;
     /** @brief file_hdr中的num_pages记录此文件分配的page个数
      * page_no范围为[0,file_hdr.num_pages)，page_no从0开始增加，其中第0页存file_hdr，从第1页开始存page_handle
-     * 在page_handle中有page_hdr.free_page_no存第一个可用(未满)的page_no
+     * 各页面的空闲空间记录在fsm_中
      * */
-    RmFileHdr file_hdr_;
+    RmFileHdr file_hdr_{};
+    RmFreeSpaceMap fsm_;
+    std::once_flag fsm_loaded_;  // 第一次修改记录时读入fsm_
+    bool fsm_valid_ = false;
+    std::atomic<page_id_t> insert_hint_{RM_FIRST_RECORD_PAGE};  // 上一次插入的页面, 查找空闲页面的起点
+    std::mutex alloc_latch_;  // 保护创建新页面时file_hdr_.num_pages的增长
+    /**
+     * 修改记录时持有读锁, 各线程之间由页面的写锁互斥; release_trailing_pages持有写锁,
+     * 期间没有其他线程访问将被释放的页面. RmScan读取num_pages并固定页面时也持有读锁
+     */
+    mutable std::shared_mutex pages_latch_;
 
    public:
     RmFileHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd)
@@ -65,11 +159,15 @@ class RmFileHandle {      // TableHeap
 
     bool is_record(const Rid &rid) const {
         RmPageHandle page_handle = fetch_page_handle(rid.page_no);
-        return Bitmap::is_set(page_handle.bitmap, rid.slot_no);  // page的slot_no位置上是否有record
+        bool exist = Bitmap::is_set(page_handle.bitmap, rid.slot_no);  // page的slot_no位置上是否有record
+        buffer_pool_manager_->UnpinPage(page_handle.page->GetPageId(), false);
+        return exist;
     }
 
     std::unique_ptr<RmRecord> get_record(const Rid &rid, Context *context) const;
 
+    RmRecordView get_record_view(const Rid &rid, BufferAccessStrategy *strategy = nullptr) const;
+
     Rid insert_record(char *buf, Context *context);
 
     void insert_record(const Rid &rid, char *buf);
@@ -78,12 +176,54 @@ class RmFileHandle {      // TableHeap
 
     void update_record(const Rid &rid, char *buf, Context *context);
 
+    RmPageHandle fetch_page_handle(int page_no, BufferAccessStrategy *strategy = nullptr) const;
+
+   private:
     RmPageHandle create_new_page_handle();
 
-    RmPageHandle fetch_page_handle(int page_no) const;
+    RmPageHandle create_page_handle(int size, int *slot_no);
 
-   private:
-    RmPageHandle create_page_handle();
+    int find_free_slot(const RmPageHandle &page_handle, int size) const;
+
+    int page_capacity() const;
+
+    int page_space_needed(int size) const;
+
+    void update_free_space(const RmPageHandle &page_handle);
+
+    void release_trailing_pages();
+
+    void load_free_space_map();
+
+    void save_free_space_map() const;
+
+    void check_writable() const;
+
+    // 以下为slotted page格式(file_hdr_.num_var_fields > 0)使用的辅助函数
+
+    bool is_slotted() const { return file_hdr_.num_var_fields > 0; }
+
+    int encode_tuple(const char *buf, char *tuple) const;
+
+    bool decode_tuple(const RmPageHandle &page_handle, int slot_no, char *buf) const;
+
+    char *alloc_tuple(RmPageHandle &page_handle, int slot_no, int size);
+
+    void free_tuple(RmPageHandle &page_handle, int slot_no);
+
+    void compact_page(RmPageHandle &page_handle);
+
+    Rid insert_tuple(const char *tuple, int size, bool moved);
+
+    bool delete_moved_tuple(const Rid &rid);
+
+    std::unique_ptr<RmRecord> get_slotted_record(const Rid &rid) const;
+
+    Rid insert_slotted_record(char *buf);
+
+    void delete_slotted_record(const Rid &rid);
+
+    void update_slotted_record(const Rid &rid, char *buf);
 
-    void release_page_handle(RmPageHandle &page_handle);
+    void insert_slotted_record(const Rid &rid, char *buf);
 };
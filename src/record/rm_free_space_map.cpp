@@ -0,0 +1,77 @@
+#include "rm_free_space_map.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+int RmFreeSpaceMap::get(page_id_t page_no) const {
+    std::scoped_lock lock{latch_};
+    if (page_no < 0 || page_no >= num_pages_) return 0;
+    return (bytes_[page_no / 2] >> (page_no % 2 * BITS_PER_PAGE)) & MAX_CATEGORY;
+}
+
+void RmFreeSpaceMap::set(page_id_t page_no, int category) {
+    std::scoped_lock lock{latch_};
+    if (page_no < 0 || page_no >= num_pages_) return;
+    int shift = page_no % 2 * BITS_PER_PAGE;
+    uint8_t &byte = bytes_[page_no / 2];
+    byte = static_cast<uint8_t>((byte & ~(MAX_CATEGORY << shift)) | (category << shift));
+}
+
+void RmFreeSpaceMap::resize(page_id_t num_pages) {
+    std::scoped_lock lock{latch_};
+    bytes_.resize((num_pages + 1) / 2, 0);
+    // 丢弃的奇数页面与保留的页面共用最后一个字节
+    if (num_pages < num_pages_ && num_pages % 2 == 1) bytes_.back() &= MAX_CATEGORY;
+    num_pages_ = num_pages;
+}
+
+page_id_t RmFreeSpaceMap::num_pages() const {
+    std::scoped_lock lock{latch_};
+    return num_pages_;
+}
+
+/**
+ * @note 找非满页面(min_category为1)时一次跳过8个字节全为0的16个页面
+ */
+page_id_t RmFreeSpaceMap::find(int min_category, page_id_t begin, page_id_t end) const {
+    std::scoped_lock lock{latch_};
+    end = std::min(end, num_pages_);
+    page_id_t page_no = std::max(begin, 0);
+    while (page_no < end) {
+        if (min_category <= 1 && page_no % 16 == 0 && page_no + 16 <= end) {
+            uint64_t word;
+            memcpy(&word, &bytes_[page_no / 2], sizeof(word));
+            if (word == 0) {
+                page_no += 16;
+                continue;
+            }
+        }
+        if (((bytes_[page_no / 2] >> (page_no % 2 * BITS_PER_PAGE)) & MAX_CATEGORY) >= min_category) {
+            return page_no;
+        }
+        page_no++;
+    }
+    return INVALID_PAGE_ID;
+}
+
+bool RmFreeSpaceMap::load(const std::string &path, page_id_t num_pages) {
+    std::ifstream in(path, std::ios::binary);
+    page_id_t saved_pages = INVALID_PAGE_ID;
+    if (!in.read(reinterpret_cast<char *>(&saved_pages), sizeof(saved_pages)) || saved_pages != num_pages) {
+        return false;
+    }
+    std::vector<uint8_t> bytes((num_pages + 1) / 2);
+    if (!in.read(reinterpret_cast<char *>(bytes.data()), bytes.size())) return false;
+    std::scoped_lock lock{latch_};
+    bytes_ = std::move(bytes);
+    num_pages_ = num_pages;
+    return true;
+}
+
+void RmFreeSpaceMap::save(const std::string &path) const {
+    std::scoped_lock lock{latch_};
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char *>(&num_pages_), sizeof(num_pages_));
+    out.write(reinterpret_cast<const char *>(bytes_.data()), bytes_.size());
+}
@@ -0,0 +1,69 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Rucbase
+//
+// rm_free_space_map.h
+//
+// Identification: src/record/rm_free_space_map.h
+//
+// Copyright (c) 2022, RUC Deke Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>  // NOLINT
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "defs.h"
+
+/**
+ * @brief 记录文件的空闲空间映射: 每个页面用4位记录空闲空间的等级
+ * @note 等级为空闲空间占页面容量的比例向上取整到[0, MAX_CATEGORY], 只有页面已满时为0.
+ * 插入时按等级查找放得下的页面, 删除时只需更新页面的等级, 不必维护空闲页链表.
+ * 映射只是近似值, 使用者在页面上确认后再插入, 发现不符时用set修正
+ */
+class RmFreeSpaceMap {
+   public:
+    static constexpr int BITS_PER_PAGE = 4;
+    static constexpr int MAX_CATEGORY = (1 << BITS_PER_PAGE) - 1;
+    static constexpr const char *FSM_SUFFIX = ".fsm";
+
+    /** @return free / capacity对应的等级 */
+    static int category(int free, int capacity) {
+        if (free <= 0) return 0;
+        if (free >= capacity) return MAX_CATEGORY;
+        return (free * MAX_CATEGORY + capacity - 1) / capacity;
+    }
+
+    int get(page_id_t page_no) const;
+
+    void set(page_id_t page_no, int category);
+
+    /**
+     * @brief 映射覆盖[0, num_pages)的页面, 新增的页面等级为0, 超出的页面被丢弃
+     */
+    void resize(page_id_t num_pages);
+
+    page_id_t num_pages() const;
+
+    /**
+     * @return [begin, end)中第一个等级不小于min_category的页面, 没有时返回INVALID_PAGE_ID
+     */
+    page_id_t find(int min_category, page_id_t begin, page_id_t end) const;
+
+    /**
+     * @brief 读入save写出的映射, 页面数与num_pages不同(文件在关闭后被改动过)时返回false
+     */
+    bool load(const std::string &path, page_id_t num_pages);
+
+    void save(const std::string &path) const;
+
+   private:
+    mutable std::mutex latch_;
+    std::vector<uint8_t> bytes_;  // 每个字节存放两个页面的等级, 偶数页面在低4位
+    page_id_t num_pages_ = 0;
+};
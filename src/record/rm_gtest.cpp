@@ -14,13 +14,17 @@
 
 #define private public
 #include "rm.h"
+#include "storage/buffer_pool_manager_instance.h"
 #undef private  // for use private variables in "rm.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <ctime>
 #include <iostream>
+#include <iterator>
 #include <unordered_map>
+#include <vector>
 
 #include "gtest/gtest.h"
 #define BUFFER_LENGTH 8192
@@ -51,8 +55,8 @@ void check_equal(const RmFileHandle *file_handle,
         auto rec = file_handle->get_record(rid, context);
         assert(memcmp(mock_buf, rec->data, file_handle->file_hdr_.record_size) == 0);
     }
-    // Randomly get record
-    for (int i = 0; i < 10; i++) {
+    // Randomly get record, 删除所有记录后文件中可能只剩下file header页
+    for (int i = 0; i < 10 && file_handle->file_hdr_.num_pages > 1; i++) {
         Rid rid = {.page_no = 1 + rand() % (file_handle->file_hdr_.num_pages - 1),
                    .slot_no = rand() % file_handle->file_hdr_.num_records_per_page};
         bool mock_exist = mock.count(rid) > 0;
@@ -88,7 +92,7 @@ TEST(RecordManagerTest, SimpleTest) {
 
     // 创建RmManager类的对象rm_manager
     auto disk_manager = std::make_unique<DiskManager>();
-    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto buffer_pool_manager = std::make_unique<BufferPoolManagerInstance>(BUFFER_POOL_SIZE, disk_manager.get());
     auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
 
     std::unordered_map<Rid, std::string, rid_hash_t, rid_equal_t> mock;
@@ -187,7 +191,7 @@ TEST(RecordManagerTest, MultipleFilesTest) {
 
     // 创建RmManager类的对象rm_manager
     auto disk_manager = std::make_unique<DiskManager>();
-    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto buffer_pool_manager = std::make_unique<BufferPoolManagerInstance>(BUFFER_POOL_SIZE, disk_manager.get());
     auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
 
     std::vector<std::string> filenames;
@@ -235,4 +239,399 @@ TEST(RecordManagerTest, MultipleFilesTest) {
         std::string filename = filenames[i];
         rm_manager->destroy_file(filename);
     }
-}
\ No newline at end of file
+}
+/**
+ * @brief 删除记录后释放文件末尾的空页面, 顺序扫描的页面数和文件大小随之减小
+ */
+TEST(RecordManagerTest, ShrinkAfterDeleteTest) {
+    char *result = new char[BUFFER_LENGTH];
+    int offset = 0;
+    Context *context = new Context(nullptr, nullptr, nullptr, result, &offset);
+
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManagerInstance>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    std::unordered_map<Rid, std::string, rid_hash_t, rid_equal_t> mock;
+    std::string filename = "shrink.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    rm_manager->create_file(filename, 128);
+    auto file_handle = rm_manager->open_file(filename);
+
+    char write_buf[PAGE_SIZE];
+    int num_records = file_handle->file_hdr_.num_records_per_page * 5 + 3;
+    for (int i = 0; i < num_records; i++) {
+        rand_buf(file_handle->file_hdr_.record_size, write_buf);
+        Rid rid = file_handle->insert_record(write_buf, context);
+        mock[rid] = std::string(write_buf, file_handle->file_hdr_.record_size);
+    }
+    EXPECT_EQ(7, file_handle->file_hdr_.num_pages);
+    rm_manager->close_file(file_handle.get());
+    EXPECT_EQ(static_cast<off_t>(7) * PAGE_SIZE, disk_manager->GetFileSize(filename));
+    file_handle = rm_manager->open_file(filename);
+
+    // 以任意顺序删除所有记录, 最后一个页面清空时释放末尾所有的空页面
+    for (auto &entry : mock) {
+        file_handle->delete_record(entry.first, context);
+    }
+    mock.clear();
+    EXPECT_EQ(1, file_handle->file_hdr_.num_pages);
+    EXPECT_EQ(RM_NO_PAGE, file_handle->file_hdr_.first_free_page_no);
+    EXPECT_TRUE(RmScan(file_handle.get()).is_end());
+
+    // 释放的页面被重新分配
+    for (int i = 0; i < 3; i++) {
+        rand_buf(file_handle->file_hdr_.record_size, write_buf);
+        Rid rid = file_handle->insert_record(write_buf, context);
+        EXPECT_EQ(RM_FIRST_RECORD_PAGE, rid.page_no);
+        mock[rid] = std::string(write_buf, file_handle->file_hdr_.record_size);
+    }
+    check_equal(file_handle.get(), mock);
+
+    rm_manager->close_file(file_handle.get());
+    EXPECT_EQ(static_cast<off_t>(2) * PAGE_SIZE, disk_manager->GetFileSize(filename));
+    file_handle = rm_manager->open_file(filename);
+    EXPECT_EQ(2, file_handle->file_hdr_.num_pages);
+    check_equal(file_handle.get(), mock);
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+/**
+ * @brief 生成变长字段的内容: 长度为[0, len]的随机可见字符, 其余部分补'\0'
+ */
+void rand_var_buf(const std::vector<RmVarField> &var_fields, int record_size, int max_len, char *out_buf) {
+    rand_buf(record_size, out_buf);
+    for (auto &field : var_fields) {
+        int len = rand() % (std::min(max_len, field.len) + 1);
+        memset(out_buf + field.offset, 0, field.len);
+        for (int i = 0; i < len; i++) {
+            out_buf[field.offset + i] = static_cast<char>('a' + rand() % 26);
+        }
+    }
+}
+
+/**
+ * @brief slotted page格式: 变长记录的插入/删除/变长和变短的更新, 放不下时记录转发到其他页面, Rid保持不变
+ */
+TEST(RecordManagerTest, VarLengthTest) {
+    srand((unsigned)time(nullptr));
+
+    char *result = new char[BUFFER_LENGTH];
+    int offset = 0;
+    Context *context = new Context(nullptr, nullptr, nullptr, result, &offset);
+
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManagerInstance>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    std::unordered_map<Rid, std::string, rid_hash_t, rid_equal_t> mock;
+    std::string filename = "varlen.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    // int, VARCHAR(300), int, VARCHAR(200)
+    std::vector<RmVarField> var_fields = {{.offset = 4, .len = 300}, {.offset = 308, .len = 200}};
+    int record_size = 508;
+    rm_manager->create_file(filename, record_size, var_fields);
+    auto file_handle = rm_manager->open_file(filename);
+    ASSERT_EQ(2, file_handle->file_hdr_.num_var_fields);
+    // 短记录远多于定长格式每页的记录数
+    EXPECT_GT(file_handle->file_hdr_.num_records_per_page, 4 * (PAGE_SIZE / record_size));
+
+    // 插入短记录填满若干页面, 再全部更新为最长的记录, 页面放不下的记录被转发
+    char write_buf[PAGE_SIZE];
+    for (int i = 0; i < 200; i++) {
+        rand_var_buf(var_fields, record_size, 4, write_buf);
+        Rid rid = file_handle->insert_record(write_buf, context);
+        mock[rid] = std::string(write_buf, record_size);
+    }
+    int short_pages = file_handle->file_hdr_.num_pages;
+    for (auto &entry : mock) {
+        rand_var_buf(var_fields, record_size, 300, write_buf);
+        memset(write_buf + 4, 'x', 300);
+        file_handle->update_record(entry.first, write_buf, context);
+        entry.second = std::string(write_buf, record_size);
+    }
+    EXPECT_GT(file_handle->file_hdr_.num_pages, short_pages);
+    int num_forward = 0;
+    for (int page_no = RM_FIRST_RECORD_PAGE; page_no < file_handle->file_hdr_.num_pages; page_no++) {
+        RmPageHandle page_handle = file_handle->fetch_page_handle(page_no);
+        for (int slot_no = 0; slot_no < page_handle.slotted_hdr->num_slots; slot_no++) {
+            num_forward += page_handle.get_slot_entry(slot_no)->forward;
+        }
+        buffer_pool_manager->UnpinPage(page_handle.page->GetPageId(), false);
+    }
+    EXPECT_GT(num_forward, 0);
+    check_equal(file_handle.get(), mock);
+
+    // 随机插入/删除/更新, 记录长度随机变化
+    for (int round = 0; round < 2000; round++) {
+        double insert_prob = 1. - mock.size() / 300.;
+        double dice = rand() * 1. / RAND_MAX;
+        rand_var_buf(var_fields, record_size, 300, write_buf);
+        if (mock.empty() || dice < insert_prob) {
+            Rid rid = file_handle->insert_record(write_buf, context);
+            ASSERT_EQ(0, mock.count(rid));
+            mock[rid] = std::string(write_buf, record_size);
+        } else {
+            auto it = mock.begin();
+            std::advance(it, rand() % mock.size());
+            if (rand() % 2 == 0) {
+                file_handle->update_record(it->first, write_buf, context);
+                it->second = std::string(write_buf, record_size);
+            } else {
+                file_handle->delete_record(it->first, context);
+                mock.erase(it);
+            }
+        }
+        if (round % 100 == 0) {
+            rm_manager->close_file(file_handle.get());
+            file_handle = rm_manager->open_file(filename);
+            check_equal(file_handle.get(), mock);
+        }
+    }
+    check_equal(file_handle.get(), mock);
+
+    // 删除所有记录后释放所有页面
+    for (auto &entry : mock) {
+        file_handle->delete_record(entry.first, context);
+    }
+    mock.clear();
+    EXPECT_EQ(1, file_handle->file_hdr_.num_pages);
+    EXPECT_TRUE(RmScan(file_handle.get()).is_end());
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+/**
+ * @brief slotted page中变长字段的长度超出定义长度, 或元组超出页面时, 读取记录抛出InternalError
+ */
+TEST(RecordManagerTest, CorruptTupleTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManagerInstance>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    std::string filename = "corrupt_tuple.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    // int, VARCHAR(16)
+    std::vector<RmVarField> var_fields = {{.offset = 4, .len = 16}};
+    rm_manager->create_file(filename, 20, var_fields);
+    auto file_handle = rm_manager->open_file(filename);
+    char write_buf[20] = {};
+    strcpy(write_buf + 4, "abc");
+    Rid rid = file_handle->insert_record(write_buf, nullptr);
+    EXPECT_EQ(0, memcmp(write_buf, file_handle->get_record(rid, nullptr)->data, sizeof(write_buf)));
+
+    RmPageHandle page_handle = file_handle->fetch_page_handle(rid.page_no);
+    char *tuple = page_handle.get_slot(rid.slot_no);
+    RmSlot *slot = page_handle.get_slot_entry(rid.slot_no);
+    uint16_t len = 17;
+    memcpy(tuple, &len, sizeof(len));
+    EXPECT_THROW(file_handle->get_record(rid, nullptr), InternalError);
+    len = 3;
+    memcpy(tuple, &len, sizeof(len));
+    uint16_t size = slot->size;
+    slot->size = PAGE_SIZE - slot->offset + 1;
+    EXPECT_THROW(file_handle->get_record(rid, nullptr), InternalError);
+    slot->size = size;
+    EXPECT_EQ(0, memcmp(write_buf, file_handle->get_record(rid, nullptr)->data, sizeof(write_buf)));
+    buffer_pool_manager->UnpinPage(page_handle.page->GetPageId(), false);
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+/**
+ * @brief 记录视图直接指向页面中的记录, 存在期间页面保持固定
+ */
+TEST(RecordManagerTest, RecordViewTest) {
+    char *result = new char[BUFFER_LENGTH];
+    int offset = 0;
+    Context *context = new Context(nullptr, nullptr, nullptr, result, &offset);
+
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManagerInstance>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    std::string filename = "view.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    rm_manager->create_file(filename, 64);
+    auto file_handle = rm_manager->open_file(filename);
+
+    char write_buf[PAGE_SIZE];
+    rand_buf(64, write_buf);
+    Rid rid = file_handle->insert_record(write_buf, context);
+    RmPageHandle page_handle = file_handle->fetch_page_handle(rid.page_no);
+    buffer_pool_manager->UnpinPage(page_handle.page->GetPageId(), false);
+    {
+        RmRecordView view = file_handle->get_record_view(rid);
+        EXPECT_EQ(page_handle.get_slot(rid.slot_no), view.data());
+        EXPECT_EQ(1, page_handle.page->pin_count_);
+        // 移动后只解除固定一次
+        RmRecordView moved = std::move(view);
+        EXPECT_TRUE(view.empty());
+        EXPECT_EQ(0, memcmp(write_buf, moved.data(), 64));
+        auto record = moved.to_record();
+        moved.reset();
+        EXPECT_EQ(0, page_handle.page->pin_count_);
+        EXPECT_EQ(0, memcmp(write_buf, record->data, 64));
+    }
+    EXPECT_EQ(0, page_handle.page->pin_count_);
+    EXPECT_THROW(file_handle->get_record_view(Rid{rid.page_no, rid.slot_no + 1}), RecordNotFoundError);
+    EXPECT_EQ(0, page_handle.page->pin_count_);
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+/**
+ * @brief 批量扫描每次固定一个页面, 取出其中所有记录; 扫描结束后不再固定任何页面
+ */
+TEST(RecordManagerTest, BatchScanTest) {
+    char *result = new char[BUFFER_LENGTH];
+    int offset = 0;
+    Context *context = new Context(nullptr, nullptr, nullptr, result, &offset);
+
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManagerInstance>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    std::unordered_map<Rid, std::string, rid_hash_t, rid_equal_t> mock;
+    std::string filename = "batch.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    rm_manager->create_file(filename, 32);
+    auto file_handle = rm_manager->open_file(filename);
+
+    // 第2个页面的记录全部删除, 其余页面删除一部分记录
+    char write_buf[PAGE_SIZE];
+    int per_page = file_handle->file_hdr_.num_records_per_page;
+    for (int i = 0; i < per_page * 4 + 5; i++) {
+        rand_buf(32, write_buf);
+        Rid rid = file_handle->insert_record(write_buf, context);
+        mock[rid] = std::string(write_buf, 32);
+    }
+    for (auto it = mock.begin(); it != mock.end();) {
+        if (it->first.page_no == RM_FIRST_RECORD_PAGE + 1 || rand() % 3 == 0) {
+            file_handle->delete_record(it->first, context);
+            it = mock.erase(it);
+        } else {
+            it++;
+        }
+    }
+
+    size_t num_records = 0;
+    int num_batches = 0;
+    int last_page_no = RM_NO_PAGE;
+    {
+        RmScanBatch batch;
+        for (RmScan scan(file_handle.get()); scan.next_batch(&batch);) {
+            num_batches++;
+            ASSERT_GT(batch.size(), 0);
+            ASSERT_GT(batch.rid(0).page_no, last_page_no);
+            last_page_no = batch.rid(0).page_no;
+            EXPECT_EQ(1, batch.page_->pin_count_);
+            for (size_t i = 0; i < batch.size(); i++) {
+                ASSERT_EQ(1, mock.count(batch.rid(i)));
+                EXPECT_EQ(0, memcmp(mock.at(batch.rid(i)).c_str(), batch.get_record_view(i).data(), 32));
+                num_records++;
+            }
+        }
+        EXPECT_EQ(nullptr, batch.page_);
+    }
+    EXPECT_EQ(mock.size(), num_records);
+    EXPECT_EQ(file_handle->file_hdr_.num_pages - 2, num_batches);
+    for (int page_no = RM_FIRST_RECORD_PAGE; page_no < file_handle->file_hdr_.num_pages; page_no++) {
+        RmPageHandle page_handle = file_handle->fetch_page_handle(page_no);
+        EXPECT_EQ(1, page_handle.page->pin_count_);
+        buffer_pool_manager->UnpinPage(page_handle.page->GetPageId(), false);
+    }
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+/**
+ * @brief 删除记录后空闲空间映射指向被删除记录的页面; 映射在关闭文件时写入附属文件,
+ * 附属文件丢失时从页面重建
+ */
+TEST(RecordManagerTest, FreeSpaceMapTest) {
+    char *result = new char[BUFFER_LENGTH];
+    int offset = 0;
+    Context *context = new Context(nullptr, nullptr, nullptr, result, &offset);
+
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManagerInstance>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    std::unordered_map<Rid, std::string, rid_hash_t, rid_equal_t> mock;
+    std::string filename = "fsm.txt";
+    std::string fsm_filename = filename + RmFreeSpaceMap::FSM_SUFFIX;
+    if (disk_manager->is_file(filename)) {
+        rm_manager->destroy_file(filename);
+    }
+    rm_manager->create_file(filename, 128);
+    auto file_handle = rm_manager->open_file(filename);
+
+    char write_buf[PAGE_SIZE];
+    int num_records = file_handle->file_hdr_.num_records_per_page * 4;
+    for (int i = 0; i < num_records; i++) {
+        rand_buf(file_handle->file_hdr_.record_size, write_buf);
+        Rid rid = file_handle->insert_record(write_buf, context);
+        mock[rid] = std::string(write_buf, file_handle->file_hdr_.record_size);
+    }
+    EXPECT_EQ(5, file_handle->file_hdr_.num_pages);
+    for (page_id_t page_no = RM_FIRST_RECORD_PAGE; page_no < 5; page_no++) {
+        EXPECT_EQ(0, file_handle->fsm_.get(page_no));
+    }
+
+    // 删除第2个页面中的两条记录, 之后的插入都放入该页面, 不创建新页面
+    for (int slot_no : {3, 7}) {
+        Rid rid{2, slot_no};
+        file_handle->delete_record(rid, context);
+        mock.erase(rid);
+    }
+    EXPECT_GT(file_handle->fsm_.get(2), 0);
+    rand_buf(file_handle->file_hdr_.record_size, write_buf);
+    Rid rid = file_handle->insert_record(write_buf, context);
+    EXPECT_EQ(2, rid.page_no);
+    mock[rid] = std::string(write_buf, file_handle->file_hdr_.record_size);
+
+    // 正常关闭时写入附属文件, 重新打开后读入
+    rm_manager->close_file(file_handle.get());
+    EXPECT_TRUE(disk_manager->is_file(fsm_filename));
+    file_handle = rm_manager->open_file(filename);
+    rand_buf(file_handle->file_hdr_.record_size, write_buf);
+    rid = file_handle->insert_record(write_buf, context);
+    EXPECT_EQ(2, rid.page_no);
+    EXPECT_FALSE(disk_manager->is_file(fsm_filename));
+    mock[rid] = std::string(write_buf, file_handle->file_hdr_.record_size);
+
+    // 删除一条记录后模拟附属文件丢失, 重新打开后从页面重建
+    rid = Rid{4, 0};
+    file_handle->delete_record(rid, context);
+    mock.erase(rid);
+    rm_manager->close_file(file_handle.get());
+    disk_manager->destroy_file(fsm_filename);
+    file_handle = rm_manager->open_file(filename);
+    rand_buf(file_handle->file_hdr_.record_size, write_buf);
+    rid = file_handle->insert_record(write_buf, context);
+    EXPECT_EQ(4, rid.page_no);
+    EXPECT_EQ(0, rid.slot_no);
+    mock[rid] = std::string(write_buf, file_handle->file_hdr_.record_size);
+    EXPECT_EQ(5, file_handle->file_hdr_.num_pages);
+    check_equal(file_handle.get(), mock);
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+    EXPECT_FALSE(disk_manager->is_file(fsm_filename));
+}
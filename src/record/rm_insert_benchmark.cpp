@@ -0,0 +1,151 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Rucbase
+//
+// rm_insert_benchmark.cpp
+//
+// Identification: src/record/rm_insert_benchmark.cpp
+//
+// Copyright (c) 2022, RUC Deke Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <unistd.h>
+
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "rm.h"
+#include "storage/parallel_buffer_pool_manager.h"
+
+const std::string BENCH_DB_NAME = "RmInsertBenchmark_db";
+
+/**
+ * @brief 多个线程同时向同一个记录文件插入记录, 比较不同线程数下的吞吐量
+ * @note 空闲空间映射使各线程分散到不同的页面, 同一时刻被插入的页面数应接近线程数
+ */
+class RmInsertBenchmark : public ::testing::Test {
+   public:
+    static constexpr int NUM_RECORDS = 200000;
+    static constexpr size_t POOL_SIZE = 4096;
+    static constexpr size_t NUM_INSTANCES = 8;
+    const std::string filename_ = "bench_table";
+    std::unique_ptr<DiskManager> disk_manager_;
+    std::unique_ptr<ParallelBufferPoolManager> buffer_pool_manager_;
+    std::unique_ptr<RmManager> rm_manager_;
+
+    void SetUp() override {
+        disk_manager_ = std::make_unique<DiskManager>();
+        if (disk_manager_->is_dir(BENCH_DB_NAME)) {
+            disk_manager_->destroy_dir(BENCH_DB_NAME);
+        }
+        disk_manager_->create_dir(BENCH_DB_NAME);
+        if (chdir(BENCH_DB_NAME.c_str()) < 0) {
+            throw UnixError();
+        }
+        buffer_pool_manager_ = std::make_unique<ParallelBufferPoolManager>(NUM_INSTANCES, POOL_SIZE / NUM_INSTANCES, disk_manager_.get());
+        rm_manager_ = std::make_unique<RmManager>(disk_manager_.get(), buffer_pool_manager_.get());
+    }
+
+    void TearDown() override {
+        rm_manager_.reset();
+        buffer_pool_manager_.reset();
+        if (chdir("..") < 0) {
+            throw UnixError();
+        }
+        disk_manager_->destroy_dir(BENCH_DB_NAME);
+    }
+
+    /**
+     * @brief num_threads个线程各插入NUM_RECORDS / num_threads条记录, 每条记录的前8字节为线程号和序号
+     * @param var_fields 非空时使用slotted page格式
+     */
+    void Run(int num_threads, int record_size, const std::vector<RmVarField> &var_fields) {
+        rm_manager_->create_file(filename_, record_size, var_fields);
+        auto file_handle = rm_manager_->open_file(filename_);
+        int per_thread = NUM_RECORDS / num_threads;
+        std::vector<std::vector<Rid>> rids(num_threads);
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; t++) {
+            threads.emplace_back([&, t]() {
+                std::vector<char> buf(record_size, 'x');
+                rids[t].reserve(per_thread);
+                for (int i = 0; i < per_thread; i++) {
+                    memcpy(buf.data(), &t, sizeof(int));
+                    memcpy(buf.data() + sizeof(int), &i, sizeof(int));
+                    // 变长字段的长度随序号变化
+                    for (auto &field : var_fields) {
+                        memset(buf.data() + field.offset, 0, field.len);
+                        memset(buf.data() + field.offset, 'a' + i % 26, 1 + i % field.len);
+                    }
+                    rids[t].push_back(file_handle->insert_record(buf.data(), nullptr));
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        // 同一时刻被插入的页面: 各线程第k次插入所在页面的并集, 对所有k取平均
+        double spread = 0;
+        for (int i = 0; i < per_thread; i++) {
+            std::set<page_id_t> pages;
+            for (int t = 0; t < num_threads; t++) pages.insert(rids[t][i].page_no);
+            spread += pages.size();
+        }
+        printf("%-8s threads: %d  %8.3fs %10.0f inserts/s  pages: %d  concurrent pages: %.2f\n",
+               var_fields.empty() ? "fixed" : "slotted", num_threads, elapsed.count(),
+               num_threads * per_thread / elapsed.count(), file_handle->get_file_hdr().num_pages,
+               spread / per_thread);
+
+        // 每条记录都能按Rid读出, Rid互不相同
+        std::set<std::pair<page_id_t, int>> distinct;
+        for (int t = 0; t < num_threads; t++) {
+            for (int i = 0; i < per_thread; i++) {
+                auto record = file_handle->get_record(rids[t][i], nullptr);
+                int thread_no, seq_no;
+                memcpy(&thread_no, record->data, sizeof(int));
+                memcpy(&seq_no, record->data + sizeof(int), sizeof(int));
+                EXPECT_EQ(t, thread_no);
+                EXPECT_EQ(i, seq_no);
+                distinct.insert({rids[t][i].page_no, rids[t][i].slot_no});
+            }
+        }
+        EXPECT_EQ(static_cast<size_t>(num_threads * per_thread), distinct.size());
+        size_t num_scanned = 0;
+        for (RmScan scan(file_handle.get()); !scan.is_end(); scan.next()) num_scanned++;
+        EXPECT_EQ(distinct.size(), num_scanned);
+
+        rm_manager_->close_file(file_handle.get());
+        rm_manager_->destroy_file(filename_);
+    }
+};
+
+/**
+ * @brief 定长格式, 每条记录64字节
+ */
+TEST_F(RmInsertBenchmark, FixedLengthTest) {
+    for (int num_threads : {1, 2, 4, 8}) {
+        Run(num_threads, 64, {});
+    }
+}
+
+/**
+ * @brief slotted page格式, 每条记录含一个最长56字节的变长字段
+ */
+TEST_F(RmInsertBenchmark, VarLengthTest) {
+    std::vector<RmVarField> var_fields = {RmVarField{.offset = 8, .len = 56}};
+    for (int num_threads : {1, 2, 4, 8}) {
+        Run(num_threads, 64, var_fields);
+    }
+}
@@ -2,6 +2,9 @@
 
 #include <assert.h>
 
+#include <algorithm>
+#include <vector>
+
 #include "bitmap.h"
 #include "rm_defs.h"
 #include "rm_file_handle.h"
@@ -17,22 +20,56 @@ class RmManager {
     RmManager(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager)
         : disk_manager_(disk_manager), buffer_pool_manager_(buffer_pool_manager) {}
 
-    void create_file(const std::string &filename, int record_size) {
+    /**
+     * @brief 创建记录文件
+     * @param var_fields 记录中的变长字段, 按offset递增; 非空时使用slotted page格式, 变长字段只存储实际长度
+     */
+    void create_file(const std::string &filename, int record_size, const std::vector<RmVarField> &var_fields = {}) {
         if (record_size < 1 || record_size > RM_MAX_RECORD_SIZE) {
             throw InvalidRecordSizeError(record_size);
         }
+        if (var_fields.size() > RM_MAX_VAR_FIELDS) {
+            throw TooManyVarFieldsError(static_cast<int>(var_fields.size()));
+        }
+        int fixed_size = record_size;
+        for (size_t i = 0; i < var_fields.size(); i++) {
+            int prev_end = i == 0 ? 0 : var_fields[i - 1].offset + var_fields[i - 1].len;
+            if (var_fields[i].offset < prev_end || var_fields[i].len < 1 ||
+                var_fields[i].offset + var_fields[i].len > record_size) {
+                throw InternalError("RmManager::create_file: invalid variable-length field");
+            }
+            fixed_size -= var_fields[i].len;
+        }
         disk_manager_->create_file(filename);
         int fd = disk_manager_->open_file(filename);
-        
+        // 第0页用于存放file header
+        disk_manager_->AllocatePage(fd);
+
         // 初始化file header
         RmFileHdr file_hdr{};
         file_hdr.record_size = record_size;
         file_hdr.num_pages = 1;
         file_hdr.first_free_page_no = RM_NO_PAGE;
-        // We have: sizeof(hdr) + (n + 7) / 8 + n * record_size <= PAGE_SIZE
-        file_hdr.num_records_per_page =
-            (BITMAP_WIDTH * (PAGE_SIZE - 1 - (int)sizeof(RmFileHdr)) + 1) / (1 + record_size * BITMAP_WIDTH);
-        file_hdr.bitmap_size = (file_hdr.num_records_per_page + BITMAP_WIDTH - 1) / BITMAP_WIDTH;
+        int page_hdr_size = Page::OFFSET_PAGE_HDR + (int)sizeof(RmPageHdr);
+        if (var_fields.empty()) {
+            // We have: sizeof(hdr) + (n + 7) / 8 + n * record_size <= PAGE_SIZE
+            file_hdr.num_records_per_page =
+                (BITMAP_WIDTH * (PAGE_SIZE - 1 - page_hdr_size) + 1) / (1 + record_size * BITMAP_WIDTH);
+            file_hdr.bitmap_size = (file_hdr.num_records_per_page + BITMAP_WIDTH - 1) / BITMAP_WIDTH;
+        } else {
+            file_hdr.num_var_fields = static_cast<int>(var_fields.size());
+            std::copy(var_fields.begin(), var_fields.end(), file_hdr.var_fields);
+            // slot数按最短的元组计算: bitmap_size + n * (sizeof(RmSlot) + min_tuple_size) <= avail
+            // bitmap_size向上取整到4字节, 使slot目录对齐
+            int avail = PAGE_SIZE - page_hdr_size - (int)sizeof(RmSlottedPageHdr);
+            int min_tuple_size =
+                std::max(file_hdr.num_var_fields * (int)sizeof(uint16_t) + fixed_size, RM_MIN_TUPLE_SIZE);
+            auto bitmap_size = [](int n) { return ((n + BITMAP_WIDTH - 1) / BITMAP_WIDTH + 3) / 4 * 4; };
+            int n = BITMAP_WIDTH * avail / (1 + BITMAP_WIDTH * ((int)sizeof(RmSlot) + min_tuple_size));
+            while (bitmap_size(n) + n * ((int)sizeof(RmSlot) + min_tuple_size) > avail) n--;
+            file_hdr.num_records_per_page = n;
+            file_hdr.bitmap_size = bitmap_size(n);
+        }
 
         // 将file header写入磁盘文件（名为file name，文件描述符为fd）中的第0页
         // head page直接写入磁盘，没有经过缓冲区的NewPage，那么也就不需要FlushPage
@@ -40,19 +77,34 @@ class RmManager {
         disk_manager_->close_file(fd);
     }
 
-    void destroy_file(const std::string &filename) { disk_manager_->destroy_file(filename); }
+    void destroy_file(const std::string &filename) {
+        disk_manager_->destroy_file(filename);
+        std::string fsm_filename = filename + RmFreeSpaceMap::FSM_SUFFIX;
+        if (disk_manager_->is_file(fsm_filename)) disk_manager_->destroy_file(fsm_filename);
+    }
 
     // 注意这里打开文件，创建并返回了record file handle的指针
-    std::unique_ptr<RmFileHandle> open_file(const std::string &filename) {
-        int fd = disk_manager_->open_file(filename);
+    // read_only为true时只读打开, 页面直接从文件的内存映射中访问, 修改记录时抛出FileReadOnlyError
+    // direct_io为true时用O_DIRECT读写页面, 页面只缓存在缓冲池中
+    std::unique_ptr<RmFileHandle> open_file(const std::string &filename, bool read_only = false,
+                                            bool direct_io = false) {
+        int fd = disk_manager_->open_file(filename, read_only, direct_io);
         return std::make_unique<RmFileHandle>(disk_manager_, buffer_pool_manager_, fd);
     }
 
     void close_file(const RmFileHandle *file_handle) {
-        disk_manager_->write_page(file_handle->fd_, RM_FILE_HDR_PAGE, (char *)&file_handle->file_hdr_,
-                                  sizeof(file_handle->file_hdr_));
+        if (!disk_manager_->is_read_only(file_handle->fd_)) {
+            disk_manager_->write_page(file_handle->fd_, RM_FILE_HDR_PAGE, (char *)&file_handle->file_hdr_,
+                                      sizeof(file_handle->file_hdr_));
+            // 空闲空间映射写入附属文件, 下次打开时不必读取所有页面重建
+            file_handle->save_free_space_map();
+        }
         // 缓冲区的所有页刷到磁盘，注意这句话必须写在close_file前面
+        buffer_pool_manager_->CancelPrefetch(file_handle->fd_);
+        buffer_pool_manager_->DropCompressedPages(file_handle->fd_);
+        buffer_pool_manager_->SetFileQuota(file_handle->fd_, 0);
         buffer_pool_manager_->FlushAllPages(file_handle->fd_);
+        buffer_pool_manager_->DiscardPages(file_handle->fd_);
         disk_manager_->close_file(file_handle->fd_);
     }
 };
@@ -1,53 +1,61 @@
 #include "rm_scan.h"
 
-#include "rm_file_handle.h"
+#include <algorithm>
+#include <mutex>
+#include <shared_mutex>
 
 /**
  * @brief 初始化file_handle和rid
  *
  * @param file_handle
+ * @param strategy 缓冲区访问策略, 大表顺序扫描时传入, 为nullptr时正常使用缓冲池
  */
-RmScan::RmScan(const RmFileHandle *file_handle) : file_handle_(file_handle) {
+RmScan::RmScan(const RmFileHandle *file_handle, BufferAccessStrategy *strategy)
+    : file_handle_(file_handle), strategy_(strategy) {
     // Todo:
     // 初始化file_handle和rid（指向第一个存放了记录的位置）
-    file_handle_ = file_handle;
-    RmFileHdr _file_hdr = file_handle_->file_hdr_;
-    int max_n = _file_hdr.num_records_per_page;
-    if(_file_hdr.num_pages == 1) {
-        rid_.slot_no = max_n;
-        rid_.page_no = 0;
-    }
-    else {
-        RmPageHandle page_handle = file_handle_->fetch_page_handle(1);
-        rid_.slot_no = Bitmap::first_bit(1, page_handle.bitmap, max_n);
-        rid_.page_no = 1;
+    rid_ = Rid{RM_FIRST_RECORD_PAGE, -1};
+    if (strategy_ != nullptr) {
+        // 大表扫描: 提示缓冲池预读开头的页面, 之后的页面由缓冲池检测到顺序访问后预读
+        file_handle_->buffer_pool_manager_->Prefetch(PageId{file_handle_->fd_, RM_FIRST_RECORD_PAGE}, READ_AHEAD_PAGES,
+                                                     strategy_);
     }
+    next();
+}
+
+/**
+ * @brief 固定rid_.page_no页面
+ * @note 在pages_latch_的读锁下比较num_pages并固定页面, release_trailing_pages不会同时释放该页面;
+ * 被固定的页面不会被释放, 固定后即可释放读锁
+ * @return 页面已超出文件末尾(例如尾部的空页面已被释放)时返回nullptr
+ */
+Page *RmScan::fetch_page() const {
+    std::shared_lock<std::shared_mutex> lock(file_handle_->pages_latch_);
+    if (rid_.page_no >= file_handle_->file_hdr_.num_pages) return nullptr;
+    return file_handle_->fetch_page_handle(rid_.page_no, strategy_).page;
 }
 
 /**
  * @brief 找到文件中下一个存放了记录的位置
+ * @note 每个页面读完bitmap后立即解除固定, 扫描过程中不会一直占用缓冲池中的帧
  */
 void RmScan::next() {
     // Todo:
     // 找到文件中下一个存放了记录的非空闲位置，用rid_来指向这个位置
-    int page_no = rid_.page_no;
-    RmPageHandle page_handle = file_handle_->fetch_page_handle(page_no);
-    RmFileHdr _file_hdr = file_handle_->file_hdr_;
-    int max_n = _file_hdr.num_records_per_page;
-    int next_slot_no = Bitmap::next_bit(1, page_handle.bitmap, max_n, rid_.slot_no);
-    int next_page_no = page_no;
-    if(next_slot_no == max_n) {
-        for(int i = page_no + 1; i < _file_hdr.num_pages; ++i) {
-            RmPageHandle page_handle = file_handle_->fetch_page_handle(i);
-            next_slot_no = Bitmap::first_bit(1, page_handle.bitmap, max_n);
-            if(next_slot_no != max_n) {
-                next_page_no = i;
-                break;
-            } 
+    const RmFileHdr &file_hdr = file_handle_->file_hdr_;
+    int max_n = file_hdr.num_records_per_page;
+    for (Page *page = fetch_page(); page != nullptr; page = fetch_page()) {
+        RmPageHandle page_handle(&file_hdr, page);
+        int next_slot_no = Bitmap::next_bit(true, page_handle.bitmap, max_n, rid_.slot_no);
+        file_handle_->buffer_pool_manager_->UnpinPage(page_handle.page->GetPageId(), false);
+        if (next_slot_no < max_n) {
+            rid_.slot_no = next_slot_no;
+            return;
         }
+        rid_ = Rid{rid_.page_no + 1, -1};
     }
-    rid_.slot_no = next_slot_no;
-    rid_.page_no = next_page_no;
+    // 没有更多记录
+    rid_.slot_no = max_n;
 }
 
 /**
@@ -65,4 +73,52 @@ bool RmScan::is_end() const {
 Rid RmScan::rid() const {
     // Todo: 修改返回值
     return rid_;
-}
\ No newline at end of file
+}
+/**
+ * @brief 批量扫描: 固定从rid_开始的下一个有记录的页面, 一次取出其中所有记录的slot_no
+ * @note 每个页面只访问一次缓冲池; 取出后rid_指向下一个页面的开头, 不能再与next()/rid()混用
+ * @return 没有更多记录时返回false, 此时batch为空
+ */
+bool RmScan::next_batch(RmScanBatch *batch) {
+    batch->reset();
+    const RmFileHdr &file_hdr = file_handle_->file_hdr_;
+    int max_n = file_hdr.num_records_per_page;
+    while (!is_end()) {
+        Page *page = fetch_page();
+        if (page == nullptr) {
+            rid_.slot_no = max_n;
+            break;
+        }
+        RmPageHandle page_handle(&file_hdr, page);
+        // rid_为尚未取出的第一条记录, 或-1表示页面开头
+        for (int slot_no = Bitmap::next_bit(true, page_handle.bitmap, max_n, std::max(rid_.slot_no, 0) - 1);
+             slot_no < max_n; slot_no = Bitmap::next_bit(true, page_handle.bitmap, max_n, slot_no)) {
+            batch->slot_nos_.push_back(slot_no);
+        }
+        rid_ = Rid{rid_.page_no + 1, -1};
+        if (!batch->slot_nos_.empty()) {
+            batch->file_handle_ = file_handle_;
+            batch->page_ = page_handle.page;
+            batch->page_no_ = page_handle.page->GetPageId().page_no;
+            break;
+        }
+        file_handle_->buffer_pool_manager_->UnpinPage(page_handle.page->GetPageId(), false);
+    }
+    return batch->size() > 0;
+}
+
+RmRecordView RmScanBatch::get_record_view(size_t i) const {
+    if (file_handle_->is_slotted()) return file_handle_->get_record_view(rid(i));
+    RmPageHandle page_handle(&file_handle_->file_hdr_, page_);
+    return RmRecordView(nullptr, nullptr, page_handle.get_slot(slot_nos_[i]), file_handle_->file_hdr_.record_size);
+}
+
+/**
+ * @brief 解除固定页面并清空批次
+ */
+void RmScanBatch::reset() {
+    if (page_ != nullptr) file_handle_->buffer_pool_manager_->UnpinPage(page_->GetPageId(), false);
+    page_ = nullptr;
+    page_no_ = RM_NO_PAGE;
+    slot_nos_.clear();
+}
@@ -1,18 +1,59 @@
 #pragma once
 
+#include <vector>
+
 #include "rm_defs.h"
+#include "rm_file_handle.h"
+#include "storage/buffer_access_strategy.h"
+
+/**
+ * @brief 批量扫描取出的一个页面: 页面中所有记录的slot_no(selection vector)
+ * @note 页面在批次存在期间保持固定, 记录可以直接在页面中读取; 下一次RmScan::next_batch、reset或析构时解除固定
+ */
+class RmScanBatch {
+    friend class RmScan;
+
+   public:
+    RmScanBatch() = default;
+
+    ~RmScanBatch() { reset(); }
+
+    DISALLOW_COPY(RmScanBatch);
+
+    size_t size() const { return slot_nos_.size(); }
+
+    const std::vector<int> &slot_nos() const { return slot_nos_; }
 
-class RmFileHandle;
+    Rid rid(size_t i) const { return Rid{page_no_, slot_nos_[i]}; }
+
+    /**
+     * @brief 第i条记录的视图, 定长格式中直接指向已固定的页面, 不再固定页面
+     */
+    RmRecordView get_record_view(size_t i) const;
+
+    void reset();
+
+   private:
+    const RmFileHandle *file_handle_ = nullptr;
+    Page *page_ = nullptr;
+    int page_no_ = RM_NO_PAGE;
+    std::vector<int> slot_nos_;
+};
 
 class RmScan : public RecScan {
     const RmFileHandle *file_handle_;
     Rid rid_;
+    BufferAccessStrategy *strategy_;  // 扫描使用的缓冲区访问策略, 可以为nullptr
+
+    Page *fetch_page() const;
 public:
-    RmScan(const RmFileHandle *file_handle);
+    RmScan(const RmFileHandle *file_handle, BufferAccessStrategy *strategy = nullptr);
 
     void next() override;
 
     bool is_end() const override;
 
     Rid rid() const override;
+
+    bool next_batch(RmScanBatch *batch);
 };
@@ -59,3 +59,20 @@ size_t ClockReplacer::Size() {
         if(*it != Status::EMPTY_OR_PINNED) size++;
     return size;
 }
+
+/**
+ * @brief 按淘汰顺序返回replacer中的frame, 不改变各frame的状态和hand_
+ * @note 从hand_开始, UNTOUCHED的frame先于ACCESSED的frame被淘汰(后者还有一次机会)
+ * @param max_num 最多返回的frame数
+ */
+std::vector<frame_id_t> ClockReplacer::EvictionCandidates(size_t max_num) {
+    const std::lock_guard<mutex_t> guard(mutex_);
+    std::vector<frame_id_t> candidates;
+    for (Status status : {Status::UNTOUCHED, Status::ACCESSED}) {
+        for (size_t i = 0; i < capacity_ && candidates.size() < max_num; i++) {
+            frame_id_t frame_id = static_cast<frame_id_t>((hand_ + i) % capacity_);
+            if (circular_[frame_id] == status) candidates.push_back(frame_id);
+        }
+    }
+    return candidates;
+}
@@ -49,6 +49,8 @@ class ClockReplacer : public Replacer {
 
     size_t Size() override;
 
+    std::vector<frame_id_t> EvictionCandidates(size_t max_num) override;
+
    private:
     std::vector<Status> circular_;
     frame_id_t hand_{0};  // initial hand_ value = 0, the scan starter
@@ -0,0 +1,63 @@
+#include "replacer/lock_free_clock_replacer.h"
+
+LockFreeClockReplacer::LockFreeClockReplacer(size_t num_pages)
+    : status_(new std::atomic<uint8_t>[num_pages]), capacity_(num_pages) {
+    for (size_t i = 0; i < capacity_; i++) {
+        status_[i].store(EMPTY_OR_PINNED, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief 从hand_开始扫描: ACCESSED的帧清除引用位, 用CAS将第一个UNTOUCHED的帧置为EMPTY_OR_PINNED并返回
+ * @note 并发的Unpin可能不断设置引用位, 因此最多扫描三圈; 期间仍未找到则返回false
+ */
+bool LockFreeClockReplacer::Victim(frame_id_t *frame_id) {
+    if (capacity_ == 0) return false;
+    for (size_t step = 0; step < 3 * capacity_; step++) {
+        if (size_.load(std::memory_order_relaxed) == 0) return false;
+        size_t pos = hand_.fetch_add(1, std::memory_order_relaxed) % capacity_;
+        uint8_t status = status_[pos].load(std::memory_order_relaxed);
+        if (status == ACCESSED) {
+            // CAS失败说明该帧刚被固定或再次访问, 都不应淘汰, 直接跳过
+            status_[pos].compare_exchange_strong(status, UNTOUCHED, std::memory_order_relaxed);
+        } else if (status == UNTOUCHED &&
+                   status_[pos].compare_exchange_strong(status, EMPTY_OR_PINNED, std::memory_order_acq_rel)) {
+            size_.fetch_sub(1, std::memory_order_relaxed);
+            *frame_id = static_cast<frame_id_t>(pos);
+            return true;
+        }
+    }
+    return false;
+}
+
+void LockFreeClockReplacer::Pin(frame_id_t frame_id) {
+    // 与Victim的CAS竞争时只有一方看到旧状态不为EMPTY_OR_PINNED, size_只减一次
+    if (status_[frame_id].exchange(EMPTY_OR_PINNED, std::memory_order_acq_rel) != EMPTY_OR_PINNED) {
+        size_.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+void LockFreeClockReplacer::Unpin(frame_id_t frame_id) {
+    if (status_[frame_id].exchange(ACCESSED, std::memory_order_acq_rel) == EMPTY_OR_PINNED) {
+        size_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief 按淘汰顺序返回replacer中的frame, 不改变各frame的状态和hand_
+ * @note 并发修改时只是一个近似的快照, 仅作为后台写回等的提示
+ */
+std::vector<frame_id_t> LockFreeClockReplacer::EvictionCandidates(size_t max_num) {
+    std::vector<frame_id_t> candidates;
+    if (capacity_ == 0) return candidates;
+    size_t hand = hand_.load(std::memory_order_relaxed);
+    for (uint8_t status : {UNTOUCHED, ACCESSED}) {
+        for (size_t i = 0; i < capacity_ && candidates.size() < max_num; i++) {
+            size_t pos = (hand + i) % capacity_;
+            if (status_[pos].load(std::memory_order_relaxed) == status) {
+                candidates.push_back(static_cast<frame_id_t>(pos));
+            }
+        }
+    }
+    return candidates;
+}
@@ -0,0 +1,57 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Rucbase
+//
+// lock_free_clock_replacer.h
+//
+// Identification: src/replacer/lock_free_clock_replacer.h
+//
+// Copyright (c) 2022, RUC Deke Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "common/config.h"
+#include "replacer/replacer.h"
+
+/**
+ * @brief 不加锁的CLOCK替换策略
+ * @note 每个帧的状态(固定/引用位)是一个原子变量, Pin/Unpin只对本帧的状态做一次原子交换, 不获取任何锁;
+ * 时钟指针hand_由原子加法推进, 多个线程可以同时扫描, 各自用CAS从UNTOUCHED抢占帧, 同一帧只会被一个线程选中.
+ * 淘汰顺序与ClockReplacer相同.
+ * @note BufferPoolManagerInstance命中已被其他线程固定的页面时在latch_之外调用Pin(见FetchPinnedPage),
+ * 此时不获取任何锁; 第一次固定, Unpin和Victim仍由缓冲池的latch_串行化
+ */
+class LockFreeClockReplacer : public Replacer {
+   public:
+    /**
+     * @param num_pages the maximum number of pages the replacer will be required to store
+     */
+    explicit LockFreeClockReplacer(size_t num_pages);
+
+    ~LockFreeClockReplacer() override = default;
+
+    bool Victim(frame_id_t *frame_id) override;
+
+    void Pin(frame_id_t frame_id) override;
+
+    void Unpin(frame_id_t frame_id) override;
+
+    size_t Size() override { return size_.load(std::memory_order_relaxed); }
+
+    std::vector<frame_id_t> EvictionCandidates(size_t max_num) override;
+
+   private:
+    // 与ClockReplacer::Status含义相同
+    enum Status : uint8_t { EMPTY_OR_PINNED = 0, UNTOUCHED, ACCESSED };
+
+    std::unique_ptr<std::atomic<uint8_t>[]> status_;
+    std::atomic<size_t> hand_{0};  // 下一个要检查的帧, 对capacity_取模
+    std::atomic<size_t> size_{0};  // 状态不为EMPTY_OR_PINNED的帧数
+    size_t capacity_;
+};
@@ -0,0 +1,114 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Rucbase
+//
+// lock_free_clock_replacer_test.cpp
+//
+// Identification: src/replacer/lock_free_clock_replacer_test.cpp
+//
+// Copyright (c) 2022, RUC Deke Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "replacer/lock_free_clock_replacer.h"
+
+#include <atomic>
+#include <cstdio>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(LockFreeClockReplacerTest, SimpleTest) {
+    LockFreeClockReplacer clock_replacer(7);
+
+    // Scenario: unpin six elements, i.e. add them to the replacer.
+    clock_replacer.Unpin(1);
+    clock_replacer.Unpin(2);
+    clock_replacer.Unpin(3);
+    clock_replacer.Unpin(4);
+    clock_replacer.Unpin(5);
+    clock_replacer.Unpin(6);
+    clock_replacer.Unpin(1);
+    EXPECT_EQ(6, clock_replacer.Size());
+
+    // Scenario: get three victims from the clock.
+    int value;
+    clock_replacer.Victim(&value);
+    EXPECT_EQ(1, value);
+    clock_replacer.Victim(&value);
+    EXPECT_EQ(2, value);
+    clock_replacer.Victim(&value);
+    EXPECT_EQ(3, value);
+
+    // Scenario: pin elements in the replacer.
+    // Note that 3 has already been victimized, so pinning 3 should have no effect.
+    clock_replacer.Pin(3);
+    clock_replacer.Pin(4);
+    EXPECT_EQ(2, clock_replacer.Size());
+
+    // Scenario: unpin 4. We expect that the reference bit of 4 will be set to 1.
+    clock_replacer.Unpin(4);
+
+    // Scenario: continue looking for victims. We expect these victims.
+    clock_replacer.Victim(&value);
+    EXPECT_EQ(5, value);
+    clock_replacer.Victim(&value);
+    EXPECT_EQ(6, value);
+    clock_replacer.Victim(&value);
+    EXPECT_EQ(4, value);
+}
+
+TEST(LockFreeClockReplacerTest, CornerCaseTest) {
+    LockFreeClockReplacer clock_replacer(4);
+    int value;
+    bool result = clock_replacer.Victim(&value);
+    EXPECT_FALSE(result);
+
+    clock_replacer.Unpin(3);
+    clock_replacer.Unpin(2);
+    EXPECT_EQ(2, clock_replacer.Size());
+    clock_replacer.Victim(&value);
+    EXPECT_EQ(2, value);
+    clock_replacer.Unpin(1);
+    EXPECT_EQ(2, clock_replacer.Size());
+    clock_replacer.Victim(&value);
+    EXPECT_EQ(3, value);
+    clock_replacer.Victim(&value);
+    EXPECT_EQ(1, value);
+    EXPECT_FALSE(clock_replacer.Victim(&value));
+    EXPECT_EQ(0, clock_replacer.Size());
+}
+
+/**
+ * @brief 多个线程并发Pin/Unpin/Victim, 每个帧同一时刻最多被一个线程选为victim
+ */
+TEST(LockFreeClockReplacerTest, ConcurrencyTest) {
+    const size_t num_frames = 64;
+    const int num_threads = 8;
+    const int num_ops = 20000;
+    LockFreeClockReplacer clock_replacer(num_frames);
+    // owned[i]表示帧i当前被某个线程作为victim持有
+    std::vector<std::atomic<bool>> owned(num_frames);
+    for (size_t i = 0; i < num_frames; i++) {
+        clock_replacer.Unpin(static_cast<frame_id_t>(i));
+    }
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < num_ops; i++) {
+                frame_id_t frame_id;
+                if (!clock_replacer.Victim(&frame_id)) continue;
+                EXPECT_FALSE(owned[frame_id].exchange(true));
+                // 被选中的帧已从replacer中移除, 并发的Victim不会再返回它
+                owned[frame_id] = false;
+                clock_replacer.Unpin(frame_id);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(num_frames, clock_replacer.Size());
+}
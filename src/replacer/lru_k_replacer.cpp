@@ -0,0 +1,115 @@
+#include "replacer/lru_k_replacer.h"
+
+LRUKReplacer::LRUKReplacer(size_t num_pages, size_t k) : frames_(num_pages), k_(k) {}
+
+LRUKReplacer::~LRUKReplacer() = default;
+
+/**
+ * @brief 记录frame的一次访问, 只保留最近k_次
+ * @note 可淘汰的frame的排序键可能改变, 先移出cold_/hot_再重新加入
+ */
+void LRUKReplacer::RecordAccessLocked(frame_id_t frame_id) {
+    auto &frame = frames_[frame_id];
+    if (frame.evictable) RemoveLocked(frame_id);
+    frame.history.push_back(current_timestamp_++);
+    if (frame.history.size() > k_) {
+        frame.history.pop_front();
+    }
+    if (frame.evictable) (frame.history.size() < k_ ? cold_ : hot_).insert(Key(frame_id));
+}
+
+/**
+ * @brief 将frame移出cold_或hot_, 不改变evictable
+ */
+void LRUKReplacer::RemoveLocked(frame_id_t frame_id) {
+    (frames_[frame_id].history.size() < k_ ? cold_ : hot_).erase(Key(frame_id));
+}
+
+void LRUKReplacer::RecordAccess(frame_id_t frame_id) {
+    std::scoped_lock lock{latch_};
+    RecordAccessLocked(frame_id);
+}
+
+/**
+ * @brief 移出frame并清除其访问历史, frame之后存放的页面从头开始记录访问
+ */
+void LRUKReplacer::Remove(frame_id_t frame_id) {
+    std::scoped_lock lock{latch_};
+    auto &frame = frames_[frame_id];
+    if (frame.evictable) RemoveLocked(frame_id);
+    frame.evictable = false;
+    frame.history.clear();
+}
+
+/**
+ * @brief 淘汰backward K-distance最大的frame
+ * @note 不清除访问历史: BufferPool可能因为frame正在写回而将其放回replacer, 历史应保持不变;
+ * frame存放新页面时由BufferPool调用Remove清除
+ * @param[out] frame_id id of frame that was removed, nullptr if no victim was found
+ * @return true if a victim frame was found, false otherwise
+ */
+bool LRUKReplacer::Victim(frame_id_t *frame_id) {
+    std::scoped_lock lock{latch_};
+    // +inf的frame优先, 其次是倒数第K次访问最早的frame
+    auto &candidates = cold_.empty() ? hot_ : cold_;
+    if (candidates.empty()) {
+        *frame_id = INVALID_FRAME_ID;
+        return false;
+    }
+    *frame_id = candidates.begin()->second;
+    candidates.erase(candidates.begin());
+    frames_[*frame_id].evictable = false;
+    return true;
+}
+
+/**
+ * @brief 固定frame, 使其不会被淘汰; 不记录访问
+ * @param frame_id the id of the frame to pin
+ */
+void LRUKReplacer::Pin(frame_id_t frame_id) {
+    std::scoped_lock lock{latch_};
+    auto &frame = frames_[frame_id];
+    if (frame.evictable) {
+        RemoveLocked(frame_id);
+        frame.evictable = false;
+    }
+}
+
+/**
+ * @brief 取消固定frame, 按其访问历史加入cold_或hot_
+ * @param frame_id the id of the frame to unpin
+ */
+void LRUKReplacer::Unpin(frame_id_t frame_id) {
+    std::scoped_lock lock{latch_};
+    auto &frame = frames_[frame_id];
+    if (frame.evictable) {
+        return;
+    }
+    // 未经Pin直接Unpin的frame没有访问记录, 以本次Unpin作为第一次访问
+    if (frame.history.empty()) {
+        RecordAccessLocked(frame_id);
+    }
+    frame.evictable = true;
+    (frame.history.size() < k_ ? cold_ : hot_).insert(Key(frame_id));
+}
+
+/** @return replacer中能够victim的数量 */
+size_t LRUKReplacer::Size() {
+    std::scoped_lock lock{latch_};
+    return cold_.size() + hot_.size();
+}
+
+/**
+ * @brief 按淘汰顺序返回replacer中的frame, 不将其移出replacer
+ * @param max_num 最多返回的frame数
+ */
+std::vector<frame_id_t> LRUKReplacer::EvictionCandidates(size_t max_num) {
+    std::scoped_lock lock{latch_};
+    std::vector<frame_id_t> candidates;
+    for (const auto *set : {&cold_, &hot_}) {
+        for (auto it = set->begin(); it != set->end() && candidates.size() < max_num; ++it) {
+            candidates.push_back(it->second);
+        }
+    }
+    return candidates;
+}
@@ -0,0 +1,80 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Rucbase
+//
+// lru_k_replacer.h
+//
+// Identification: src/replacer/lru_k_replacer.h
+//
+// Copyright (c) 2022, RUC Deke Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <deque>
+#include <mutex>  // NOLINT
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "common/config.h"
+#include "replacer/replacer.h"
+
+/**
+ * LRUKReplacer implements the LRU-K replacement policy.
+ *
+ * 每个frame记录最近K次访问的时间戳, 淘汰backward K-distance(当前时间与倒数第K次访问的时间差)最大的frame.
+ * 访问次数不足K次的frame的K-distance视为+inf, 它们之间按最早一次访问的时间戳淘汰(即FIFO).
+ * 因此一次性扫描到的页面(只访问一次)总是先于被反复访问的热点页面被淘汰.
+ * @note 访问由RecordAccess记录, Pin/Unpin只改变frame是否可淘汰, 不改变访问历史;
+ * frame改为存放其他页面或被移出缓冲池时由Remove清除访问历史
+ */
+class LRUKReplacer : public Replacer {
+   public:
+    /**
+     * Create a new LRUKReplacer.
+     * @param num_pages the maximum number of pages the LRUKReplacer will be required to store
+     * @param k the number of historical accesses tracked per frame
+     */
+    explicit LRUKReplacer(size_t num_pages, size_t k = LRUK_REPLACER_K);
+
+    /**
+     * Destroys the LRUKReplacer.
+     */
+    ~LRUKReplacer() override;
+
+    bool Victim(frame_id_t *frame_id) override;
+
+    void Pin(frame_id_t frame_id) override;
+
+    void Unpin(frame_id_t frame_id) override;
+
+    void RecordAccess(frame_id_t frame_id) override;
+
+    void Remove(frame_id_t frame_id) override;
+
+    size_t Size() override;
+
+    std::vector<frame_id_t> EvictionCandidates(size_t max_num) override;
+
+   private:
+    struct FrameInfo {
+        std::deque<size_t> history;  // 最近K次访问的时间戳, 队首为最早的一次
+        bool evictable = false;      // 是否在replacer中(unpinned)
+    };
+
+    /** 访问次数不足K次时按最早访问时间排序, 否则按倒数第K次访问时间排序; 两者都是越小越先淘汰 */
+    std::pair<size_t, frame_id_t> Key(frame_id_t frame_id) const { return {frames_[frame_id].history.front(), frame_id}; }
+
+    void RecordAccessLocked(frame_id_t frame_id);
+
+    void RemoveLocked(frame_id_t frame_id);
+
+    std::mutex latch_;
+    std::vector<FrameInfo> frames_;
+    std::set<std::pair<size_t, frame_id_t>> cold_;  // 可淘汰且访问次数<K的frame
+    std::set<std::pair<size_t, frame_id_t>> hot_;   // 可淘汰且访问次数>=K的frame
+    size_t current_timestamp_{0};
+    size_t k_;
+};
@@ -0,0 +1,178 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Rucbase
+//
+// lru_k_replacer_test.cpp
+//
+// Identification: src/replacer/lru_k_replacer_test.cpp
+//
+// Copyright (c) 2022, RUC Deke Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "replacer/lru_k_replacer.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+/**
+ * @brief 简单测试LRUKReplacer的基本功能
+ */
+TEST(LRUKReplacerTest, SimpleTest) {
+    LRUKReplacer lru_k_replacer(7, 2);
+
+    // Scenario: unpin six elements, each of them has been accessed once.
+    for (int i = 1; i <= 6; i++) {
+        lru_k_replacer.Unpin(i);
+    }
+    // Scenario: access frame 1 again, now it has two accesses and a finite backward 2-distance.
+    lru_k_replacer.Pin(1);
+    lru_k_replacer.RecordAccess(1);
+    lru_k_replacer.Unpin(1);
+    EXPECT_EQ(6, lru_k_replacer.Size());
+
+    // Scenario: frames with +inf distance are evicted first, in FIFO order.
+    int value;
+    EXPECT_EQ(true, lru_k_replacer.Victim(&value));
+    EXPECT_EQ(2, value);
+    EXPECT_EQ(true, lru_k_replacer.Victim(&value));
+    EXPECT_EQ(3, value);
+    EXPECT_EQ(true, lru_k_replacer.Victim(&value));
+    EXPECT_EQ(4, value);
+    EXPECT_EQ(3, lru_k_replacer.Size());
+
+    // Scenario: pin 5, so it cannot be evicted, and it gets its second access.
+    lru_k_replacer.Pin(5);
+    lru_k_replacer.RecordAccess(5);
+    EXPECT_EQ(2, lru_k_replacer.Size());
+    lru_k_replacer.Unpin(5);
+
+    // Scenario: 6 still has +inf distance; 1's second most recent access is older than 5's.
+    EXPECT_EQ(true, lru_k_replacer.Victim(&value));
+    EXPECT_EQ(6, value);
+    EXPECT_EQ(true, lru_k_replacer.Victim(&value));
+    EXPECT_EQ(1, value);
+    EXPECT_EQ(true, lru_k_replacer.Victim(&value));
+    EXPECT_EQ(5, value);
+    EXPECT_EQ(false, lru_k_replacer.Victim(&value));
+    EXPECT_EQ(0, lru_k_replacer.Size());
+}
+
+/**
+ * @brief 一次顺序扫描不应淘汰被反复访问的热点frame
+ */
+TEST(LRUKReplacerTest, ScanResistanceTest) {
+    const int num_hot = 100;
+    const int num_scan = 1000;
+    LRUKReplacer lru_k_replacer(num_hot + num_scan, 2);
+
+    // hot frames: accessed several times
+    for (int r = 0; r < 3; r++) {
+        for (int i = 0; i < num_hot; i++) {
+            lru_k_replacer.Pin(i);
+            lru_k_replacer.RecordAccess(i);
+            lru_k_replacer.Unpin(i);
+        }
+    }
+    // scanned frames: accessed exactly once, after the hot frames
+    for (int i = num_hot; i < num_hot + num_scan; i++) {
+        lru_k_replacer.Pin(i);
+        lru_k_replacer.RecordAccess(i);
+        lru_k_replacer.Unpin(i);
+    }
+
+    int value;
+    for (int i = num_hot; i < num_hot + num_scan; i++) {
+        EXPECT_EQ(true, lru_k_replacer.Victim(&value));
+        EXPECT_EQ(i, value);
+    }
+    for (int i = 0; i < num_hot; i++) {
+        EXPECT_EQ(true, lru_k_replacer.Victim(&value));
+        EXPECT_EQ(i, value);
+    }
+    EXPECT_EQ(false, lru_k_replacer.Victim(&value));
+}
+
+/**
+ * @brief Pin不记录访问; Remove清除访问历史, frame之后存放的页面从头开始记录
+ */
+TEST(LRUKReplacerTest, RemoveTest) {
+    LRUKReplacer lru_k_replacer(3, 2);
+
+    // 1 and 2 both have two accesses; pinning 1 again to take it out of the replacer is not an access
+    for (int i = 1; i <= 2; i++) {
+        lru_k_replacer.RecordAccess(i);
+        lru_k_replacer.RecordAccess(i);
+        lru_k_replacer.Unpin(i);
+    }
+    lru_k_replacer.Pin(1);
+    lru_k_replacer.Unpin(1);
+
+    // 2 now holds another page: its history is gone and it becomes a +inf frame
+    lru_k_replacer.Remove(2);
+    EXPECT_EQ(1, lru_k_replacer.Size());
+    lru_k_replacer.RecordAccess(2);
+    lru_k_replacer.Unpin(2);
+
+    int value;
+    EXPECT_EQ(true, lru_k_replacer.Victim(&value));
+    EXPECT_EQ(2, value);
+    EXPECT_EQ(true, lru_k_replacer.Victim(&value));
+    EXPECT_EQ(1, value);
+
+    // evicting a frame keeps its history, so a frame put back while busy keeps its position
+    lru_k_replacer.Unpin(1);
+    lru_k_replacer.RecordAccess(0);
+    lru_k_replacer.Unpin(0);
+    EXPECT_EQ(true, lru_k_replacer.Victim(&value));
+    EXPECT_EQ(0, value);
+}
+
+/**
+ * @brief 并发测试LRUKReplacer
+ */
+TEST(LRUKReplacerTest, ConcurrencyTest) {
+    const int num_threads = 5;
+    const int num_runs = 50;
+    for (int run = 0; run < num_runs; run++) {
+        int value_size = 1000;
+        std::shared_ptr<LRUKReplacer> lru_k_replacer{new LRUKReplacer(value_size, 2)};
+        std::vector<std::thread> threads;
+        int result;
+        std::vector<int> value(value_size);
+        for (int i = 0; i < value_size; i++) {
+            value[i] = i;
+        }
+        auto rng = std::default_random_engine{};
+        std::shuffle(value.begin(), value.end(), rng);
+
+        for (int tid = 0; tid < num_threads; tid++) {
+            threads.push_back(std::thread([tid, &lru_k_replacer, &value]() {
+                int share = 1000 / 5;
+                for (int i = 0; i < share; i++) {
+                    lru_k_replacer->Pin(value[tid * share + i]);
+                    lru_k_replacer->RecordAccess(value[tid * share + i]);
+                    lru_k_replacer->Unpin(value[tid * share + i]);
+                }
+            }));
+        }
+
+        for (int i = 0; i < num_threads; i++) {
+            threads[i].join();
+        }
+        std::vector<int> out_values;
+        for (int i = 0; i < value_size; i++) {
+            EXPECT_EQ(1, lru_k_replacer->Victim(&result));
+            out_values.push_back(result);
+        }
+        std::sort(value.begin(), value.end());
+        std::sort(out_values.begin(), out_values.end());
+        EXPECT_EQ(value, out_values);
+        EXPECT_EQ(0, lru_k_replacer->Victim(&result));
+    }
+}
@@ -64,3 +64,16 @@ size_t LRUReplacer::Size() {
     // 改写return size
     return LRUlist_.size();
 }
+
+/**
+ * @brief 按淘汰顺序返回replacer中的frame, 不将其移出replacer
+ * @param max_num 最多返回的frame数
+ */
+std::vector<frame_id_t> LRUReplacer::EvictionCandidates(size_t max_num) {
+    std::scoped_lock lock{latch_};
+    std::vector<frame_id_t> candidates;
+    for (auto it = LRUlist_.rbegin(); it != LRUlist_.rend() && candidates.size() < max_num; ++it) {
+        candidates.push_back(*it);
+    }
+    return candidates;
+}
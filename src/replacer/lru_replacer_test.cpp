@@ -167,3 +167,23 @@ TEST(LRUReplacerTest, ConcurrencyTest) {
         EXPECT_EQ(0, lru_replacer->Victim(&result));
     }
 }
+
+/**
+ * @brief EvictionCandidates按淘汰顺序返回frame, 且不影响之后的淘汰
+ */
+TEST(LRUReplacerTest, EvictionCandidatesTest) {
+    LRUReplacer lru_replacer(7);
+    for (int i = 1; i <= 5; i++) {
+        lru_replacer.Unpin(i);
+    }
+    lru_replacer.Pin(2);
+
+    EXPECT_EQ((std::vector<frame_id_t>{1, 3, 4}), lru_replacer.EvictionCandidates(3));
+    EXPECT_EQ((std::vector<frame_id_t>{1, 3, 4, 5}), lru_replacer.EvictionCandidates(10));
+    EXPECT_EQ(4, lru_replacer.Size());
+
+    int value;
+    lru_replacer.Victim(&value);
+    EXPECT_EQ(1, value);
+    EXPECT_EQ((std::vector<frame_id_t>{3, 4, 5}), lru_replacer.EvictionCandidates(10));
+}
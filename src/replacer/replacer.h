@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "common/config.h"
 
 /**
@@ -41,6 +43,29 @@ class Replacer {
      */
     virtual void Unpin(frame_id_t frame_id) = 0;
 
+    /**
+     * Records an access to the page held by a frame. Called only when the page is really fetched,
+     * not when the buffer pool pins a frame just to take it out of the replacer.
+     * Policies without access history ignore it.
+     * @param frame_id the id of the accessed frame
+     */
+    virtual void RecordAccess(frame_id_t frame_id) {}
+
+    /**
+     * Removes a frame from the replacer and forgets its access history.
+     * Called when the frame starts holding another page or is dropped from the buffer pool.
+     * @param frame_id the id of the frame to remove
+     */
+    virtual void Remove(frame_id_t frame_id) { Pin(frame_id); }
+
     /** @return the number of elements in the replacer that can be victimized */
     virtual size_t Size() = 0;
+
+    /**
+     * Returns frames in the order they would be victimized, without removing them from the replacer.
+     * Used by the background page cleaner to write back dirty frames before they are evicted.
+     * @param max_num the maximum number of frames to return
+     * @return at most max_num frames, the next victim first
+     */
+    virtual std::vector<frame_id_t> EvictionCandidates(size_t max_num) = 0;
 };
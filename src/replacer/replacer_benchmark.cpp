@@ -0,0 +1,151 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Rucbase
+//
+// replacer_benchmark.cpp
+//
+// Identification: src/replacer/replacer_benchmark.cpp
+//
+// Copyright (c) 2022, RUC Deke Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <thread>  // NOLINT
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "replacer/clock_replacer.h"
+#include "replacer/lock_free_clock_replacer.h"
+#include "replacer/lru_k_replacer.h"
+#include "replacer/lru_replacer.h"
+
+/**
+ * @brief 用replacer模拟一个num_frames帧的缓冲池, 依次访问trace中的页面, 返回命中率
+ * @note 每次访问等价于BufferPool的一次FetchPage + UnpinPage
+ */
+static double HitRatio(Replacer *replacer, size_t num_frames, const std::vector<int> &trace) {
+    std::unordered_map<int, frame_id_t> page2frame;
+    std::vector<int> frame2page(num_frames, -1);
+    size_t next_free = 0;
+    size_t hits = 0;
+    for (int page : trace) {
+        frame_id_t frame_id;
+        auto it = page2frame.find(page);
+        if (it != page2frame.end()) {
+            hits++;
+            frame_id = it->second;
+        } else {
+            if (next_free < num_frames) {
+                frame_id = static_cast<frame_id_t>(next_free++);
+            } else {
+                EXPECT_EQ(true, replacer->Victim(&frame_id));
+                page2frame.erase(frame2page[frame_id]);
+            }
+            page2frame[page] = frame_id;
+            frame2page[frame_id] = page;
+            replacer->Remove(frame_id);
+        }
+        replacer->Pin(frame_id);
+        replacer->RecordAccess(frame_id);
+        replacer->Unpin(frame_id);
+    }
+    return static_cast<double>(hits) / trace.size();
+}
+
+/**
+ * @brief 点查(集中在少量热点页面, 如B+树内部结点)与大表全表扫描交替进行的访问序列
+ */
+static std::vector<int> MixedTrace(int num_hot, int num_scan, int lookups_per_round, int num_rounds) {
+    std::vector<int> trace;
+    std::default_random_engine rng{15445};
+    std::uniform_int_distribution<int> hot_dist(0, num_hot - 1);
+    for (int round = 0; round < num_rounds; round++) {
+        for (int i = 0; i < lookups_per_round; i++) {
+            trace.push_back(hot_dist(rng));
+        }
+        for (int page = num_hot; page < num_hot + num_scan; page++) {
+            trace.push_back(page);
+        }
+    }
+    return trace;
+}
+
+/**
+ * @brief 比较LRU, CLOCK, LRU-K在扫描与点查混合负载下的命中率
+ */
+TEST(ReplacerBenchmark, HitRatioTest) {
+    const size_t num_frames = 256;
+    const std::vector<int> trace = MixedTrace(200, 2000, 2000, 20);
+
+    double lru = HitRatio(std::make_unique<LRUReplacer>(num_frames).get(), num_frames, trace);
+    double clock = HitRatio(std::make_unique<ClockReplacer>(num_frames).get(), num_frames, trace);
+    double lru_2 = HitRatio(std::make_unique<LRUKReplacer>(num_frames, 2).get(), num_frames, trace);
+    double lru_3 = HitRatio(std::make_unique<LRUKReplacer>(num_frames, 3).get(), num_frames, trace);
+
+    printf("frames: %zu, accesses: %zu\n", num_frames, trace.size());
+    printf("%-8s hit ratio: %.4f\n", "LRU", lru);
+    printf("%-8s hit ratio: %.4f\n", "CLOCK", clock);
+    printf("%-8s hit ratio: %.4f\n", "LRU-2", lru_2);
+    printf("%-8s hit ratio: %.4f\n", "LRU-3", lru_3);
+
+    EXPECT_GT(lru_2, lru);
+    EXPECT_GT(lru_2, clock);
+}
+
+/**
+ * @brief num_threads个线程并发调用replacer, 返回每秒完成的操作数(百万次)
+ * @note 模拟缓冲池命中: 每次操作为对随机帧的Pin + Unpin, 每64次操作做一次Victim + Unpin模拟缺页
+ */
+static double Throughput(Replacer *replacer, size_t num_frames, int num_threads, int ops_per_thread) {
+    for (size_t i = 0; i < num_frames; i++) {
+        replacer->Unpin(static_cast<frame_id_t>(i));
+    }
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([replacer, num_frames, ops_per_thread, t] {
+            std::default_random_engine rng(t);
+            std::uniform_int_distribution<frame_id_t> frame_dist(0, static_cast<frame_id_t>(num_frames) - 1);
+            for (int i = 0; i < ops_per_thread; i++) {
+                frame_id_t frame_id;
+                if (i % 64 == 0 && replacer->Victim(&frame_id)) {
+                    replacer->Unpin(frame_id);
+                    continue;
+                }
+                frame_id = frame_dist(rng);
+                replacer->Pin(frame_id);
+                replacer->Unpin(frame_id);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(num_threads) * ops_per_thread / elapsed.count() / 1e6;
+}
+
+/**
+ * @brief 比较LRU, CLOCK和不加锁的CLOCK在多线程下Pin/Unpin的吞吐量
+ */
+TEST(ReplacerBenchmark, ConcurrentThroughputTest) {
+    const size_t num_frames = 4096;
+    const int ops_per_thread = 200000;
+
+    printf("%-8s %12s %12s %12s\n", "threads", "LRU", "CLOCK", "LF-CLOCK");
+    for (int num_threads : {1, 2, 4, 8}) {
+        double lru = Throughput(std::make_unique<LRUReplacer>(num_frames).get(), num_frames, num_threads, ops_per_thread);
+        double clock =
+            Throughput(std::make_unique<ClockReplacer>(num_frames).get(), num_frames, num_threads, ops_per_thread);
+        auto lock_free = std::make_unique<LockFreeClockReplacer>(num_frames);
+        double lock_free_clock = Throughput(lock_free.get(), num_frames, num_threads, ops_per_thread);
+        printf("%-8d %9.2f M/s %9.2f M/s %9.2f M/s\n", num_threads, lru, clock, lock_free_clock);
+        // 每个帧最终都被Unpin, 都应在replacer中
+        EXPECT_EQ(num_frames, lock_free->Size());
+    }
+}
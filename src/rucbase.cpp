@@ -8,6 +8,7 @@
 #include "errors.h"
 #include "interp.h"
 #include "recovery/log_recovery.h"
+#include "storage/parallel_buffer_pool_manager.h"
 
 #define SOCK_PORT 8765
 #define BUFFER_LENGTH 8192
@@ -15,18 +16,39 @@
 
 static bool should_exit = false;
 
-auto disk_manager = std::make_unique<DiskManager>();
-auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
-auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
-auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
-auto sm_manager =
-    std::make_unique<SmManager>(disk_manager.get(), buffer_pool_manager.get(), rm_manager.get(), ix_manager.get());
-auto ql_manager = std::make_unique<QlManager>(sm_manager.get());
-auto lock_manager = std::make_unique<LockManager>();
-auto txn_manager = std::make_unique<TransactionManager>(lock_manager.get(), sm_manager.get());
-auto log_manager = std::make_unique<LogManager>(disk_manager.get());
-auto interp = std::make_unique<Interp>(sm_manager.get(), ql_manager.get(), txn_manager.get());
-auto recovery = std::make_unique<LogRecovery>(sm_manager.get(), disk_manager.get());
+// 缓冲池的大小等配置在main中解析命令行参数之后才确定, 因此各模块在init_managers中创建
+std::unique_ptr<DiskManager> disk_manager;
+std::unique_ptr<ParallelBufferPoolManager> buffer_pool_manager;
+std::unique_ptr<RmManager> rm_manager;
+std::unique_ptr<IxManager> ix_manager;
+std::unique_ptr<SmManager> sm_manager;
+std::unique_ptr<QlManager> ql_manager;
+std::unique_ptr<LockManager> lock_manager;
+std::unique_ptr<TransactionManager> txn_manager;
+std::unique_ptr<LogManager> log_manager;
+std::unique_ptr<Interp> interp;
+std::unique_ptr<LogRecovery> recovery;
+
+void init_managers() {
+    BufferPoolOptions &options = buffer_pool_options;
+    // 每个分片的帧数相同, 总帧数向下取整到分片数的倍数
+    options.pool_size = options.pool_size / options.num_instances * options.num_instances;
+    disk_manager = std::make_unique<DiskManager>();
+    disk_manager->set_async_io(AsyncIO::Create(options.io_backend, ASYNC_IO_QUEUE_DEPTH, ASYNC_IO_THREADS));
+    buffer_pool_manager = std::make_unique<ParallelBufferPoolManager>(
+        options.num_instances, options.pool_size / options.num_instances, disk_manager.get(), options.enable_cleaner,
+        options.enable_read_ahead);
+    rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+    ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
+    sm_manager =
+        std::make_unique<SmManager>(disk_manager.get(), buffer_pool_manager.get(), rm_manager.get(), ix_manager.get());
+    ql_manager = std::make_unique<QlManager>(sm_manager.get());
+    lock_manager = std::make_unique<LockManager>();
+    txn_manager = std::make_unique<TransactionManager>(lock_manager.get(), sm_manager.get());
+    log_manager = std::make_unique<LogManager>(disk_manager.get());
+    interp = std::make_unique<Interp>(sm_manager.get(), ql_manager.get(), txn_manager.get());
+    recovery = std::make_unique<LogRecovery>(sm_manager.get(), disk_manager.get());
+}
 
 static jmp_buf jmpbuf;
 void sigint_handler(int signo) {
@@ -182,10 +204,18 @@ void start_server() {
 }
 
 int main(int argc, char **argv) {
-    if (argc != 2) {
-        std::cerr << "Usage: " << argv[0] << " <database>" << std::endl;
+    std::vector<std::string> args;
+    try {
+        args = buffer_pool_options.ParseArgs(argc, argv);
+    } catch (RedBaseError &e) {
+        std::cerr << e.what() << std::endl;
+        args.clear();
+    }
+    if (args.size() != 1) {
+        std::cerr << "Usage: " << argv[0] << " [--config=<file>] [--<option>=<value> ...] <database>" << std::endl;
         exit(1);
     }
+    init_managers();
 
     signal(SIGINT, sigint_handler);
     try {
@@ -199,8 +229,9 @@ int main(int argc, char **argv) {
                      "Welcome to RUC Database !\n"
                      "Type 'help;' for help.\n"
                      "\n";
+        std::cout << "Buffer pool configuration:\n" << buffer_pool_options.ToString() << std::endl;
         // Database name is passed by args
-        std::string db_name = argv[1];
+        std::string db_name = args[0];
         if (!sm_manager->is_dir(db_name)) {
             // Database not found, create a new one
             sm_manager->create_db(db_name);
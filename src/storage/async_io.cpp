@@ -0,0 +1,374 @@
+#include "async_io.h"
+
+#include <linux/io_uring.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>  // for IOV_MAX
+#include <cstring>
+#include <thread>  // NOLINT
+#include <unordered_set>
+#include <vector>
+
+#include "errors.h"
+
+void IOBatch::AddRead(int fd, page_id_t start_page_no, char *const *bufs, int num_pages) {
+    Add(IOOpType::READ, fd, start_page_no, bufs, num_pages);
+}
+
+void IOBatch::AddWrite(int fd, page_id_t start_page_no, const char *const *bufs, int num_pages) {
+    Add(IOOpType::WRITE, fd, start_page_no, const_cast<char *const *>(bufs), num_pages);
+}
+
+/**
+ * @brief 添加请求, 超过IOV_MAX个页面时拆分为多个请求
+ */
+void IOBatch::Add(IOOpType op, int fd, page_id_t start_page_no, char *const *bufs, int num_pages) {
+    for (int done = 0; done < num_pages;) {
+        int count = std::min(num_pages - done, IOV_MAX);
+        IORequest &request = requests_.emplace_back();
+        request.op = op;
+        request.fd = fd;
+        request.start_page_no = start_page_no + done;
+        request.num_pages = count;
+        request.iov.resize(count);
+        for (int i = 0; i < count; i++) {
+            request.iov[i].iov_base = bufs[done + i];
+            request.iov[i].iov_len = PAGE_SIZE;
+        }
+        request.batch = this;
+        done += count;
+    }
+}
+
+void IOBatch::Wait() {
+    std::unique_lock lock{latch_};
+    cv_.wait(lock, [this] { return pending_ == 0; });
+}
+
+void IOBatch::Complete(IORequest *request, ssize_t result) {
+    request->result = result;
+    std::scoped_lock lock{latch_};
+    if (--pending_ == 0) cv_.notify_all();
+}
+
+void AsyncIO::Submit(IOBatch *batch) {
+    if (batch->requests_.empty()) return;
+    {
+        std::scoped_lock lock{batch->latch_};
+        batch->pending_ = batch->requests_.size();
+    }
+    SubmitRequests(&batch->requests_);
+}
+
+/**
+ * @brief 用preadv/pwritev同步执行一个请求
+ * @return 读写的字节数, 失败时为-errno
+ */
+static ssize_t ExecuteRequest(const IORequest &request) {
+    off_t off = static_cast<off_t>(request.start_page_no) * PAGE_SIZE;
+    int count = static_cast<int>(request.iov.size());
+    ssize_t bytes = request.op == IOOpType::READ ? preadv(request.fd, request.iov.data(), count, off)
+                                                 : pwritev(request.fd, request.iov.data(), count, off);
+    return bytes < 0 ? -errno : bytes;
+}
+
+/**
+ * @brief 用线程池执行请求
+ */
+class ThreadPoolAsyncIO : public AsyncIO {
+   public:
+    explicit ThreadPoolAsyncIO(size_t num_threads) {
+        for (size_t i = 0; i < std::max<size_t>(num_threads, 1); i++) {
+            workers_.emplace_back([this] { Work(); });
+        }
+    }
+
+    ~ThreadPoolAsyncIO() override {
+        {
+            std::scoped_lock lock{latch_};
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (auto &worker : workers_) {
+            worker.join();
+        }
+    }
+
+    const char *Name() const override { return "threads"; }
+
+   protected:
+    void SubmitRequests(std::deque<IORequest> *requests) override {
+        {
+            std::scoped_lock lock{latch_};
+            for (auto &request : *requests) {
+                queue_.push_back(&request);
+            }
+        }
+        cv_.notify_all();
+    }
+
+   private:
+    /** @brief 工作线程, 退出前执行完队列中剩余的请求 */
+    void Work() {
+        std::unique_lock lock{latch_};
+        while (true) {
+            cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+            if (queue_.empty()) return;
+            IORequest *request = queue_.front();
+            queue_.pop_front();
+            lock.unlock();
+            Complete(request, ExecuteRequest(*request));
+            lock.lock();
+        }
+    }
+
+    std::mutex latch_;
+    std::condition_variable cv_;
+    std::deque<IORequest *> queue_;
+    bool stop_ = false;
+    std::vector<std::thread> workers_;
+};
+
+/**
+ * @brief 基于io_uring的实现, 直接使用系统调用, 不依赖liburing
+ * @note 提交线程在latch_下填写提交队列并调用io_uring_enter; 收割线程阻塞等待完成事件, 逐个结束对应的请求.
+ * 正在进行的请求数不超过完成队列的长度, 完成队列不会溢出. 析构时提交一个user_data为0的NOP通知收割线程退出.
+ * @note 收割线程的io_uring_enter因EINTR以外的原因失败时, 以该错误结束所有未完成的请求并退出;
+ * 之后提交的请求在提交线程中用preadv/pwritev同步执行
+ */
+class IoUringAsyncIO : public AsyncIO {
+   public:
+    /**
+     * @throw UnixError 内核不支持io_uring或被禁用
+     */
+    explicit IoUringAsyncIO(unsigned entries) {
+        io_uring_params params;
+        memset(&params, 0, sizeof(params));
+        ring_fd_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (ring_fd_ < 0) throw UnixError();
+        sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap) sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+        sq_ring_ = Map(sq_ring_size_, IORING_OFF_SQ_RING);
+        cq_ring_ = single_mmap ? sq_ring_ : Map(cq_ring_size_, IORING_OFF_CQ_RING);
+        sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe *>(Map(sqes_size_, IORING_OFF_SQES));
+
+        char *sq = static_cast<char *>(sq_ring_);
+        sq_head_ = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+        sq_tail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+        sq_mask_ = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+        sq_entries_ = params.sq_entries;
+        char *cq = static_cast<char *>(cq_ring_);
+        cq_head_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+        cq_entries_ = params.cq_entries;
+
+        reaper_ = std::thread([this] { Reap(); });
+    }
+
+    ~IoUringAsyncIO() override {
+        if (reaper_.joinable()) {
+            std::unique_lock lock{latch_};
+            io_uring_sqe *sqe = failed_ ? nullptr : GetSqe(lock);
+            if (sqe != nullptr) {
+                sqe->opcode = IORING_OP_NOP;
+                sqe->user_data = 0;
+                SubmitPending();
+            }
+            lock.unlock();
+            reaper_.join();
+        }
+        Unmap();
+    }
+
+    const char *Name() const override { return "io_uring"; }
+
+   protected:
+    void SubmitRequests(std::deque<IORequest> *requests) override {
+        std::unique_lock lock{latch_};
+        for (auto &request : *requests) {
+            io_uring_sqe *sqe = GetSqe(lock);
+            if (sqe == nullptr) {
+                // 收割线程已退出, 同步执行
+                lock.unlock();
+                Complete(&request, ExecuteRequest(request));
+                lock.lock();
+                continue;
+            }
+            pending_.insert(&request);
+            sqe->opcode = request.op == IOOpType::READ ? IORING_OP_READV : IORING_OP_WRITEV;
+            sqe->fd = request.fd;
+            sqe->off = static_cast<uint64_t>(request.start_page_no) * PAGE_SIZE;
+            sqe->addr = reinterpret_cast<uint64_t>(request.iov.data());
+            sqe->len = static_cast<uint32_t>(request.iov.size());
+            sqe->user_data = reinterpret_cast<uint64_t>(&request);
+        }
+        SubmitPending();
+    }
+
+   private:
+    void *Map(size_t size, off_t offset) {
+        void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, offset);
+        if (ptr == MAP_FAILED) {
+            int saved_errno = errno;
+            Unmap();
+            errno = saved_errno;
+            throw UnixError();
+        }
+        return ptr;
+    }
+
+    void Unmap() {
+        if (sqes_ != nullptr) munmap(sqes_, sqes_size_);
+        if (cq_ring_ != nullptr && cq_ring_ != sq_ring_) munmap(cq_ring_, cq_ring_size_);
+        if (sq_ring_ != nullptr) munmap(sq_ring_, sq_ring_size_);
+        if (ring_fd_ >= 0) close(ring_fd_);
+        sqes_ = nullptr;
+        cq_ring_ = sq_ring_ = nullptr;
+        ring_fd_ = -1;
+    }
+
+    int Enter(unsigned to_submit, unsigned min_complete, unsigned flags) {
+        return static_cast<int>(syscall(__NR_io_uring_enter, ring_fd_, to_submit, min_complete, flags, nullptr, 0));
+    }
+
+    /**
+     * @brief 取得下一个提交队列项并清零, 正在进行的请求达到完成队列长度时先等待
+     * @param lock 已持有的latch_, 等待期间释放
+     * @return 收割线程已因错误退出时返回nullptr
+     */
+    io_uring_sqe *GetSqe(std::unique_lock<std::mutex> &lock) {
+        if (failed_) return nullptr;
+        if (in_flight_ >= cq_entries_) {
+            // 等待之前先提交已填写的项, 否则它们永远不会完成
+            SubmitPending();
+            space_cv_.wait(lock, [this] { return failed_ || in_flight_ < cq_entries_; });
+            if (failed_) return nullptr;
+        }
+        unsigned tail = *sq_tail_;
+        if (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) == sq_entries_) SubmitPending();
+        unsigned index = tail & sq_mask_;
+        io_uring_sqe *sqe = &sqes_[index];
+        memset(sqe, 0, sizeof(*sqe));
+        sq_array_[index] = index;
+        __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+        to_submit_++;
+        in_flight_++;
+        return sqe;
+    }
+
+    /** @brief 提交已填写的提交队列项, 调用者持有latch_ */
+    void SubmitPending() {
+        while (to_submit_ > 0) {
+            int ret = Enter(to_submit_, 0, 0);
+            if (ret < 0) {
+                if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+                    sched_yield();
+                    continue;
+                }
+                throw UnixError();
+            }
+            to_submit_ -= static_cast<unsigned>(ret);
+        }
+    }
+
+    /** @brief 收割线程, 收到user_data为0的完成事件, 或io_uring_enter持续失败时退出 */
+    void Reap() {
+        bool stop = false;
+        std::vector<std::pair<IORequest *, ssize_t>> completed;
+        while (!stop) {
+            // 被信号中断时直接检查完成队列即可; 其他错误不会自行恢复, 重试只会空转
+            if (Enter(0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+                FailPending(-errno);
+                return;
+            }
+            unsigned head = *cq_head_;
+            unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+            unsigned num_completed = tail - head;
+            completed.clear();
+            for (; head != tail; head++) {
+                io_uring_cqe *cqe = &cqes_[head & cq_mask_];
+                if (cqe->user_data == 0) {
+                    stop = true;
+                } else {
+                    completed.emplace_back(reinterpret_cast<IORequest *>(cqe->user_data), cqe->res);
+                }
+            }
+            __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+            if (num_completed > 0) {
+                {
+                    std::scoped_lock lock{latch_};
+                    in_flight_ -= num_completed;
+                    for (auto &entry : completed) pending_.erase(entry.first);
+                }
+                space_cv_.notify_all();
+            }
+            for (auto &entry : completed) Complete(entry.first, entry.second);
+        }
+    }
+
+    /**
+     * @brief 以错误码error结束所有已填写但尚未完成的请求, 之后的请求由提交线程同步执行
+     */
+    void FailPending(ssize_t error) {
+        std::unordered_set<IORequest *> requests;
+        {
+            std::scoped_lock lock{latch_};
+            failed_ = true;
+            requests.swap(pending_);
+            in_flight_ = 0;
+            to_submit_ = 0;
+        }
+        space_cv_.notify_all();
+        for (IORequest *request : requests) Complete(request, error);
+    }
+
+    int ring_fd_ = -1;
+    void *sq_ring_ = nullptr;
+    void *cq_ring_ = nullptr;
+    io_uring_sqe *sqes_ = nullptr;
+    size_t sq_ring_size_ = 0;
+    size_t cq_ring_size_ = 0;
+    size_t sqes_size_ = 0;
+
+    unsigned *sq_head_;
+    unsigned *sq_tail_;
+    unsigned sq_mask_;
+    unsigned *sq_array_;
+    unsigned sq_entries_;
+    unsigned *cq_head_;
+    unsigned *cq_tail_;
+    unsigned cq_mask_;
+    io_uring_cqe *cqes_;
+    unsigned cq_entries_;
+
+    /** 保护提交队列和以下计数 */
+    std::mutex latch_;
+    std::condition_variable space_cv_;
+    unsigned to_submit_ = 0;  // 已填写但尚未提交的项数
+    unsigned in_flight_ = 0;  // 已填写但尚未完成的项数
+    std::unordered_set<IORequest *> pending_;  // 已填写但尚未完成的请求, 收割线程出错时以错误结束
+    bool failed_ = false;                      // 收割线程已因io_uring_enter出错退出
+    std::thread reaper_;
+};
+
+std::unique_ptr<AsyncIO> AsyncIO::Create(const std::string &backend, size_t queue_depth, size_t num_threads) {
+    if (backend == "io_uring") {
+        try {
+            return std::make_unique<IoUringAsyncIO>(static_cast<unsigned>(queue_depth));
+        } catch (RedBaseError &e) {
+            // 内核不支持或被seccomp等禁用io_uring时退回到线程池
+        }
+    }
+    return std::make_unique<ThreadPoolAsyncIO>(num_threads);
+}
@@ -0,0 +1,115 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Rucbase
+//
+// async_io.h
+//
+// Identification: src/storage/async_io.h
+//
+// Copyright (c) 2022, RUC Deke Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <sys/types.h>
+#include <sys/uio.h>  // for iovec
+
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "common/macros.h"
+
+class IOBatch;
+
+enum class IOOpType { READ, WRITE };
+
+/**
+ * @brief 一个读写请求: 文件fd中从start_page_no开始的连续num_pages个页面, 每个页面的内存不要求相邻
+ */
+struct IORequest {
+    IOOpType op;
+    int fd;
+    page_id_t start_page_no;
+    int num_pages;
+    std::vector<iovec> iov;
+    ssize_t result = 0;  // 完成后为读写的字节数, 失败时为-errno
+    IOBatch *batch = nullptr;
+
+    /** @return 完整读写的页面数 */
+    int PagesDone() const { return result < 0 ? 0 : static_cast<int>(result / PAGE_SIZE); }
+};
+
+/**
+ * @brief 一起提交并等待完成的一组读写请求
+ * @note 添加完所有请求后由AsyncIO::Submit提交, 之后调用Wait等待全部完成, 再检查每个请求的result
+ */
+class IOBatch {
+   public:
+    IOBatch() = default;
+
+    DISALLOW_COPY(IOBatch);
+
+    /** @brief 添加读请求, bufs中每个页面各PAGE_SIZE字节 */
+    void AddRead(int fd, page_id_t start_page_no, char *const *bufs, int num_pages);
+
+    /** @brief 添加写请求, bufs中每个页面各PAGE_SIZE字节 */
+    void AddWrite(int fd, page_id_t start_page_no, const char *const *bufs, int num_pages);
+
+    std::deque<IORequest> &Requests() { return requests_; }
+
+    bool Empty() const { return requests_.empty(); }
+
+    /** @brief 等待所有已提交的请求完成 */
+    void Wait();
+
+   private:
+    friend class AsyncIO;
+
+    void Add(IOOpType op, int fd, page_id_t start_page_no, char *const *bufs, int num_pages);
+
+    void Complete(IORequest *request, ssize_t result);
+
+    /** 提交后请求的地址不能改变, 因此用deque */
+    std::deque<IORequest> requests_;
+    std::mutex latch_;
+    std::condition_variable cv_;
+    size_t pending_ = 0;
+};
+
+/**
+ * @brief 异步I/O引擎, 提交一批读写请求后立即返回, 由IOBatch::Wait等待完成
+ * @note 有两种实现: io_uring一次系统调用提交整批请求, 由一个线程收取完成事件; 内核不支持或被禁用io_uring时,
+ * 退回到用preadv/pwritev执行请求的线程池. 两者都可以被多个线程同时使用.
+ */
+class AsyncIO {
+   public:
+    virtual ~AsyncIO() = default;
+
+    /**
+     * @brief 提交batch中的所有请求, 不等待完成; 每个batch只能提交一次
+     */
+    void Submit(IOBatch *batch);
+
+    /** @return 实现的名称, "io_uring"或"threads" */
+    virtual const char *Name() const = 0;
+
+    /**
+     * @brief 创建异步I/O引擎
+     * @param backend "io_uring"或"threads"; 无法创建io_uring时退回到线程池
+     * @param queue_depth io_uring的提交队列长度
+     * @param num_threads 线程池的线程数
+     */
+    static std::unique_ptr<AsyncIO> Create(const std::string &backend, size_t queue_depth, size_t num_threads);
+
+   protected:
+    /** @brief 提交请求, 每个请求完成后调用Complete */
+    virtual void SubmitRequests(std::deque<IORequest> *requests) = 0;
+
+    static void Complete(IORequest *request, ssize_t result) { request->batch->Complete(request, result); }
+};
@@ -0,0 +1,87 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Rucbase
+//
+// buffer_access_strategy.h
+//
+// Identification: src/storage/buffer_access_strategy.h
+//
+// Copyright (c) 2022, RUC Deke Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <mutex>  // NOLINT
+#include <unordered_map>
+#include <vector>
+
+#include "buffer_pool_manager.h"
+#include "common/macros.h"
+
+class BufferPoolManagerInstance;
+
+/**
+ * @brief 大表顺序扫描使用的缓冲区访问策略
+ * @note 通过该策略FetchPage缺页时, 缓冲池从一个很小的私有环形帧队列(ring)中循环复用帧,
+ * 而不是从free_list_/replacer中取帧; ring中的帧解除固定后也不会进入replacer.
+ * 因此一次全表扫描最多占用ring_size个帧, 不会把其他查询的热点页面挤出缓冲池.
+ * @note 一个策略对象只应由一个扫描(线程)使用, 析构时将ring中的帧归还给缓冲池
+ */
+class BufferAccessStrategy {
+    friend class BufferPoolManagerInstance;
+
+   public:
+    explicit BufferAccessStrategy(BufferPoolManager *bpm, size_t ring_size = SCAN_RING_SIZE)
+        : bpm_(bpm), ring_size_(ring_size) {}
+
+    ~BufferAccessStrategy() { bpm_->ReleaseAccessStrategy(this); }
+
+    DISALLOW_COPY(BufferAccessStrategy);
+
+    /**
+     * @brief 扫描的页面数超过缓冲池的1/4时才需要使用ring, 小表的扫描仍然正常缓存
+     */
+    static bool IsLargeScan(BufferPoolManager *bpm, int num_pages) {
+        return static_cast<size_t>(num_pages) > bpm->GetPoolSize() / 4;
+    }
+
+   private:
+    struct Ring {
+        std::vector<frame_id_t> frames;  // ring中的帧, 不超过ring_size_个
+        size_t current = 0;              // 下一个被复用的槽位
+    };
+
+    /**
+     * @brief 取得分片bpm的ring, 不存在时创建
+     * @note 扫描线程和共用的预读线程可能同时在不同分片的latch_下调用, rings_本身由rings_latch_保护;
+     * unordered_map插入时不会使已有元素的引用失效, 返回的Ring由对应分片的latch_保护
+     */
+    Ring &GetRing(BufferPoolManagerInstance *bpm) {
+        std::scoped_lock lock{rings_latch_};
+        return rings_[bpm];
+    }
+
+    /**
+     * @brief 取得分片bpm的ring, 不存在时返回nullptr
+     */
+    Ring *FindRing(BufferPoolManagerInstance *bpm) {
+        std::scoped_lock lock{rings_latch_};
+        auto it = rings_.find(bpm);
+        return it == rings_.end() ? nullptr : &it->second;
+    }
+
+    /**
+     * @brief 删除分片bpm的ring, 调用者持有该分片的latch_
+     */
+    void EraseRing(BufferPoolManagerInstance *bpm) {
+        std::scoped_lock lock{rings_latch_};
+        rings_.erase(bpm);
+    }
+
+    BufferPoolManager *bpm_;
+    size_t ring_size_;
+    std::mutex rings_latch_;  // 保护rings_的查找, 插入和删除
+    /** 每个缓冲池分片各自的ring; 容器由rings_latch_保护, 各Ring只在对应分片的latch_保护下访问 */
+    std::unordered_map<BufferPoolManagerInstance *, Ring> rings_;
+};
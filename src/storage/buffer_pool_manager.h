@@ -35,78 +35,57 @@
 #include "disk_manager.h"
 #include "errors.h"
 #include "page.h"
-#include "replacer/clock_replacer.h"
-#include "replacer/lru_replacer.h"
-#include "replacer/replacer.h"
 
-class BufferPoolManager {
-   private:
-    /**
-     * @brief Number of pages in the buffer pool.
-     */
-    size_t pool_size_;
-    /**
-     * @brief BufferPool中的Page对象数组(指针)
-     * @note 在构造函数中申请内存空间,折构函数中释放,大小为BUFFER_POOL_SIZE
-     */
-    Page *pages_;
-    /**
-     * @brief 以自定义PageIdHash为哈希函数的<PageId,frame_id_t>哈希表.
-     * @note 用于根据PageId定位其在BufferPool中的frame_id_t
-     */
-    std::unordered_map<PageId, frame_id_t, PageIdHash> page_table_;
-    /**
-     * @brief BufferPool空闲帧的id构成的链表
-     */
-    std::list<frame_id_t> free_list_;
-    /** 上层传入disk_manager */
-    DiskManager *disk_manager_;
-
-    /**
-     * @brief BufferPool页面替换策略类
-     *
-     */
-    Replacer *replacer_;
-
-    /** This latch protects shared data structures */
-    std::mutex latch_;
+class BufferAccessStrategy;
+
+/**
+ * @brief 缓冲池的统计计数
+ * @note 干净页淘汰占比越高, 前台查询在缺页时需要同步写回脏页的次数就越少
+ */
+struct BufferPoolStats {
+    size_t evictions = 0;        // 淘汰已缓存页面的次数
+    size_t clean_evictions = 0;  // 其中被淘汰的页面为干净页, 无需写回的次数
+    size_t cleaner_writes = 0;   // 后台写回线程写回的脏页数
+    size_t prefetched_pages = 0; // 预读线程读入的页面数
+    size_t prefetch_hits = 0;    // 其中之后被访问到的页面数
+    size_t quota_evictions = 0;  // 因文件超出配额而优先淘汰其页面的次数
+    size_t compressed_hits = 0;  // 缺页时在压缩缓存中命中, 无需读磁盘的次数
+    size_t mapped_reads = 0;     // 缺页时直接使用只读文件的内存映射, 无需复制的次数
+
+    BufferPoolStats &operator+=(const BufferPoolStats &other) {
+        evictions += other.evictions;
+        clean_evictions += other.clean_evictions;
+        cleaner_writes += other.cleaner_writes;
+        prefetched_pages += other.prefetched_pages;
+        prefetch_hits += other.prefetch_hits;
+        quota_evictions += other.quota_evictions;
+        compressed_hits += other.compressed_hits;
+        mapped_reads += other.mapped_reads;
+        return *this;
+    }
+};
 
+/**
+ * @brief BufferPoolManager的抽象接口
+ * @note 上层(RmFileHandle, IxIndexHandle, SmManager等)只通过该接口访问缓冲池,
+ * 具体实现为单latch的BufferPoolManagerInstance和按PageId分片的ParallelBufferPoolManager
+ */
+class BufferPoolManager {
    public:
-    BufferPoolManager(size_t pool_size, DiskManager *disk_manager)
-        : pool_size_(pool_size), disk_manager_(disk_manager) {
-        // We allocate a consecutive memory space for the buffer pool.
-        pages_ = new Page[pool_size_];
-        // can be changed to ClockReplacer
-        if (REPLACER_TYPE.compare("LRU"))
-            replacer_ = new LRUReplacer(pool_size_);
-        else if (REPLACER_TYPE.compare("CLOCK"))
-            replacer_ = new ClockReplacer(pool_size_);
-        else {
-            LOG_WARN("BufferPoolManager Replacer type defined wrong, use LRU as replacer.\n");
-            replacer_ = new LRUReplacer(pool_size_);
-        }
-        // Initially, every page is in the free list.
-        for (size_t i = 0; i < pool_size_; ++i) {
-            free_list_.emplace_back(static_cast<frame_id_t>(i));  // static_cast转换数据类型
-        }
-    }
+    BufferPoolManager() = default;
 
-    /**
-     * @brief Destroy the Buffer Pool object
-     *
-     */
-    ~BufferPoolManager() {
-        delete[] pages_;
-        delete replacer_;
-    }
+    virtual ~BufferPoolManager() = default;
+
+    /** @return size of the buffer pool */
+    virtual size_t GetPoolSize() = 0;
 
-   public:
     /**
      * Fetch the requested page from the buffer pool.
      * @param page_id id of page to be fetched
+     * @param strategy 缺页时使用的访问策略, nullptr表示正常从free_list_/replacer中取帧
      * @return the requested page
      */
-    Page *FetchPage(PageId page_id);
+    virtual Page *FetchPage(PageId page_id, BufferAccessStrategy *strategy = nullptr) = 0;
 
     /**
      * Unpin the target page from the buffer pool.
@@ -114,36 +93,86 @@ class BufferPoolManager {
      * @param is_dirty true if the page should be marked as dirty, false otherwise
      * @return false if the page pin count is <= 0 before this call, true otherwise
      */
-    bool UnpinPage(PageId page_id, bool is_dirty);
+    virtual bool UnpinPage(PageId page_id, bool is_dirty) = 0;
 
     /**
      * Flushes the target page to disk.
      * @param page_id id of page to be flushed, cannot be INVALID_PAGE_ID
      * @return false if the page could not be found in the page table, true otherwise
      */
-    bool FlushPage(PageId page_id);
+    virtual bool FlushPage(PageId page_id) = 0;
 
     /**
      * Creates a new page in the buffer pool.
      * @param[out] page_id id of created page
      * @return nullptr if no new pages could be created, otherwise pointer to new page
      */
-    Page *NewPage(PageId *page_id);
+    virtual Page *NewPage(PageId *page_id) = 0;
 
     /**
      * Deletes a page from the buffer pool.
      * @param page_id id of page to be deleted
      * @return false if the page exists but could not be deleted, true if the page didn't exist or deletion succeeded
      */
-    bool DeletePage(PageId page_id);
+    virtual bool DeletePage(PageId page_id) = 0;
 
     /**
      * Flushes all the pages in the buffer pool to disk.
      */
-    void FlushAllPages(int fd);
+    virtual void FlushAllPages(int fd) = 0;
 
-   private:
-    bool FindVictimPage(frame_id_t *frame_id);
+    /**
+     * @brief 将strategy的ring中的帧归还给缓冲池, 由BufferAccessStrategy析构时调用
+     */
+    virtual void ReleaseAccessStrategy(BufferAccessStrategy *strategy) = 0;
 
-    void UpdatePage(Page *page, PageId new_page_id, frame_id_t new_frame_id);
-};
\ No newline at end of file
+    /**
+     * @brief 提示缓冲池异步预读[start.page_no, start.page_no + num_pages), 不保证一定读入
+     * @param strategy 读入页面时使用的访问策略, 与之后访问这些页面的FetchPage一致
+     */
+    virtual void Prefetch(PageId start, int num_pages, BufferAccessStrategy *strategy = nullptr) = 0;
+
+    /** @return 缓冲池的统计计数 */
+    virtual BufferPoolStats GetStats() = 0;
+
+    /**
+     * @brief 丢弃文件fd上尚未完成的预读请求, 并等待正在进行的fd上的预读结束
+     * @note 关闭文件前调用, 避免预读线程读取已关闭(或被复用)的fd
+     */
+    virtual void CancelPrefetch(int fd) = 0;
+
+    /**
+     * @brief 丢弃文件fd在压缩缓存中的页面
+     * @note 关闭文件前调用, 避免fd被复用后读到旧文件的页面
+     */
+    virtual void DropCompressedPages(int fd) = 0;
+
+    /**
+     * @brief 按replacer中的访问新旧顺序列出缓冲池中的页面, 最近访问的在前
+     * @note 被固定的页面视为最近访问; 扫描ring中的帧不计入. 用于关闭数据库时保存热点页面, 重启后预热缓冲池
+     */
+    virtual std::vector<PageId> GetResidentPages() = 0;
+
+    /**
+     * @brief 在线调整缓冲池的帧数, 其他线程可以同时访问缓冲池
+     * @note 缩容时先写回并丢弃被移出的帧中未被固定的页面, 仍被固定的帧可能使实际帧数大于new_size
+     * @return 调整后的帧数
+     */
+    virtual size_t Resize(size_t new_size) = 0;
+
+    /**
+     * @brief 设置文件fd在缓冲池中最多占用的帧数, 超出配额的文件的页面被优先淘汰
+     * @param max_frames 帧数配额, 0表示取消配额
+     * @note 关闭文件前取消配额, 避免被之后复用该fd的文件继承
+     */
+    virtual void SetFileQuota(int fd, size_t max_frames) = 0;
+
+    /** @return 文件fd的页面当前占用的帧数 */
+    virtual size_t GetFileFrames(int fd) = 0;
+
+    /**
+     * @brief 丢弃文件fd在缓冲池中的所有页面, 包括仍被固定的页面
+     * @note 关闭文件时在FlushAllPages之后调用, 释放被占用的帧, 也避免fd被复用后命中旧文件的页面
+     */
+    virtual void DiscardPages(int fd) = 0;
+};
@@ -0,0 +1,954 @@
+#include "buffer_pool_manager_instance.h"
+
+#include <algorithm>
+
+/**
+ * @brief 从free_list或replacer中得到可淘汰帧页的 *frame_id
+ * @note replacer选出的帧可能正由后台写回线程写回, 或正在被Resize移出缓冲池, 此时跳过该帧并在选出victim后将其放回replacer.
+ * 有文件超出配额时优先淘汰该文件的页面, 见FindOverQuotaVictim. 查找过程中不释放latch_, 调用者在页表中的查找结果仍然有效
+ *
+ * @param frame_id 帧页id指针,返回成功找到的可替换帧id
+ * @return true: 可替换帧查找成功 , false: 可替换帧查找失败
+ */
+bool BufferPoolManagerInstance::FindVictimPage(frame_id_t *frame_id) {
+    // Todo:
+    // 1 使用BufferPoolManager::free_list_判断缓冲池是否已满需要淘汰页面
+    // 1.1 未满获得frame
+    // 1.2 已满使用lru_replacer中的方法选择淘汰页面
+    while(!free_list_.empty()) {
+        *frame_id = free_list_.front();
+        free_list_.pop_front();
+        // 正在被Resize移出的帧丢弃即可, 缩容结束时重新整理free_list_
+        if(static_cast<size_t>(*frame_id) < frame_limit_) return true;
+    }
+    if(FindOverQuotaVictim(frame_id)) return true;
+    std::vector<frame_id_t> busy_frames;
+    bool found = false;
+    while(replacer_->Victim(frame_id)) {
+        if(!GetFramePage(*frame_id)->io_in_progress_ && static_cast<size_t>(*frame_id) < frame_limit_) {
+            found = true;
+            break;
+        }
+        busy_frames.push_back(*frame_id);
+    }
+    for(frame_id_t busy_frame : busy_frames) replacer_->Unpin(busy_frame);
+    return found;
+}
+
+/**
+ * @brief 在replacer淘汰端的QUOTA_SCAN_DEPTH个候选帧中查找属于超出配额的文件的帧
+ * @note 只有存在超出配额的文件时才查找; 找到时将其从replacer中移除, 该文件的页面先于更早访问的其他页面被淘汰
+ *
+ * @param frame_id 返回找到的帧
+ * @return true: 找到, false: 没有超出配额的文件, 或其页面都不在淘汰端附近
+ */
+bool BufferPoolManagerInstance::FindOverQuotaVictim(frame_id_t *frame_id) {
+    auto over_quota = [this](int fd) {
+        auto quota = file_quotas_.find(fd);
+        if(quota == file_quotas_.end()) return false;
+        auto frames = file_frames_.find(fd);
+        return frames != file_frames_.end() && frames->second > quota->second;
+    };
+    bool any_over_quota = false;
+    for(auto &entry : file_quotas_) any_over_quota = any_over_quota || over_quota(entry.first);
+    if(!any_over_quota) return false;
+    for(frame_id_t candidate : replacer_->EvictionCandidates(QUOTA_SCAN_DEPTH)) {
+        Page *page = GetFramePage(candidate);
+        if(page->io_in_progress_ || static_cast<size_t>(candidate) >= frame_limit_ || !over_quota(page->id_.fd)) {
+            continue;
+        }
+        replacer_->Remove(candidate);
+        stats_.quota_evictions++;
+        *frame_id = candidate;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 修改帧映射的页面, 同时维护每个文件占用的帧数
+ * @param page_id 新的页面, page_no为INVALID_PAGE_ID表示帧不再映射任何页面
+ */
+void BufferPoolManagerInstance::SetFramePageId(Page *page, PageId page_id) {
+    if(page->id_.page_no != INVALID_PAGE_ID) {
+        auto it = file_frames_.find(page->id_.fd);
+        if(--it->second == 0) file_frames_.erase(it);
+    }
+    page->id_ = page_id;
+    if(page_id.page_no != INVALID_PAGE_ID) file_frames_[page_id.fd]++;
+}
+
+/**
+ * @brief 为缺页的页面取得一个帧: 有strategy时优先复用其ring中的帧, 否则从free_list_/replacer中取帧
+ *
+ * @param strategy 访问策略, 可以为nullptr
+ * @param frame_id 返回取得的帧
+ * @return true: 取帧成功, false: 所有帧均被固定
+ */
+bool BufferPoolManagerInstance::AcquireFrame(BufferAccessStrategy *strategy, frame_id_t *frame_id) {
+    if(strategy != nullptr && GetRingVictim(strategy, frame_id)) return true;
+    if(!FindVictimPage(frame_id)) return false;
+    if(strategy != nullptr) AddToRing(strategy, *frame_id);
+    return true;
+}
+
+/**
+ * @brief 在页表中查找page_id所在的帧
+ * @note 若该帧正在进行I/O(换入/换出), 则在该帧的io_cv_上等待I/O完成后重新查找, 不影响其他帧的访问
+ *
+ * @param lock 已持有的latch_
+ * @param page_id 要查找的页面
+ * @param frame_id 返回page_id所在的帧
+ * @return true: page_id在缓冲池中, false: page_id不在缓冲池中
+ */
+bool BufferPoolManagerInstance::LookupPage(std::unique_lock<std::mutex> &lock, PageId page_id, frame_id_t *frame_id) {
+    while(true) {
+        auto it = page_table_.find(page_id);
+        if(it == page_table_.end()) return false;
+        Page *page = GetFramePage(it->second);
+        if(!page->io_in_progress_) {
+            *frame_id = it->second;
+            return true;
+        }
+        page->io_cv_.wait(lock, [page] { return !page->io_in_progress_; });
+    }
+}
+
+/**
+ * @brief 从strategy的ring中取出下一个可复用的帧
+ * @note ring未满时返回false, 由调用者从free_list_/replacer中取帧并加入ring;
+ * 当前槽位的帧仍被固定(例如被其他线程命中), 正在写回(例如FlushAllPages)或正在被Resize移出缓冲池时也返回false,
+ * 之后由AddToRing替换该槽位
+ *
+ * @param strategy 扫描使用的访问策略
+ * @param frame_id 返回可复用的帧
+ * @return true: 找到可复用的帧, false: 需要从free_list_/replacer中取帧
+ */
+bool BufferPoolManagerInstance::GetRingVictim(BufferAccessStrategy *strategy, frame_id_t *frame_id) {
+    auto &ring = strategy->GetRing(this);
+    if(ring.frames.size() < strategy->ring_size_) return false;
+    frame_id_t candidate = ring.frames[ring.current];
+    Page *page = GetFramePage(candidate);
+    if(page->ring_owner_ != strategy || page->pin_count_ > 0 || page->io_in_progress_ ||
+       static_cast<size_t>(candidate) >= frame_limit_) {
+        return false;
+    }
+    ring.current = (ring.current + 1) % ring.frames.size();
+    *frame_id = candidate;
+    return true;
+}
+
+/**
+ * @brief 将从free_list_/replacer中取得的帧加入strategy的ring
+ * @note ring已满时替换当前槽位, 被替换的帧退出ring, 成为普通帧
+ */
+void BufferPoolManagerInstance::AddToRing(BufferAccessStrategy *strategy, frame_id_t frame_id) {
+    auto &ring = strategy->GetRing(this);
+    GetFramePage(frame_id)->ring_owner_ = strategy;
+    if(ring.frames.size() < strategy->ring_size_) {
+        ring.frames.push_back(frame_id);
+        return;
+    }
+    Page *old_page = GetFramePage(ring.frames[ring.current]);
+    if(old_page->ring_owner_ == strategy) {
+        old_page->ring_owner_ = nullptr;
+        if(old_page->pin_count_ == 0) replacer_->Unpin(ring.frames[ring.current]);
+    }
+    ring.frames[ring.current] = frame_id;
+    ring.current = (ring.current + 1) % ring.frames.size();
+}
+
+/**
+ * @brief 更新页面数据, 为脏页则需写入磁盘，更新page元数据(data, is_dirty, page_id)和page table
+ * @note 磁盘I/O期间释放latch_, 帧处于io_in_progress_状态; 旧页的映射保留到I/O结束,
+ * 因此并发访问新旧页面的线程只会在该帧上等待, 访问其他页面的线程不受影响
+ *
+ * @param lock 已持有的latch_, 返回时仍持有
+ * @param page 写回页指针
+ * @param new_page_id 写回页新page_id
+ * @param new_frame_id 写回页新帧frame_id
+ * @param read_from_disk 是否需要从磁盘读入新页面(NewPage时不需要)
+ * @param reserve 为预读预留帧: 返回时帧仍处于io_in_progress_状态, 由CompleteReservedPage结束
+ */
+void BufferPoolManagerInstance::UpdatePage(std::unique_lock<std::mutex> &lock, Page *page, PageId new_page_id,
+                                           frame_id_t new_frame_id, bool read_from_disk, bool reserve) {
+    // Todo:
+    // 1 如果是脏页，写回磁盘，并且把dirty置为false
+    // 2 更新page table
+    // 3 重置page的data，更新page id
+    PageId old_page_id = page->id_;
+    bool write_back = page->is_dirty_;
+    // ring中的页面只被顺序扫描访问一次, 映射中的页面本就在内核的页缓存中, 都不放入压缩缓存
+    bool keep_copy = compressed_cache_ != nullptr && old_page_id.page_no != INVALID_PAGE_ID &&
+                     page->ring_owner_ == nullptr && !page->mapped_;
+    bool mapped_read = false;
+    bool compressed_hit = false;
+    page->prefetched_ = false;
+    if(old_page_id.page_no != INVALID_PAGE_ID) {
+        stats_.evictions++;
+        if(!write_back) stats_.clean_evictions++;
+    }
+    {
+        // FetchPinnedPage看到的新旧映射都指向处于io_in_progress_状态的帧
+        std::unique_lock table_lock{page_table_latch_};
+        page->io_in_progress_ = true;
+        SetFramePageId(page, new_page_id);
+        page->is_dirty_ = false;
+        page->pin_count_ = 1;
+        page_table_[new_page_id] = new_frame_id;
+    }
+    // 帧改为存放新页面, 旧页面的访问历史不再有意义; 访问由调用者在真正访问页面时记录
+    replacer_->Remove(new_frame_id);
+
+    lock.unlock();
+    bool written = !write_back;
+    try {
+        if(write_back) {
+            disk_manager_->write_page(old_page_id.fd, old_page_id.page_no, page->GetData(), PAGE_SIZE);
+            written = true;
+        }
+        if(keep_copy) compressed_cache_->Put(old_page_id, page->GetData());
+        if(page->mapped_) {
+            page->data_ = arena_.GetFrame(new_frame_id);
+            page->mapped_ = false;
+        }
+        const char *mapped = read_from_disk ? disk_manager_->get_mapped_page(new_page_id.fd, new_page_id.page_no) : nullptr;
+        if(mapped != nullptr) {
+            // 只读映射的文件: 帧直接指向映射中的页面, 不复制
+            page->data_ = const_cast<char *>(mapped);
+            page->mapped_ = true;
+            mapped_read = true;
+        } else {
+            page->ResetMemory();
+            if(read_from_disk) {
+                compressed_hit = compressed_cache_ != nullptr && compressed_cache_->Get(new_page_id, page->GetData());
+                if(!compressed_hit) {
+                    disk_manager_->read_page(new_page_id.fd, new_page_id.page_no, page->GetData(), PAGE_SIZE);
+                }
+            } else if(compressed_cache_ != nullptr) {
+                compressed_cache_->Erase(new_page_id);
+            }
+        }
+    } catch (RedBaseError &e) {
+        lock.lock();
+        std::unique_lock table_lock{page_table_latch_};
+        page_table_.erase(new_page_id);
+        page->ring_owner_ = nullptr;
+        if(!written) {
+            // 旧页未能写回, 恢复为可淘汰的脏页
+            SetFramePageId(page, old_page_id);
+            page->is_dirty_ = true;
+            page->pin_count_ = 0;
+            replacer_->Unpin(new_frame_id);
+        } else {
+            page_table_.erase(old_page_id);
+            SetFramePageId(page, PageId{});
+            page->pin_count_ = 0;
+            free_list_.push_back(new_frame_id);
+        }
+        UpdateDirtyFrames(new_frame_id);
+        page->io_in_progress_ = false;
+        page->io_cv_.notify_all();
+        throw;
+    }
+    lock.lock();
+    if(compressed_hit) stats_.compressed_hits++;
+    if(mapped_read) stats_.mapped_reads++;
+    // 旧页写回完成前, 帧仍记录在旧文件的dirty_frames_中, 该文件的FlushAllPages会等待写回结束
+    UpdateDirtyFrames(new_frame_id);
+
+    std::unique_lock table_lock{page_table_latch_};
+    auto it = page_table_.find(old_page_id);
+    if(it != page_table_.end() && it->second == new_frame_id) page_table_.erase(it);
+    if(reserve) return;
+    page->io_in_progress_ = false;
+    page->io_cv_.notify_all();
+}
+
+/**
+ * Fetch the requested page from the buffer pool.
+ * 如果页表中存在page_id（说明该page在缓冲池中），并且pin_count++。
+ * 如果页表不存在page_id（说明该page在磁盘中），则找缓冲池victim page，将其替换为磁盘中读取的page，pin_count置1。
+ * @param page_id id of page to be fetched
+ * @return the requested page
+ */
+Page *BufferPoolManagerInstance::FetchPage(PageId page_id, BufferAccessStrategy *strategy) {
+    // Todo:
+    // 0.     lock latch
+    // 1.     Search the page table for the requested page (P).
+    // 1.1    If P exists, pin it and return it immediately.
+    // 1.2    If P does not exist, find a replacement page (R) from either the free list or the replacer.
+    //        Note that pages are always found from the free list first.
+    // 2.     If R is dirty, write it back to the disk.
+    // 3.     Delete R from the page table and insert P.
+    // 4.     Update P's metadata, read in the page content from disk, and then return a pointer to P.
+    Page *page = FetchPinnedPage(page_id);
+    if(page != nullptr) return page;
+    std::unique_lock lock{latch_};
+    frame_id_t frame_id = INVALID_FRAME_ID;
+    if(LookupPage(lock, page_id, &frame_id)) {
+        page = GetFramePage(frame_id);
+        replacer_->Pin(frame_id);
+        replacer_->RecordAccess(frame_id);
+        page->pin_count_++;
+        UpdateDirtyFrames(frame_id);
+        // 普通的命中不通知预读线程, 只有第一次命中预读的页面时才通知
+        if(!page->prefetched_) return page;
+        page->prefetched_ = false;
+        stats_.prefetch_hits++;
+    } else {
+        if(!AcquireFrame(strategy, &frame_id)) return nullptr;
+        page = GetFramePage(frame_id);
+        UpdatePage(lock, page, page_id, frame_id, true);
+        replacer_->RecordAccess(frame_id);
+    }
+    lock.unlock();
+    if(prefetcher_ != nullptr) prefetcher_->RecordAccess(page_id, strategy);
+    return page;
+}
+
+/**
+ * @brief 不获取latch_命中已被其他线程固定的页面
+ * @note 只持有page_table_latch_的读锁: 页表和帧映射的页面不会改变, 而pin_count_大于0且不在I/O中的帧不会被换出,
+ * 因此只需将pin_count_从大于0的值原子地加1. pin_count_从0到1时需要更新dirty_frames_并与淘汰互斥,
+ * 这种情况以及正在I/O, 尚未被访问的预读页面都返回nullptr, 由FetchPage在latch_内处理.
+ * replacer的Pin和RecordAccess同样在latch_之外调用, 各替换策略自身是线程安全的, LockFreeClockReplacer不加锁
+ *
+ * @return 命中时返回已固定的页面, 否则返回nullptr
+ */
+Page *BufferPoolManagerInstance::FetchPinnedPage(PageId page_id) {
+    std::shared_lock table_lock{page_table_latch_};
+    auto it = page_table_.find(page_id);
+    if(it == page_table_.end()) return nullptr;
+    frame_id_t frame_id = it->second;
+    Page *page = GetFramePage(frame_id);
+    if(page->io_in_progress_ || page->prefetched_) return nullptr;
+    int pin_count = page->pin_count_.load();
+    do {
+        if(pin_count <= 0) return nullptr;
+    } while(!page->pin_count_.compare_exchange_weak(pin_count, pin_count + 1));
+    table_lock.unlock();
+    replacer_->Pin(frame_id);
+    replacer_->RecordAccess(frame_id);
+    return page;
+}
+
+/**
+ * Unpin the target page from the buffer pool. 取消固定pin_count>0的在缓冲池中的page
+ * @param page_id id of page to be unpinned
+ * @param is_dirty true if the page should be marked as dirty, false otherwise
+ * @return false if the page pin count is <= 0 before this call, true otherwise
+ */
+bool BufferPoolManagerInstance::UnpinPage(PageId page_id, bool is_dirty) {
+    // Todo:
+    // 0. lock latch
+    // 1. try to search page_id page P in page_table_
+    // 1.1 P在页表中不存在 return false
+    // 1.2 P在页表中存在 如何解除一次固定(pin_count)
+    // 2. 页面是否需要置脏
+    std::unique_lock lock{latch_};
+    frame_id_t frame_id = INVALID_FRAME_ID;
+    if(!LookupPage(lock, page_id, &frame_id)) return false;
+    Page &page = *GetFramePage(frame_id);
+    if(page.pin_count_ <= 0) return false;
+    // 只能置脏不能清除脏位, 否则其他线程未写回的修改会在淘汰时丢失; 映射中的页面不会被修改
+    page.is_dirty_ |= is_dirty && !page.mapped_;
+    page.pin_count_--;
+    UpdateDirtyFrames(frame_id);
+    // ring中的帧由扫描自己复用, 不进入replacer
+    if(page.pin_count_ == 0 && page.ring_owner_ == nullptr) replacer_->Unpin(frame_id);
+    return true;
+}
+
+/**
+ * Flushes the target page to disk. 将page写入磁盘；不考虑pin_count
+ * @note 写回期间释放latch_, 帧处于io_in_progress_状态, 与WriteBackFrame相同; 写回失败时页面仍为脏页, 异常抛给调用者
+ * @param page_id id of page to be flushed, cannot be INVALID_PAGE_ID
+ * @return false if the page could not be found in the page table, true otherwise
+ */
+bool BufferPoolManagerInstance::FlushPage(PageId page_id) {
+    // Todo:
+    // 0. lock latch
+    // 1. 页表查找
+    // 2. 存在时如何写回磁盘
+    // 3. 写回后页面的脏位
+    // Make sure you call DiskManager::WritePage!
+    std::unique_lock lock{latch_};
+    frame_id_t frame_id = INVALID_FRAME_ID;
+    if(LookupPage(lock, page_id, &frame_id)) {
+        Page &page = *GetFramePage(frame_id);
+        if(page.mapped_) return true;
+        page.io_in_progress_ = true;
+        page.is_dirty_ = false;
+        lock.unlock();
+        std::exception_ptr error;
+        try {
+            disk_manager_->write_page(page_id.fd, page_id.page_no, page.GetData(), PAGE_SIZE);
+        } catch (RedBaseError &e) {
+            error = std::current_exception();
+        }
+        lock.lock();
+        // 写回失败时恢复脏位; 写回期间UnpinPage重新置脏的页面保持为脏页
+        if(error) page.is_dirty_ = true;
+        UpdateDirtyFrames(frame_id);
+        page.io_in_progress_ = false;
+        page.io_cv_.notify_all();
+        if(error) std::rethrow_exception(error);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Creates a new page in the buffer pool. 相当于从磁盘中移动一个新建的空page到缓冲池某个位置
+ * @param[out] page_id id of created page
+ * @return nullptr if no new pages could be created, otherwise pointer to new page
+ */
+Page *BufferPoolManagerInstance::NewPage(PageId *page_id) {
+    // Todo:
+    // 0.   lock latch
+    // 1.   Make sure you call DiskManager::AllocatePage!
+    // 2.   If all the pages in the buffer pool are pinned, return nullptr.
+    // 3.   Pick a victim page P from either the free list or the replacer. Always pick from the free list first.
+    // 4.   Update P's metadata, zero out memory and add P to the page table. pin_count set to 1.
+    // 5.   Set the page ID output parameter. Return a pointer to P.
+    std::unique_lock lock{latch_};
+    frame_id_t frame_id = INVALID_FRAME_ID;
+    if(!FindVictimPage(&frame_id)) {
+        page_id->page_no = INVALID_PAGE_ID;
+        return nullptr;
+    }
+    page_id->page_no = disk_manager_->AllocatePage(page_id->fd);
+    UpdatePage(lock, GetFramePage(frame_id), *page_id, frame_id, false);
+    replacer_->RecordAccess(frame_id);
+    return GetFramePage(frame_id);
+}
+
+/**
+ * @brief 为已由DiskManager::AllocatePage分配的page_id创建新页面
+ * @return 没有可用的帧时返回nullptr, 由调用者决定是否释放page_id
+ */
+Page *BufferPoolManagerInstance::CreatePage(PageId page_id) {
+    std::unique_lock lock{latch_};
+    frame_id_t frame_id = INVALID_FRAME_ID;
+    if (!FindVictimPage(&frame_id)) return nullptr;
+    UpdatePage(lock, GetFramePage(frame_id), page_id, frame_id, false);
+    replacer_->RecordAccess(frame_id);
+    return GetFramePage(frame_id);
+}
+
+/**
+ * @brief Deletes a page from the buffer pool.
+ * @param page_id id of page to be deleted
+ * @return false if the page exists but could not be deleted, true if the page didn't exist or deletion succeeded
+ */
+bool BufferPoolManagerInstance::DeletePage(PageId page_id) {
+    // Todo:
+    // 0.   lock latch
+    // 1.   Make sure you call DiskManager::DeallocatePage!
+    // 2.   Search the page table for the requested page (P).
+    // 2.1  If P does not exist, return true.
+    // 2.2  If P exists, but has a non-zero pin-count, return false. Someone is using the page.
+    // 3.   Otherwise, P can be deleted. Remove P from the page table, reset its metadata and return it to the free
+    // list.
+    std::unique_lock lock{latch_};
+    frame_id_t frame_id = INVALID_FRAME_ID;
+    if(!LookupPage(lock, page_id, &frame_id)) {
+        // 不在缓冲池中的页面同样需要归还给DiskManager
+        if(compressed_cache_ != nullptr) compressed_cache_->Erase(page_id);
+        disk_manager_->DeallocatePage(page_id.fd, page_id.page_no);
+        return true;
+    }
+    Page &page = *GetFramePage(frame_id);
+    if(page.pin_count_ > 0) return false;
+    disk_manager_->DeallocatePage(page_id.fd, page_id.page_no);
+    if(compressed_cache_ != nullptr) compressed_cache_->Erase(page_id);
+    {
+        std::unique_lock table_lock{page_table_latch_};
+        page_table_.erase(page_id);
+        SetFramePageId(&page, PageId{});
+    }
+    replacer_->Remove(frame_id);
+    page.is_dirty_ = false;
+    page.pin_count_ = 0;
+    page.ring_owner_ = nullptr;
+    page.prefetched_ = false;
+    UpdateDirtyFrames(frame_id);
+    free_list_.push_back(frame_id);
+    return true;
+}
+
+/**
+ * @brief Flushes all the pages in the buffer pool to disk.
+ * @note 只写回该文件的脏页和被固定的页面, 按page_no排序后将相邻的页面合并为一次pwritev
+ *
+ * @param fd 指定的diskfile open句柄
+ */
+void BufferPoolManagerInstance::FlushAllPages(int fd) {
+    std::vector<Page *> pages = BeginFlush(fd);
+    std::vector<bool> written;
+    std::exception_ptr error = WritePages(disk_manager_, &pages, &written);
+    EndFlush(pages, written);
+    if (error) std::rethrow_exception(error);
+}
+
+/**
+ * @brief 将strategy的ring中的帧归还给缓冲池
+ * @note 未被固定的干净页面直接丢弃并放回free_list_, 扫描结束后不会占用replacer中的位置;
+ * 脏页, 仍被固定或正在I/O的页面退出ring, 之后按普通帧处理
+ *
+ * @param strategy 扫描使用的访问策略
+ */
+void BufferPoolManagerInstance::ReleaseAccessStrategy(BufferAccessStrategy *strategy) {
+    // 预读线程之后不会再向ring中加入帧
+    if (prefetcher_ != nullptr) prefetcher_->Forget(strategy);
+    std::scoped_lock lock{latch_};
+    BufferAccessStrategy::Ring *ring = strategy->FindRing(this);
+    if (ring == nullptr) return;
+    for (frame_id_t frame_id : ring->frames) {
+        Page *page = GetFramePage(frame_id);
+        if (page->ring_owner_ != strategy) continue;
+        page->ring_owner_ = nullptr;
+        if (page->pin_count_ > 0) continue;
+        if (page->is_dirty_ || page->io_in_progress_) {
+            // 正在写回的帧在EndFlush之前不能复用, 交给replacer, 淘汰时会跳过
+            replacer_->Unpin(frame_id);
+            continue;
+        }
+        {
+            std::unique_lock table_lock{page_table_latch_};
+            page_table_.erase(page->id_);
+            SetFramePageId(page, PageId{});
+        }
+        free_list_.push_back(frame_id);
+    }
+    strategy->EraseRing(this);
+}
+
+std::vector<PageId> BufferPoolManagerInstance::GetResidentPages() {
+    std::scoped_lock lock{latch_};
+    std::vector<PageId> page_ids;
+    for (size_t i = 0; i < pool_size_; i++) {
+        Page *page = GetFramePage(i);
+        if (page->pin_count_ > 0 && !page->io_in_progress_ && page->ring_owner_ == nullptr &&
+            page->id_.page_no != INVALID_PAGE_ID) {
+            page_ids.push_back(page->id_);
+        }
+    }
+    // replacer按淘汰顺序给出候选帧, 反过来即为从新到旧
+    std::vector<frame_id_t> candidates = replacer_->EvictionCandidates(pool_size_);
+    for (auto it = candidates.rbegin(); it != candidates.rend(); ++it) {
+        Page *page = GetFramePage(*it);
+        if (page->pin_count_ == 0 && !page->io_in_progress_ && page->id_.page_no != INVALID_PAGE_ID) {
+            page_ids.push_back(page->id_);
+        }
+    }
+    return page_ids;
+}
+
+/**
+ * @brief 为帧[0, num_frames)分配描述符, 已分配的块保持不变
+ */
+void BufferPoolManagerInstance::AllocateFrames(size_t num_frames) {
+    while (page_chunks_.size() * FRAME_CHUNK_SIZE < num_frames) {
+        size_t first = page_chunks_.size() * FRAME_CHUNK_SIZE;
+        page_chunks_.push_back(std::make_unique<Page[]>(FRAME_CHUNK_SIZE));
+        for (size_t i = 0; i < FRAME_CHUNK_SIZE && first + i < max_pool_size_; i++) {
+            page_chunks_.back()[i].data_ = arena_.GetFrame(first + i);
+        }
+    }
+}
+
+/**
+ * @brief 在线调整缓冲池的帧数
+ * @note 扩容时新的帧直接加入free_list_; 缩容见ShrinkFrames. 其他线程可以同时访问缓冲池
+ *
+ * @param new_size 目标帧数, 限制在[1, max_pool_size_]之间
+ * @return 调整后的帧数
+ */
+size_t BufferPoolManagerInstance::Resize(size_t new_size) {
+    std::scoped_lock resize_lock{resize_latch_};
+    new_size = std::clamp<size_t>(new_size, 1, max_pool_size_);
+    std::unique_lock lock{latch_};
+    size_t old_size = pool_size_;
+    if (new_size > old_size) {
+        AllocateFrames(new_size);
+        for (size_t i = old_size; i < new_size; i++) {
+            free_list_.emplace_back(static_cast<frame_id_t>(i));
+        }
+        pool_size_ = new_size;
+        frame_limit_ = new_size;
+    } else if (new_size < old_size) {
+        pool_size_ = ShrinkFrames(lock, new_size);
+        frame_limit_ = pool_size_;
+    }
+    return pool_size_;
+}
+
+/**
+ * @brief 将帧[new_size, pool_size_)移出缓冲池
+ * @note 这些帧不再分配给新的页面; 未被固定的脏页先写回, 之后未被固定的页面直接丢弃.
+ * 被固定或正在I/O的帧最多等待BUFFER_POOL_DRAIN_TIMEOUT, 仍未释放时只缩容到最后一个仍在使用的帧之后
+ *
+ * @param lock 已持有的latch_, 返回时仍持有
+ * @param new_size 目标帧数
+ * @return 实际缩容后的帧数
+ */
+size_t BufferPoolManagerInstance::ShrinkFrames(std::unique_lock<std::mutex> &lock, size_t new_size) {
+    const size_t old_size = pool_size_;
+    frame_limit_ = new_size;
+    free_list_.remove_if([new_size](frame_id_t frame_id) { return static_cast<size_t>(frame_id) >= new_size; });
+
+    auto deadline = std::chrono::steady_clock::now() + BUFFER_POOL_DRAIN_TIMEOUT;
+    size_t busy_end = new_size;
+    while (true) {
+        busy_end = new_size;
+        for (size_t i = new_size; i < old_size; i++) {
+            auto frame_id = static_cast<frame_id_t>(i);
+            Page *page = GetFramePage(frame_id);
+            if (page->pin_count_ == 0 && !page->io_in_progress_ && page->is_dirty_) {
+                // 写回期间释放latch_, 之后需要重新检查帧的状态
+                WriteBackFrame(lock, frame_id);
+            }
+            if (page->pin_count_ > 0 || page->io_in_progress_ || page->is_dirty_) {
+                busy_end = i + 1;
+                continue;
+            }
+            // 帧已不在free_list_中, 从页表和replacer中移除后不会再被访问
+            {
+                std::unique_lock table_lock{page_table_latch_};
+                auto it = page_table_.find(page->id_);
+                if (it != page_table_.end() && it->second == frame_id) page_table_.erase(it);
+                SetFramePageId(page, PageId{});
+            }
+            replacer_->Remove(frame_id);
+            page->ring_owner_ = nullptr;
+            page->prefetched_ = false;
+            UpdateDirtyFrames(frame_id);
+        }
+        if (busy_end == new_size || std::chrono::steady_clock::now() >= deadline) break;
+        lock.unlock();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        lock.lock();
+    }
+    // 缩容期间DeletePage等可能将范围内的帧放回free_list_, 先统一移除, 再将仍在使用的帧之前已移出的帧放回
+    free_list_.remove_if([new_size](frame_id_t frame_id) { return static_cast<size_t>(frame_id) >= new_size; });
+    for (size_t i = new_size; i < busy_end; i++) {
+        Page *page = GetFramePage(static_cast<frame_id_t>(i));
+        if (page->id_.page_no == INVALID_PAGE_ID && page->pin_count_ == 0 && !page->io_in_progress_) {
+            free_list_.emplace_back(static_cast<frame_id_t>(i));
+        }
+    }
+    arena_.Release(busy_end, old_size);
+    return busy_end;
+}
+
+/**
+ * @brief 设置文件fd最多占用的帧数
+ * @note 配额不是硬上限: 文件超出配额时其页面被优先淘汰, 但在没有其他可用帧时仍可超出
+ *
+ * @param fd 文件
+ * @param max_frames 帧数配额, 0表示取消配额
+ */
+void BufferPoolManagerInstance::SetFileQuota(int fd, size_t max_frames) {
+    std::scoped_lock lock{latch_};
+    if (max_frames == 0) {
+        file_quotas_.erase(fd);
+    } else {
+        file_quotas_[fd] = max_frames;
+    }
+}
+
+size_t BufferPoolManagerInstance::GetFileFrames(int fd) {
+    std::scoped_lock lock{latch_};
+    auto it = file_frames_.find(fd);
+    return it == file_frames_.end() ? 0 : it->second;
+}
+
+/**
+ * @brief 丢弃文件fd在本分片中的所有页面, 包括仍被固定的页面
+ * @note 关闭文件时在FlushAllPages之后调用, 调用者保证之后不再访问该文件的页面;
+ * 只读映射的文件在解除映射前必须调用, 否则帧仍指向已解除的映射
+ */
+void BufferPoolManagerInstance::DiscardPages(int fd) {
+    std::unique_lock lock{latch_};
+    for (size_t i = 0; i < pool_size_; i++) {
+        auto frame_id = static_cast<frame_id_t>(i);
+        Page *page = GetFramePage(frame_id);
+        if (page->id_.fd != fd || page->id_.page_no == INVALID_PAGE_ID) continue;
+        // 等待期间帧可能被换出, 之后重新检查
+        page->io_cv_.wait(lock, [page] { return !page->io_in_progress_; });
+        if (page->id_.fd != fd || page->id_.page_no == INVALID_PAGE_ID) continue;
+        {
+            std::unique_lock table_lock{page_table_latch_};
+            auto it = page_table_.find(page->id_);
+            if (it != page_table_.end() && it->second == frame_id) page_table_.erase(it);
+            SetFramePageId(page, PageId{});
+            page->pin_count_ = 0;
+        }
+        replacer_->Remove(frame_id);
+        page->is_dirty_ = false;
+        page->prefetched_ = false;
+        if (page->mapped_) {
+            page->data_ = arena_.GetFrame(frame_id);
+            page->mapped_ = false;
+        }
+        UpdateDirtyFrames(frame_id);
+        // ring中的帧仍属于扫描, 由ReleaseAccessStrategy放回free_list_
+        if (page->ring_owner_ == nullptr) free_list_.push_back(frame_id);
+    }
+}
+
+/**
+ * @brief 后台写回线程的主循环, 每隔cleaner_interval执行一轮写回, 析构时退出
+ */
+void BufferPoolManagerInstance::RunCleaner() {
+    std::unique_lock lock{latch_};
+    while (!stop_cleaner_) {
+        cleaner_cv_.wait_for(lock, options_.cleaner_interval, [this] { return stop_cleaner_; });
+        if (stop_cleaner_) break;
+        CleanDirtyPages(lock);
+    }
+}
+
+/**
+ * @brief 按淘汰顺序将replacer中未被固定的脏页写回磁盘
+ * @note 总是写回淘汰端cleaner_scan_depth个帧中的脏页; 脏页比例超过cleaner_dirty_ratio时继续向后写回,
+ * 直到比例降到目标以下. 每轮最多写回cleaner_max_pages个页面.
+ * @note 选出的页面作为一批异步写回, 写回期间释放latch_, 见BeginFlush
+ *
+ * @param lock 已持有的latch_, 返回时仍持有
+ */
+void BufferPoolManagerInstance::CleanDirtyPages(std::unique_lock<std::mutex> &lock) {
+    const size_t pool_size = pool_size_;
+    size_t num_dirty = 0;
+    for (size_t i = 0; i < pool_size; i++) {
+        if (GetFramePage(i)->is_dirty_) num_dirty++;
+    }
+    const auto target = static_cast<size_t>(options_.cleaner_dirty_ratio * pool_size);
+    std::vector<frame_id_t> candidates =
+        replacer_->EvictionCandidates(num_dirty > target ? pool_size : options_.cleaner_scan_depth);
+
+    std::vector<Page *> pages;
+    for (size_t i = 0; i < candidates.size() && pages.size() < options_.cleaner_max_pages; i++) {
+        if (i >= options_.cleaner_scan_depth && num_dirty <= target) break;
+        Page *page = GetFramePage(candidates[i]);
+        if (!page->is_dirty_ || page->pin_count_ > 0 || page->io_in_progress_ || page->ring_owner_ != nullptr) {
+            continue;
+        }
+        page->io_in_progress_ = true;
+        page->is_dirty_ = false;
+        pages.push_back(page);
+        num_dirty--;
+    }
+    if (pages.empty()) return;
+    lock.unlock();
+    std::vector<bool> written;
+    WritePages(disk_manager_, &pages, &written);
+    EndFlush(pages, written);
+    lock.lock();
+    stats_.cleaner_writes += std::count(written.begin(), written.end(), true);
+}
+
+/**
+ * @brief 将一个未被固定的脏页写回磁盘
+ * @note 写回期间释放latch_, 帧处于io_in_progress_状态, 不会被换出; 写回前先清除脏位,
+ * 写回期间被其他线程修改的页面在UnpinPage时重新置脏
+ *
+ * @param lock 已持有的latch_, 返回时仍持有
+ * @param frame_id 脏页所在的帧, 调用者需保证未被固定且不在I/O中
+ * @return 是否写回成功, 失败时页面仍为脏页
+ */
+bool BufferPoolManagerInstance::WriteBackFrame(std::unique_lock<std::mutex> &lock, frame_id_t frame_id) {
+    Page *page = GetFramePage(frame_id);
+    PageId page_id = page->id_;
+    page->io_in_progress_ = true;
+    page->is_dirty_ = false;
+    lock.unlock();
+    bool written = true;
+    try {
+        disk_manager_->write_page(page_id.fd, page_id.page_no, page->GetData(), PAGE_SIZE);
+    } catch (RedBaseError &e) {
+        written = false;
+    }
+    lock.lock();
+    if (!written) page->is_dirty_ = true;
+    UpdateDirtyFrames(frame_id);
+    page->io_in_progress_ = false;
+    page->io_cv_.notify_all();
+    return written;
+}
+
+/**
+ * @brief 为预读的页面预留一个帧
+ * @note 返回时帧已映射到page_id并被固定, 且处于io_in_progress_状态, 访问该页面的线程等待预读完成;
+ * 预读线程读入页面后调用CompleteReservedPage
+ *
+ * @param page_id 预读的页面
+ * @param strategy 访问策略, 可以为nullptr
+ * @return 预留的帧, 页面已在缓冲池中或所有帧均被固定时返回nullptr
+ */
+Page *BufferPoolManagerInstance::ReservePage(PageId page_id, BufferAccessStrategy *strategy) {
+    std::unique_lock lock{latch_};
+    frame_id_t frame_id = INVALID_FRAME_ID;
+    if(page_table_.count(page_id) > 0 || !AcquireFrame(strategy, &frame_id)) return nullptr;
+    Page *page = GetFramePage(frame_id);
+    UpdatePage(lock, page, page_id, frame_id, false, true);
+    return page;
+}
+
+/**
+ * @brief 结束预留帧的预读
+ *
+ * @param page ReservePage返回的帧
+ * @param success 页面是否读入成功; 失败(例如超出文件末尾)时丢弃该页面, 帧放回free_list_
+ */
+void BufferPoolManagerInstance::CompleteReservedPage(Page *page, bool success) {
+    std::scoped_lock lock{latch_};
+    // 预留的帧在预读完成前不会被换出, 页表中的映射仍指向该帧
+    frame_id_t frame_id = page_table_.at(page->id_);
+    // 先解除预留的固定, 清除io_in_progress_后FetchPinnedPage不会固定pin_count_为0的帧
+    page->pin_count_--;
+    page->io_in_progress_ = false;
+    if(success) {
+        page->prefetched_ = true;
+        stats_.prefetched_pages++;
+        if(page->pin_count_ == 0 && page->ring_owner_ == nullptr) replacer_->Unpin(frame_id);
+    } else if(page->pin_count_ == 0) {
+        std::unique_lock table_lock{page_table_latch_};
+        page_table_.erase(page->id_);
+        SetFramePageId(page, PageId{});
+        page->ResetMemory();
+        if(page->ring_owner_ == nullptr) free_list_.push_back(frame_id);
+    }
+    UpdateDirtyFrames(frame_id);
+    page->io_cv_.notify_all();
+}
+
+/**
+ * @brief 根据帧当前的状态更新dirty_frames_: 有效的页面为脏页或被固定时记录在其文件的位图中, 否则移除
+ * @note 修改帧的page_id, is_dirty_或pin_count_后调用
+ */
+void BufferPoolManagerInstance::UpdateDirtyFrames(frame_id_t frame_id) {
+    Page *page = GetFramePage(frame_id);
+    bool track = page->id_.page_no != INVALID_PAGE_ID && !page->mapped_ && (page->is_dirty_ || page->pin_count_ > 0);
+    int fd = track ? page->id_.fd : -1;
+    if (dirty_frame_fd_[frame_id] == fd) return;
+    const uint64_t mask = uint64_t{1} << (frame_id % 64);
+    if (dirty_frame_fd_[frame_id] != -1) {
+        dirty_frames_[dirty_frame_fd_[frame_id]][frame_id / 64] &= ~mask;
+    }
+    if (fd != -1) {
+        auto &bitmap = dirty_frames_[fd];
+        if (bitmap.empty()) bitmap.resize((max_pool_size_ + 63) / 64);
+        bitmap[frame_id / 64] |= mask;
+    }
+    dirty_frame_fd_[frame_id] = fd;
+}
+
+/**
+ * @brief 取出文件fd中需要写回的帧, 并将它们置为io_in_progress_状态
+ * @note 先等待该文件上正在进行的I/O(淘汰时的写回, 后台写回, 预读)结束. 返回的帧在EndFlush之前不会被换出,
+ * 访问这些页面的线程等待写回完成; 脏位在写回前清除, 写回期间的修改在UnpinPage时重新置脏
+ *
+ * @param fd 文件
+ * @return 需要写回的帧
+ */
+std::vector<Page *> BufferPoolManagerInstance::BeginFlush(int fd) {
+    std::unique_lock lock{latch_};
+    std::vector<Page *> pages;
+    auto collect = [this, fd, &pages]() {
+        pages.clear();
+        auto it = dirty_frames_.find(fd);
+        if (it == dirty_frames_.end()) return;
+        for (size_t i = 0; i < it->second.size(); i++) {
+            for (uint64_t bits = it->second[i]; bits != 0; bits &= bits - 1) {
+                pages.push_back(GetFramePage(i * 64 + __builtin_ctzll(bits)));
+            }
+        }
+    };
+    // 等待期间位图可能变化, 每次等待后重新收集
+    collect();
+    for (auto busy = pages.begin(); busy != pages.end();) {
+        if (!(*busy)->io_in_progress_) {
+            ++busy;
+            continue;
+        }
+        Page *page = *busy;
+        page->io_cv_.wait(lock, [page] { return !page->io_in_progress_; });
+        collect();
+        busy = pages.begin();
+    }
+    for (Page *page : pages) {
+        page->io_in_progress_ = true;
+        page->is_dirty_ = false;
+    }
+    return pages;
+}
+
+/**
+ * @brief 结束BeginFlush取出的帧的写回
+ *
+ * @param pages 写回的帧, 可以包含其他分片的帧, 只处理本分片的帧
+ * @param written 每个帧是否写回成功, 失败的帧重新置脏
+ */
+void BufferPoolManagerInstance::EndFlush(const std::vector<Page *> &pages, const std::vector<bool> &written) {
+    std::scoped_lock lock{latch_};
+    for (size_t i = 0; i < pages.size(); i++) {
+        Page *page = pages[i];
+        // 写回期间帧不会被换出(replacer和ring都跳过io_in_progress_的帧), 页表中的映射仍指向该帧;
+        // 其他分片的页面不在本分片的页表中
+        auto it = page_table_.find(page->id_);
+        if (it == page_table_.end() || GetFramePage(it->second) != page) continue;
+        if (!written[i]) page->is_dirty_ = true;
+        UpdateDirtyFrames(it->second);
+        page->io_in_progress_ = false;
+        page->io_cv_.notify_all();
+    }
+}
+
+/**
+ * @brief 将页面按(fd, page_no)排序, 同一文件中相邻的页面合并为一个写请求, 所有请求作为一批异步提交
+ * @note 不持有任何latch, 调用者需保证页面在写回期间不被换出(例如处于io_in_progress_状态)
+ *
+ * @param disk_manager 磁盘管理器
+ * @param pages 写回的页面, 可以属于不同文件, 返回时已排序
+ * @param written 返回每个页面是否写回成功, 与排序后的pages一一对应
+ * @return 第一个写回失败的异常, 全部成功时为空
+ */
+std::exception_ptr BufferPoolManagerInstance::WritePages(DiskManager *disk_manager, std::vector<Page *> *pages,
+                                                         std::vector<bool> *written) {
+    std::sort(pages->begin(), pages->end(), [](Page *a, Page *b) {
+        return a->GetPageId().fd < b->GetPageId().fd ||
+               (a->GetPageId().fd == b->GetPageId().fd && a->GetPageId().page_no < b->GetPageId().page_no);
+    });
+    written->assign(pages->size(), true);
+    IOBatch batch;
+    std::vector<const char *> bufs;
+    for (size_t begin = 0, end = 0; begin < pages->size(); begin = end) {
+        PageId start = (*pages)[begin]->GetPageId();
+        bufs.clear();
+        for (end = begin; end < pages->size() && (*pages)[end]->GetPageId() ==
+                                                     PageId{start.fd, start.page_no + static_cast<page_id_t>(end - begin)};
+             end++) {
+            bufs.push_back((*pages)[end]->GetData());
+        }
+        batch.AddWrite(start.fd, start.page_no, bufs.data(), static_cast<int>(bufs.size()));
+    }
+    std::exception_ptr error;
+    disk_manager->submit_io(&batch);
+    disk_manager->wait_io(&batch);
+    // 请求与排序后的页面按顺序对应
+    size_t index = 0;
+    for (auto &request : batch.Requests()) {
+        if (request.result < 0) {
+            std::fill(written->begin() + index, written->begin() + index + request.num_pages, false);
+            if (!error) {
+                errno = static_cast<int>(-request.result);
+                error = std::make_exception_ptr(UnixError());
+            }
+        }
+        index += request.num_pages;
+    }
+    return error;
+}
@@ -0,0 +1,351 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// buffer_pool_manager_instance.h
+//
+// Identification: src/include/buffer/buffer_pool_manager_instance.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+//===----------------------------------------------------------------------===//
+//
+//                         Rucbase
+//
+// buffer_pool_manager_instance.h
+//
+// Identification: src/storage/buffer_pool_manager_instance.h
+//
+// Copyright (c) 2022, RUC Deke Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>  // NOLINT
+#include <exception>
+#include <list>
+#include <memory>
+#include <shared_mutex>
+#include <thread>  // NOLINT
+#include <unordered_map>
+#include <vector>
+
+#include "buffer_access_strategy.h"
+#include "buffer_pool_manager.h"
+#include "buffer_pool_options.h"
+#include "compressed_page_cache.h"
+#include "page_arena.h"
+#include "prefetcher.h"
+#include "replacer/clock_replacer.h"
+#include "replacer/lock_free_clock_replacer.h"
+#include "replacer/lru_k_replacer.h"
+#include "replacer/lru_replacer.h"
+#include "replacer/replacer.h"
+
+/**
+ * @brief 由一把latch_保护的缓冲池实现
+ * @note 可以单独使用, 也可以作为ParallelBufferPoolManager的一个分片
+ * @note 例外: FetchPage命中已被其他线程固定的页面时不获取latch_, 只持有page_table_latch_的读锁,
+ * 固定页面和调用replacer都在latch_之外(见FetchPinnedPage); 第一次固定, 解除固定和缺页仍在latch_内
+ */
+class BufferPoolManagerInstance : public BufferPoolManager {
+    friend class Prefetcher;
+    friend class ParallelBufferPoolManager;
+
+   private:
+    /**
+     * @brief Number of pages in the buffer pool.
+     * @note Resize时修改, 由latch_保护; GetPoolSize不加锁读取
+     */
+    std::atomic<size_t> pool_size_;
+    /** Resize可达到的最大帧数, 帧号始终小于max_pool_size_ */
+    const size_t max_pool_size_;
+    /**
+     * @brief 帧号不小于frame_limit_的帧正在被Resize移出缓冲池, 不再分配给新的页面
+     * @note 不在缩容时等于pool_size_, 由latch_保护
+     */
+    size_t frame_limit_;
+    /**
+     * @brief 帧的描述符(Page对象), 每块FRAME_CHUNK_SIZE个帧
+     * @note 扩容时按块分配, 缩容时保留, 已分配的Page对象地址不变; 按max_pool_size_预留, 不会重新分配
+     */
+    std::vector<std::unique_ptr<Page[]>> page_chunks_;
+    /** 所有帧的页面数据, 与帧的描述符分开存放 */
+    PageArena arena_;
+    /**
+     * @brief 以自定义PageIdHash为哈希函数的<PageId,frame_id_t>哈希表.
+     * @note 用于根据PageId定位其在BufferPool中的frame_id_t
+     * @note 由latch_保护; 修改页表或帧映射的页面时还需持有page_table_latch_的写锁
+     */
+    std::unordered_map<PageId, frame_id_t, PageIdHash> page_table_;
+    /** FetchPinnedPage不持有latch_, 在其读锁下读取页表 */
+    std::shared_mutex page_table_latch_;
+    /**
+     * @brief BufferPool空闲帧的id构成的链表
+     */
+    std::list<frame_id_t> free_list_;
+    /** 上层传入disk_manager */
+    DiskManager *disk_manager_;
+
+    /**
+     * @brief BufferPool页面替换策略类
+     *
+     */
+    Replacer *replacer_;
+
+    /** This latch protects shared data structures */
+    std::mutex latch_;
+    /** 保证同一时刻只有一个Resize */
+    std::mutex resize_latch_;
+
+    /**
+     * @brief 每个文件中需要写回的帧, 以帧号为下标的位图
+     * @note 包括脏页, 以及被固定的页面(持有者可能已修改页面但尚未在UnpinPage时置脏); FlushAllPages只写回这些帧
+     */
+    std::unordered_map<int, std::vector<uint64_t>> dirty_frames_;
+    /** 每个帧记录在dirty_frames_中哪个文件的位图里, -1表示不在任何位图中 */
+    std::vector<int> dirty_frame_fd_;
+
+    /** 每个文件的页面占用的帧数, 由latch_保护 */
+    std::unordered_map<int, size_t> file_frames_;
+    /** 每个文件的帧数配额, 没有配额的文件不在其中, 由latch_保护 */
+    std::unordered_map<int, size_t> file_quotas_;
+
+    /** 统计计数, 由latch_保护 */
+    BufferPoolStats stats_;
+
+    /**
+     * @brief 后台写回线程
+     * @note 周期性地将replacer淘汰端附近的脏页写回磁盘, 使前台缺页时尽量选到干净的victim
+     */
+    std::thread cleaner_thread_;
+    std::condition_variable cleaner_cv_;
+    bool stop_cleaner_ = false;
+
+    /** 预读线程, 由上层设置, nullptr表示不预读 */
+    Prefetcher *prefetcher_ = nullptr;
+
+    /** 被淘汰页面的压缩缓存, 由上层设置, nullptr表示不使用 */
+    CompressedPageCache *compressed_cache_ = nullptr;
+
+    /** 构造时buffer_pool_options的副本, 提供替换策略和后台写回参数 */
+    const BufferPoolOptions options_;
+
+   public:
+    /** 帧的描述符按块分配, 每块的帧数 */
+    static constexpr size_t FRAME_CHUNK_SIZE = 64;
+    /** 有文件超出配额时, 在replacer淘汰端查找该文件的帧的最大候选数 */
+    static constexpr size_t QUOTA_SCAN_DEPTH = 256;
+
+    /**
+     * @param pool_size 帧数
+     * @param disk_manager 上层传入的disk_manager
+     * @param enable_cleaner 是否启动后台写回线程
+     * @param max_pool_size Resize可达到的最大帧数, 0表示pool_size的BUFFER_POOL_MAX_GROWTH倍
+     * @note 替换策略和后台写回参数取自buffer_pool_options
+     */
+    BufferPoolManagerInstance(size_t pool_size, DiskManager *disk_manager, bool enable_cleaner = false,
+                              size_t max_pool_size = 0)
+        : pool_size_(pool_size),
+          max_pool_size_(std::max(pool_size, max_pool_size == 0 ? pool_size * BUFFER_POOL_MAX_GROWTH : max_pool_size)),
+          frame_limit_(pool_size),
+          arena_(max_pool_size_, BUFFER_POOL_HUGE_PAGES),
+          disk_manager_(disk_manager),
+          dirty_frame_fd_(max_pool_size_, -1),
+          options_(buffer_pool_options) {
+        page_chunks_.reserve((max_pool_size_ + FRAME_CHUNK_SIZE - 1) / FRAME_CHUNK_SIZE);
+        AllocateFrames(pool_size);
+        // replacer按最大帧数创建, 扩容时不需要重建
+        if (options_.replacer == "LRU")
+            replacer_ = new LRUReplacer(max_pool_size_);
+        else if (options_.replacer == "CLOCK")
+            replacer_ = new ClockReplacer(max_pool_size_);
+        else if (options_.replacer == "LRU-K")
+            replacer_ = new LRUKReplacer(max_pool_size_, options_.lru_k);
+        else if (options_.replacer == "LOCK_FREE_CLOCK")
+            // 只有FetchPinnedPage在latch_之外调用替换策略, 其余调用仍由latch_串行化
+            replacer_ = new LockFreeClockReplacer(max_pool_size_);
+        else {
+            LOG_WARN("BufferPoolManager Replacer type defined wrong, use LRU as replacer.\n");
+            replacer_ = new LRUReplacer(max_pool_size_);
+        }
+        // Initially, every page is in the free list.
+        for (size_t i = 0; i < pool_size; ++i) {
+            free_list_.emplace_back(static_cast<frame_id_t>(i));  // static_cast转换数据类型
+        }
+        if (enable_cleaner) {
+            cleaner_thread_ = std::thread(&BufferPoolManagerInstance::RunCleaner, this);
+        }
+    }
+
+    /**
+     * @brief Destroy the Buffer Pool object
+     *
+     */
+    ~BufferPoolManagerInstance() override {
+        if (cleaner_thread_.joinable()) {
+            {
+                std::scoped_lock lock{latch_};
+                stop_cleaner_ = true;
+            }
+            cleaner_cv_.notify_all();
+            cleaner_thread_.join();
+        }
+        delete replacer_;
+    }
+
+   public:
+    /** @return size of the buffer pool */
+    size_t GetPoolSize() override { return pool_size_; }
+
+    /**
+     * Fetch the requested page from the buffer pool.
+     * @param page_id id of page to be fetched
+     * @param strategy 缺页时使用的访问策略, nullptr表示正常从free_list_/replacer中取帧
+     * @return the requested page
+     */
+    Page *FetchPage(PageId page_id, BufferAccessStrategy *strategy = nullptr) override;
+
+    /**
+     * Unpin the target page from the buffer pool.
+     * @param page_id id of page to be unpinned
+     * @param is_dirty true if the page should be marked as dirty, false otherwise
+     * @return false if the page pin count is <= 0 before this call, true otherwise
+     */
+    bool UnpinPage(PageId page_id, bool is_dirty) override;
+
+    /**
+     * Flushes the target page to disk.
+     * @param page_id id of page to be flushed, cannot be INVALID_PAGE_ID
+     * @return false if the page could not be found in the page table, true otherwise
+     */
+    bool FlushPage(PageId page_id) override;
+
+    /**
+     * Creates a new page in the buffer pool.
+     * @param[out] page_id id of created page
+     * @return nullptr if no new pages could be created, otherwise pointer to new page
+     */
+    Page *NewPage(PageId *page_id) override;
+
+    /**
+     * @brief 为已分配的page_id创建新页面, 由ParallelBufferPoolManager在page_id对应的分片中调用
+     * @return nullptr if no frame is available, otherwise pointer to new page
+     */
+    Page *CreatePage(PageId page_id);
+
+    /**
+     * Deletes a page from the buffer pool.
+     * @param page_id id of page to be deleted
+     * @return false if the page exists but could not be deleted, true if the page didn't exist or deletion succeeded
+     */
+    bool DeletePage(PageId page_id) override;
+
+    /**
+     * Flushes all the pages in the buffer pool to disk.
+     */
+    void FlushAllPages(int fd) override;
+
+    /**
+     * @brief 将strategy的ring中的帧归还给缓冲池
+     */
+    void ReleaseAccessStrategy(BufferAccessStrategy *strategy) override;
+
+    void Prefetch(PageId start, int num_pages, BufferAccessStrategy *strategy = nullptr) override {
+        if (prefetcher_ != nullptr) prefetcher_->Prefetch(start, num_pages, strategy);
+    }
+
+    /**
+     * @brief 设置预读线程, 需在访问缓冲池之前调用
+     * @note 作为ParallelBufferPoolManager的分片时, 所有分片共用一个预读线程
+     */
+    void SetPrefetcher(Prefetcher *prefetcher) { prefetcher_ = prefetcher; }
+
+    BufferPoolStats GetStats() override {
+        std::scoped_lock lock{latch_};
+        return stats_;
+    }
+
+    void CancelPrefetch(int fd) override {
+        if (prefetcher_ != nullptr) prefetcher_->Forget(fd);
+    }
+
+    /**
+     * @brief 设置压缩缓存, 需在访问缓冲池之前调用
+     * @note 作为ParallelBufferPoolManager的分片时, 所有分片共用一个压缩缓存
+     */
+    void SetCompressedCache(CompressedPageCache *compressed_cache) { compressed_cache_ = compressed_cache; }
+
+    void DropCompressedPages(int fd) override {
+        if (compressed_cache_ != nullptr) compressed_cache_->EraseFile(fd);
+    }
+
+    std::vector<PageId> GetResidentPages() override;
+
+    size_t Resize(size_t new_size) override;
+
+    void SetFileQuota(int fd, size_t max_frames) override;
+
+    size_t GetFileFrames(int fd) override;
+
+    void DiscardPages(int fd) override;
+
+    /** @return Resize可达到的最大帧数 */
+    size_t GetMaxPoolSize() const { return max_pool_size_; }
+
+   private:
+    /** @return 帧frame_id的描述符 */
+    Page *GetFramePage(frame_id_t frame_id) {
+        return &page_chunks_[frame_id / FRAME_CHUNK_SIZE][frame_id % FRAME_CHUNK_SIZE];
+    }
+
+    void AllocateFrames(size_t num_frames);
+
+    bool WriteBackFrame(std::unique_lock<std::mutex> &lock, frame_id_t frame_id);
+
+    size_t ShrinkFrames(std::unique_lock<std::mutex> &lock, size_t new_size);
+
+    bool FindVictimPage(frame_id_t *frame_id);
+
+    bool FindOverQuotaVictim(frame_id_t *frame_id);
+
+    void SetFramePageId(Page *page, PageId page_id);
+
+    bool AcquireFrame(BufferAccessStrategy *strategy, frame_id_t *frame_id);
+
+    void UpdatePage(std::unique_lock<std::mutex> &lock, Page *page, PageId new_page_id, frame_id_t new_frame_id,
+                    bool read_from_disk, bool reserve = false);
+
+    Page *FetchPinnedPage(PageId page_id);
+
+    bool LookupPage(std::unique_lock<std::mutex> &lock, PageId page_id, frame_id_t *frame_id);
+
+    bool GetRingVictim(BufferAccessStrategy *strategy, frame_id_t *frame_id);
+
+    void AddToRing(BufferAccessStrategy *strategy, frame_id_t frame_id);
+
+    void RunCleaner();
+
+    void CleanDirtyPages(std::unique_lock<std::mutex> &lock);
+
+    Page *ReservePage(PageId page_id, BufferAccessStrategy *strategy);
+
+    void UpdateDirtyFrames(frame_id_t frame_id);
+
+    std::vector<Page *> BeginFlush(int fd);
+
+    void EndFlush(const std::vector<Page *> &pages, const std::vector<bool> &written);
+
+    static std::exception_ptr WritePages(DiskManager *disk_manager, std::vector<Page *> *pages,
+                                         std::vector<bool> *written);
+
+    void CompleteReservedPage(Page *page, bool success);
+};
\ No newline at end of file
@@ -22,11 +22,18 @@
 //
 //===----------------------------------------------------------------------===//
 
-#include "buffer_pool_manager.h"
+#include "buffer_pool_manager_instance.h"
+#include "buffer_access_strategy.h"
+#include "async_io.h"
 
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstring>
 #include <ctime>
+#include <fstream>
 #include <string>
 #include <thread>
 #include <unordered_map>
@@ -108,7 +115,7 @@ TEST_F(BufferPoolManagerTest, SimpleTest) {
     // create BufferPoolManager
     const size_t buffer_pool_size = 10;
     auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
-    auto bpm = std::make_unique<BufferPoolManager>(buffer_pool_size, disk_manager);
+    auto bpm = std::make_unique<BufferPoolManagerInstance>(buffer_pool_size, disk_manager);
     // create and open file
     disk_manager_->create_file(filename);
     int fd = disk_manager_->open_file(filename);
@@ -166,7 +173,7 @@ TEST_F(BufferPoolManagerTest, LargeScaleTest) {
     // create BufferPoolManager
     const int buffer_pool_size = 10;
     auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
-    auto bpm = std::make_unique<BufferPoolManager>(static_cast<size_t>(buffer_pool_size), disk_manager);
+    auto bpm = std::make_unique<BufferPoolManagerInstance>(static_cast<size_t>(buffer_pool_size), disk_manager);
     // create and open file
     disk_manager_->create_file(filename);
     int fd = disk_manager_->open_file(filename);
@@ -208,7 +215,7 @@ TEST_F(BufferPoolManagerTest, LargeScaleTest) {
  */
 TEST_F(BufferPoolManagerTest, MultipleFilesTest) {
     const size_t buffer_size = MAX_FILES * MAX_PAGES / 2;
-    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(buffer_size, disk_manager_.get());
+    auto buffer_pool_manager = std::make_unique<BufferPoolManagerInstance>(buffer_size, disk_manager_.get());
 
     // mock记录生成文件的(文件fd, page在内存中的首地址)
     // page在内存中的首地址是page在内存中的备份
@@ -333,7 +340,7 @@ TEST_F(BufferPoolManagerTest, ConcurrencyTest) {
     for (int run = 0; run < num_runs; run++) {
         // create BufferPoolManager
         std::shared_ptr<BufferPoolManager> bpm{
-            new BufferPoolManager(static_cast<size_t>(buffer_pool_size), disk_manager)};
+            new BufferPoolManagerInstance(static_cast<size_t>(buffer_pool_size), disk_manager)};
 
         PageId tmp_page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
         std::vector<PageId> page_ids;
@@ -451,3 +458,764 @@ TEST_F(BufferPoolManagerTest, ConcurrencyTest) {
 
     disk_manager_->close_file(fd);
 }
+
+/**
+ * @brief 多线程同时换入换出同一批页面，磁盘I/O期间不持有latch_
+ * @note 并发请求同一页面的线程只能得到同一个帧，且内容必须是完整写回/读入后的数据
+ */
+TEST_F(BufferPoolManagerTest, ConcurrentMissTest) {
+    const int num_threads = 8;
+    const int num_pages = 64;
+    const int num_runs = 2000;
+    const std::string filename = "concurrent_miss_test";
+    const size_t buffer_pool_size = 16;
+
+    auto bpm = std::make_unique<BufferPoolManagerInstance>(buffer_pool_size, disk_manager_.get());
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+
+    for (int i = 0; i < num_pages; i++) {
+        PageId tmp_page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+        auto *page = bpm->NewPage(&tmp_page_id);
+        ASSERT_NE(nullptr, page);
+        strcpy(page->GetData(), std::to_string(tmp_page_id.page_no).c_str());
+        EXPECT_EQ(true, bpm->UnpinPage(tmp_page_id, true));
+    }
+
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.emplace_back([&bpm, tid, fd]() {
+            for (int r = 0; r < num_runs; r++) {
+                // 相邻线程访问的页面有重叠，制造对同一页面的并发缺页
+                PageId page_id = {.fd = fd, .page_no = (tid / 2 + r) % num_pages};
+                auto *page = bpm->FetchPage(page_id);
+                while (page == nullptr) {
+                    page = bpm->FetchPage(page_id);
+                }
+                EXPECT_EQ(page_id, page->GetPageId());
+                EXPECT_EQ(0, strcmp(page->GetData(), std::to_string(page_id.page_no).c_str()));
+                EXPECT_EQ(true, bpm->UnpinPage(page_id, r % 3 == 0));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    bpm->FlushAllPages(fd);
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 多线程反复命中被主线程固定的热点页面, 同时其他线程不断换入新页面
+ * @note 命中已被固定的页面不获取latch_; 热点页面在此期间不能被换出, 主线程解除固定后可以被换出
+ */
+TEST_F(BufferPoolManagerTest, PinnedHitTest) {
+    const int num_hot_pages = 4;
+    const int num_cold_pages = 64;
+    const int num_runs = 2000;
+    const std::string filename = "pinned_hit_test";
+    const size_t buffer_pool_size = 16;
+
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+    BufferPoolOptions saved = buffer_pool_options;
+    for (const char *replacer : {"LRU", "CLOCK", "LRU-K", "LOCK_FREE_CLOCK"}) {
+        buffer_pool_options.Set("replacer", replacer);
+        auto bpm = std::make_unique<BufferPoolManagerInstance>(buffer_pool_size, disk_manager_.get());
+        std::vector<PageId> hot_pages;
+        for (int i = 0; i < num_hot_pages + num_cold_pages; i++) {
+            PageId tmp_page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+            auto *page = bpm->NewPage(&tmp_page_id);
+            ASSERT_NE(nullptr, page);
+            strcpy(page->GetData(), std::to_string(tmp_page_id.page_no).c_str());
+            if (i < num_hot_pages) {
+                hot_pages.push_back(tmp_page_id);
+            } else {
+                EXPECT_EQ(true, bpm->UnpinPage(tmp_page_id, true));
+            }
+        }
+
+        std::vector<std::thread> threads;
+        for (int tid = 0; tid < 4; tid++) {
+            threads.emplace_back([&, tid]() {
+                for (int run = 0; run < num_runs; run++) {
+                    PageId page_id = hot_pages[run % num_hot_pages];
+                    if (tid % 2 == 1) page_id.page_no = num_hot_pages + (run * 7 + tid) % num_cold_pages;
+                    auto *page = bpm->FetchPage(page_id);
+                    if (page == nullptr) continue;
+                    EXPECT_EQ(0, strcmp(page->GetData(), std::to_string(page_id.page_no).c_str()));
+                    EXPECT_EQ(true, bpm->UnpinPage(page_id, false));
+                }
+            });
+        }
+        for (auto &thread : threads) thread.join();
+
+        // 热点页面仍只被主线程固定
+        for (auto &page_id : hot_pages) {
+            EXPECT_EQ(true, bpm->UnpinPage(page_id, false));
+            EXPECT_EQ(false, bpm->UnpinPage(page_id, false));
+        }
+        // 解除固定后所有帧都可以换出
+        for (size_t i = 0; i < buffer_pool_size; i++) {
+            PageId page_id = {.fd = fd, .page_no = num_hot_pages + static_cast<int>(i)};
+            ASSERT_NE(nullptr, bpm->FetchPage(page_id)) << replacer;
+        }
+        for (size_t i = 0; i < buffer_pool_size; i++) {
+            EXPECT_EQ(true, bpm->UnpinPage(PageId{fd, num_hot_pages + static_cast<int>(i)}, false));
+        }
+        bpm->FlushAllPages(fd);
+    }
+    buffer_pool_options = saved;
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 通过BufferAccessStrategy进行大表扫描后, 缓冲池中原有的热点页面不被淘汰
+ * @note 热点页面读入缓冲池后, 直接修改其在磁盘上的内容; 若热点页面仍在缓冲池中, FetchPage得到的是旧内容
+ */
+TEST_F(BufferPoolManagerTest, ScanRingTest) {
+    const int num_hot_pages = 8;
+    const int num_scan_pages = 64;
+    const size_t ring_size = 4;
+    const std::string filename = "scan_ring_test";
+    const size_t buffer_pool_size = 16;
+
+    auto bpm = std::make_unique<BufferPoolManagerInstance>(buffer_pool_size, disk_manager_.get());
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+
+    for (int i = 0; i < num_hot_pages + num_scan_pages; i++) {
+        PageId tmp_page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+        auto *page = bpm->NewPage(&tmp_page_id);
+        ASSERT_NE(nullptr, page);
+        strcpy(page->GetData(), std::to_string(tmp_page_id.page_no).c_str());
+        EXPECT_EQ(true, bpm->UnpinPage(tmp_page_id, true));
+    }
+    bpm->FlushAllPages(fd);
+
+    auto load_hot_pages = [&]() {
+        char buf[PAGE_SIZE] = "stale";
+        for (int i = 0; i < num_hot_pages; i++) {
+            PageId page_id = {.fd = fd, .page_no = i};
+            auto *page = bpm->FetchPage(page_id);
+            ASSERT_NE(nullptr, page);
+            EXPECT_EQ(true, bpm->UnpinPage(page_id, false));
+            disk_manager_->write_page(fd, i, buf, PAGE_SIZE);
+        }
+    };
+    auto scan = [&](BufferAccessStrategy *strategy) {
+        for (int i = num_hot_pages; i < num_hot_pages + num_scan_pages; i++) {
+            PageId page_id = {.fd = fd, .page_no = i};
+            auto *page = bpm->FetchPage(page_id, strategy);
+            ASSERT_NE(nullptr, page);
+            EXPECT_EQ(0, strcmp(page->GetData(), std::to_string(i).c_str()));
+            EXPECT_EQ(true, bpm->UnpinPage(page_id, false));
+        }
+    };
+
+    // 使用ring扫描, 热点页面仍在缓冲池中
+    load_hot_pages();
+    {
+        BufferAccessStrategy strategy(bpm.get(), ring_size);
+        scan(&strategy);
+    }
+    for (int i = 0; i < num_hot_pages; i++) {
+        PageId page_id = {.fd = fd, .page_no = i};
+        auto *page = bpm->FetchPage(page_id);
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ(0, strcmp(page->GetData(), std::to_string(i).c_str()));
+        EXPECT_EQ(true, bpm->UnpinPage(page_id, false));
+    }
+
+    // 不使用ring扫描, 热点页面被淘汰, 重新读入的是磁盘上的内容
+    scan(nullptr);
+    for (int i = 0; i < num_hot_pages; i++) {
+        PageId page_id = {.fd = fd, .page_no = i};
+        auto *page = bpm->FetchPage(page_id);
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ(0, strcmp(page->GetData(), "stale"));
+        EXPECT_EQ(true, bpm->UnpinPage(page_id, false));
+    }
+
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 提交的请求在调用者线程中同步执行; 关闭闸门后, 提交的线程阻塞到闸门重新打开时才执行请求
+ * @note 用于在测试中让写回停在I/O进行中的状态
+ */
+class GatedAsyncIO : public AsyncIO {
+   public:
+    const char *Name() const override { return "gated"; }
+
+    void Close() {
+        std::scoped_lock lock{latch_};
+        open_ = false;
+    }
+
+    void Open() {
+        {
+            std::scoped_lock lock{latch_};
+            open_ = true;
+        }
+        cv_.notify_all();
+    }
+
+    /** @brief 等待有线程阻塞在闸门上 */
+    void WaitBlocked() {
+        std::unique_lock lock{latch_};
+        cv_.wait(lock, [this] { return num_blocked_ > 0; });
+    }
+
+   protected:
+    void SubmitRequests(std::deque<IORequest> *requests) override {
+        {
+            std::unique_lock lock{latch_};
+            num_blocked_++;
+            cv_.notify_all();
+            cv_.wait(lock, [this] { return open_; });
+            num_blocked_--;
+        }
+        for (auto &request : *requests) {
+            off_t off = static_cast<off_t>(request.start_page_no) * PAGE_SIZE;
+            int count = static_cast<int>(request.iov.size());
+            ssize_t bytes = request.op == IOOpType::READ ? preadv(request.fd, request.iov.data(), count, off)
+                                                         : pwritev(request.fd, request.iov.data(), count, off);
+            Complete(&request, bytes < 0 ? -errno : bytes);
+        }
+    }
+
+   private:
+    std::mutex latch_;
+    std::condition_variable cv_;
+    bool open_ = true;
+    int num_blocked_ = 0;
+};
+
+/**
+ * @brief FlushAllPages写回ring中的脏页期间, 扫描不能复用这些帧
+ * @note 否则帧被换成新页面, 写回的是新页面的内容, 旧页面在磁盘上被破坏
+ */
+TEST_F(BufferPoolManagerTest, FlushDuringScanRingTest) {
+    const int num_pages = 8;
+    const size_t ring_size = 4;
+    const std::string filename = "flush_during_scan_ring_test";
+    const size_t buffer_pool_size = 16;
+
+    auto gated_io = std::make_unique<GatedAsyncIO>();
+    GatedAsyncIO *gate = gated_io.get();
+    disk_manager_->set_async_io(std::move(gated_io));
+    auto bpm = std::make_unique<BufferPoolManagerInstance>(buffer_pool_size, disk_manager_.get());
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+
+    // 之后创建的buffer_pool_size个页面将扫描的页面挤出缓冲池, 扫描时缺页, 帧进入ring
+    for (int i = 0; i < num_pages + static_cast<int>(buffer_pool_size); i++) {
+        PageId tmp_page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+        auto *page = bpm->NewPage(&tmp_page_id);
+        ASSERT_NE(nullptr, page);
+        strcpy(page->GetData(), std::to_string(tmp_page_id.page_no).c_str());
+        EXPECT_EQ(true, bpm->UnpinPage(tmp_page_id, true));
+    }
+    bpm->FlushAllPages(fd);
+
+    BufferAccessStrategy strategy(bpm.get(), ring_size);
+    auto scan = [&](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            PageId page_id = {.fd = fd, .page_no = i};
+            auto *page = bpm->FetchPage(page_id, &strategy);
+            ASSERT_NE(nullptr, page);
+            EXPECT_EQ(0, strcmp(page->GetData(), std::to_string(i).c_str()));
+            strcpy(page->GetData(), ("scanned " + std::to_string(i)).c_str());
+            EXPECT_EQ(true, bpm->UnpinPage(page_id, true));
+        }
+    };
+
+    // ring已满且其中都是脏页, 写回停在I/O进行中时继续扫描
+    scan(0, static_cast<int>(ring_size));
+    gate->Close();
+    std::thread flusher([&]() { bpm->FlushAllPages(fd); });
+    gate->WaitBlocked();
+    scan(static_cast<int>(ring_size), num_pages);
+    gate->Open();
+    flusher.join();
+    bpm->FlushAllPages(fd);
+
+    char buf[PAGE_SIZE];
+    for (int i = 0; i < num_pages; i++) {
+        disk_manager_->read_page(fd, i, buf, PAGE_SIZE);
+        EXPECT_EQ(0, strcmp(buf, ("scanned " + std::to_string(i)).c_str()));
+    }
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 后台写回线程将淘汰端的脏页写回磁盘, 之后的淘汰都选到干净的victim
+ */
+TEST_F(BufferPoolManagerTest, BackgroundCleanerTest) {
+    const std::string filename = "background_cleaner_test";
+    const size_t buffer_pool_size = 16;
+
+    auto bpm = std::make_unique<BufferPoolManagerInstance>(buffer_pool_size, disk_manager_.get(), true);
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+
+    for (size_t i = 0; i < buffer_pool_size; i++) {
+        PageId tmp_page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+        auto *page = bpm->NewPage(&tmp_page_id);
+        ASSERT_NE(nullptr, page);
+        strcpy(page->GetData(), std::to_string(tmp_page_id.page_no).c_str());
+        EXPECT_EQ(true, bpm->UnpinPage(tmp_page_id, true));
+    }
+
+    // 等待写回线程写回所有脏页
+    for (int i = 0; i < 100 && bpm->GetStats().cleaner_writes < buffer_pool_size; i++) {
+        std::this_thread::sleep_for(BG_CLEANER_INTERVAL);
+    }
+    EXPECT_EQ(buffer_pool_size, bpm->GetStats().cleaner_writes);
+
+    char buf[PAGE_SIZE];
+    for (size_t i = 0; i < buffer_pool_size; i++) {
+        disk_manager_->read_page(fd, static_cast<int>(i), buf, PAGE_SIZE);
+        EXPECT_EQ(0, strcmp(buf, std::to_string(i).c_str()));
+    }
+
+    for (size_t i = 0; i < buffer_pool_size; i++) {
+        PageId tmp_page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+        auto *page = bpm->NewPage(&tmp_page_id);
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ(true, bpm->UnpinPage(tmp_page_id, false));
+    }
+    auto stats = bpm->GetStats();
+    EXPECT_EQ(buffer_pool_size, stats.evictions);
+    EXPECT_EQ(buffer_pool_size, stats.clean_evictions);
+
+    bpm->FlushAllPages(fd);
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief FlushAllPages只写回脏页和被固定的页面
+ * @note 在磁盘上直接修改干净页面的内容, FlushAllPages之后磁盘上的内容不应被缓冲池中的旧内容覆盖
+ */
+TEST_F(BufferPoolManagerTest, FlushDirtyPagesTest) {
+    const int num_pages = 32;
+    const std::string filename = "flush_dirty_pages_test";
+    const size_t buffer_pool_size = 64;
+
+    auto bpm = std::make_unique<BufferPoolManagerInstance>(buffer_pool_size, disk_manager_.get());
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+
+    for (int i = 0; i < num_pages; i++) {
+        PageId tmp_page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+        auto *page = bpm->NewPage(&tmp_page_id);
+        ASSERT_NE(nullptr, page);
+        strcpy(page->GetData(), std::to_string(tmp_page_id.page_no).c_str());
+        EXPECT_EQ(true, bpm->UnpinPage(tmp_page_id, true));
+    }
+    bpm->FlushAllPages(fd);
+
+    // 偶数页面置脏, 页面1保持固定, 其余页面为干净页
+    char buf[PAGE_SIZE] = "on disk";
+    for (int i = 0; i < num_pages; i++) {
+        disk_manager_->write_page(fd, i, buf, PAGE_SIZE);
+        PageId page_id = {.fd = fd, .page_no = i};
+        auto *page = bpm->FetchPage(page_id);
+        ASSERT_NE(nullptr, page);
+        strcpy(page->GetData(), ("dirty " + std::to_string(i)).c_str());
+        if (i != 1) {
+            EXPECT_EQ(true, bpm->UnpinPage(page_id, i % 2 == 0));
+        }
+    }
+    bpm->FlushAllPages(fd);
+
+    for (int i = 0; i < num_pages; i++) {
+        disk_manager_->read_page(fd, i, buf, PAGE_SIZE);
+        if (i % 2 == 0 || i == 1) {
+            EXPECT_EQ(0, strcmp(buf, ("dirty " + std::to_string(i)).c_str()));
+        } else {
+            EXPECT_EQ(0, strcmp(buf, "on disk"));
+        }
+    }
+
+    EXPECT_EQ(true, bpm->UnpinPage(PageId{fd, 1}, false));
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 在线扩容和缩容: 扩容后可以固定更多的页面; 缩容时写回被移出的脏页, 并等待仍被固定的帧被释放
+ */
+TEST_F(BufferPoolManagerTest, ResizeTest) {
+    const std::string filename = "resize_test";
+    const size_t buffer_pool_size = 10;
+    const size_t max_pool_size = 40;
+
+    auto bpm = std::make_unique<BufferPoolManagerInstance>(buffer_pool_size, disk_manager_.get(), false, max_pool_size);
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+
+    std::vector<PageId> page_ids;
+    auto new_page = [&]() {
+        PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+        auto *page = bpm->NewPage(&page_id);
+        if (page != nullptr) {
+            strcpy(page->GetData(), std::to_string(page_id.page_no).c_str());
+            page_ids.push_back(page_id);
+        }
+        return page;
+    };
+    for (size_t i = 0; i < buffer_pool_size; i++) {
+        ASSERT_NE(nullptr, new_page());
+    }
+    EXPECT_EQ(nullptr, new_page());
+
+    // 扩容后新的帧立即可用
+    EXPECT_EQ(2 * buffer_pool_size, bpm->Resize(2 * buffer_pool_size));
+    EXPECT_EQ(2 * buffer_pool_size, bpm->GetPoolSize());
+    for (size_t i = 0; i < buffer_pool_size; i++) {
+        ASSERT_NE(nullptr, new_page());
+    }
+    EXPECT_EQ(nullptr, new_page());
+    for (auto &page_id : page_ids) {
+        EXPECT_EQ(true, bpm->UnpinPage(page_id, true));
+    }
+
+    // 最后一个帧仍被固定, 缩容等待其被释放
+    PageId last_page_id = page_ids.back();
+    ASSERT_NE(nullptr, bpm->FetchPage(last_page_id));
+    std::thread unpin_thread([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        EXPECT_EQ(true, bpm->UnpinPage(last_page_id, false));
+    });
+    EXPECT_EQ(buffer_pool_size / 2, bpm->Resize(buffer_pool_size / 2));
+    unpin_thread.join();
+    EXPECT_EQ(buffer_pool_size / 2, bpm->GetPoolSize());
+
+    // 被移出的脏页已写回磁盘
+    for (auto &page_id : page_ids) {
+        auto *page = bpm->FetchPage(page_id);
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ(0, strcmp(page->GetData(), std::to_string(page_id.page_no).c_str()));
+        EXPECT_EQ(true, bpm->UnpinPage(page_id, false));
+    }
+
+    // 超出最大帧数时限制为最大帧数
+    EXPECT_EQ(max_pool_size, bpm->Resize(max_pool_size + 1));
+    EXPECT_EQ(1, bpm->Resize(0));
+
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 多线程访问页面的同时反复扩容和缩容, 页面内容不丢失
+ */
+TEST_F(BufferPoolManagerTest, ConcurrentResizeTest) {
+    const int num_threads = 4;
+    const int num_pages = 64;
+    const int num_runs = 2000;
+    const std::string filename = "concurrent_resize_test";
+    const size_t buffer_pool_size = 16;
+
+    auto bpm = std::make_unique<BufferPoolManagerInstance>(buffer_pool_size, disk_manager_.get(), true);
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+
+    for (int i = 0; i < num_pages; i++) {
+        PageId tmp_page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+        auto *page = bpm->NewPage(&tmp_page_id);
+        ASSERT_NE(nullptr, page);
+        strcpy(page->GetData(), std::to_string(tmp_page_id.page_no).c_str());
+        EXPECT_EQ(true, bpm->UnpinPage(tmp_page_id, true));
+    }
+
+    std::atomic<bool> done{false};
+    std::thread resize_thread([&]() {
+        const size_t sizes[] = {buffer_pool_size * 4, num_threads, buffer_pool_size * 2, buffer_pool_size};
+        for (int i = 0; !done; i++) {
+            bpm->Resize(sizes[i % 4]);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.emplace_back([&bpm, tid, fd]() {
+            for (int r = 0; r < num_runs; r++) {
+                PageId page_id = {.fd = fd, .page_no = (tid * 7 + r * 3) % num_pages};
+                auto *page = bpm->FetchPage(page_id);
+                while (page == nullptr) {
+                    page = bpm->FetchPage(page_id);
+                }
+                EXPECT_EQ(page_id, page->GetPageId());
+                EXPECT_EQ(0, strcmp(page->GetData(), std::to_string(page_id.page_no).c_str()));
+                EXPECT_EQ(true, bpm->UnpinPage(page_id, r % 2 == 0));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    done = true;
+    resize_thread.join();
+
+    bpm->FlushAllPages(fd);
+    char buf[PAGE_SIZE];
+    for (int i = 0; i < num_pages; i++) {
+        disk_manager_->read_page(fd, i, buf, PAGE_SIZE);
+        EXPECT_EQ(0, strcmp(buf, std::to_string(i).c_str()));
+    }
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 超出配额的文件的页面被优先淘汰: 有配额的文件被扫描时不会挤出其他文件的热点页面
+ */
+TEST_F(BufferPoolManagerTest, FileQuotaTest) {
+    const int num_hot_pages = 8;
+    const int num_scan_pages = 64;
+    const size_t quota = 4;
+    const size_t buffer_pool_size = 16;
+
+    auto bpm = std::make_unique<BufferPoolManagerInstance>(buffer_pool_size, disk_manager_.get());
+    disk_manager_->create_file("quota_hot");
+    disk_manager_->create_file("quota_scan");
+    int hot_fd = disk_manager_->open_file("quota_hot");
+    int scan_fd = disk_manager_->open_file("quota_scan");
+    bpm->SetFileQuota(scan_fd, quota);
+
+    for (int i = 0; i < num_hot_pages; i++) {
+        PageId page_id = {.fd = hot_fd, .page_no = INVALID_PAGE_ID};
+        ASSERT_NE(nullptr, bpm->NewPage(&page_id));
+        EXPECT_EQ(true, bpm->UnpinPage(page_id, true));
+    }
+    for (int i = 0; i < num_scan_pages; i++) {
+        PageId page_id = {.fd = scan_fd, .page_no = INVALID_PAGE_ID};
+        ASSERT_NE(nullptr, bpm->NewPage(&page_id));
+        EXPECT_EQ(true, bpm->UnpinPage(page_id, true));
+    }
+    // 空闲帧用完之前不淘汰任何页面, 之后扫描的文件只淘汰自己的页面
+    EXPECT_EQ(num_hot_pages, bpm->GetFileFrames(hot_fd));
+    EXPECT_EQ(buffer_pool_size - num_hot_pages, bpm->GetFileFrames(scan_fd));
+    EXPECT_EQ(num_scan_pages - (buffer_pool_size - num_hot_pages), bpm->GetStats().quota_evictions);
+
+    // 取消配额后按replacer的顺序淘汰, 更早访问的热点页面先被淘汰
+    bpm->SetFileQuota(scan_fd, 0);
+    for (int i = 0; i < num_hot_pages; i++) {
+        PageId page_id = {.fd = scan_fd, .page_no = INVALID_PAGE_ID};
+        ASSERT_NE(nullptr, bpm->NewPage(&page_id));
+        EXPECT_EQ(true, bpm->UnpinPage(page_id, true));
+    }
+    EXPECT_EQ(0, bpm->GetFileFrames(hot_fd));
+    EXPECT_EQ(buffer_pool_size, bpm->GetFileFrames(scan_fd));
+
+    bpm->FlushAllPages(hot_fd);
+    bpm->FlushAllPages(scan_fd);
+    disk_manager_->close_file(hot_fd);
+    disk_manager_->close_file(scan_fd);
+}
+
+/**
+ * @brief 被淘汰的页面压缩后保存在第二级缓存中, 之后缺页时直接解压而不读磁盘; 关闭文件前丢弃该文件的页面
+ */
+TEST_F(BufferPoolManagerTest, CompressedCacheTest) {
+    const int num_pages = 32;
+    const size_t buffer_pool_size = 8;
+
+    auto bpm = std::make_unique<BufferPoolManagerInstance>(buffer_pool_size, disk_manager_.get());
+    CompressedPageCache compressed_cache(num_pages * PAGE_SIZE / 2);
+    bpm->SetCompressedCache(&compressed_cache);
+    disk_manager_->create_file("compressed_test");
+    int fd = disk_manager_->open_file("compressed_test");
+
+    // 页面内容为重复的文本, 可以压缩
+    auto fill_page = [](char *data, int page_no) {
+        memset(data, 0, PAGE_SIZE);
+        for (int i = 0; i < PAGE_SIZE; i += 16) {
+            snprintf(data + i, 16, "page %08d", page_no);
+        }
+    };
+    for (int i = 0; i < num_pages; i++) {
+        PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+        Page *page = bpm->NewPage(&page_id);
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ(i, page_id.page_no);
+        fill_page(page->GetData(), i);
+        EXPECT_EQ(true, bpm->UnpinPage(page_id, true));
+    }
+    EXPECT_EQ(num_pages - buffer_pool_size, compressed_cache.Size());
+
+    // 修改磁盘上的内容, 读到原内容说明页面来自压缩缓存
+    char expected[PAGE_SIZE];
+    char zeros[PAGE_SIZE] = {};
+    disk_manager_->write_page(fd, 0, zeros, PAGE_SIZE);
+    Page *page = bpm->FetchPage(PageId{.fd = fd, .page_no = 0});
+    ASSERT_NE(nullptr, page);
+    fill_page(expected, 0);
+    EXPECT_EQ(0, memcmp(expected, page->GetData(), PAGE_SIZE));
+    EXPECT_EQ(1, bpm->GetStats().compressed_hits);
+    EXPECT_EQ(true, bpm->UnpinPage(page->GetPageId(), false));
+
+    // 丢弃之后从磁盘读取
+    bpm->DropCompressedPages(fd);
+    EXPECT_EQ(0, compressed_cache.Size());
+    disk_manager_->write_page(fd, 1, zeros, PAGE_SIZE);
+    page = bpm->FetchPage(PageId{.fd = fd, .page_no = 1});
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ(0, memcmp(zeros, page->GetData(), PAGE_SIZE));
+    EXPECT_EQ(1, bpm->GetStats().compressed_hits);
+    EXPECT_EQ(true, bpm->UnpinPage(page->GetPageId(), false));
+
+    bpm->FlushAllPages(fd);
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 只读打开的文件: 缺页时帧直接指向文件的内存映射, 不可写回; 关闭前DiscardPages使帧不再指向映射
+ */
+TEST_F(BufferPoolManagerTest, MmapReadOnlyTest) {
+    const int num_pages = 32;
+    const size_t buffer_pool_size = 8;
+    const std::string filename = "mmap_test";
+
+    auto bpm = std::make_unique<BufferPoolManagerInstance>(buffer_pool_size, disk_manager_.get());
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+    for (int i = 0; i < num_pages; i++) {
+        PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+        Page *page = bpm->NewPage(&page_id);
+        ASSERT_NE(nullptr, page);
+        snprintf(page->GetData(), PAGE_SIZE, "page %d", i);
+        EXPECT_EQ(true, bpm->UnpinPage(page_id, true));
+    }
+    bpm->FlushAllPages(fd);
+    bpm->DiscardPages(fd);
+    EXPECT_EQ(0, bpm->GetFileFrames(fd));
+    disk_manager_->close_file(fd);
+
+    fd = disk_manager_->open_file(filename, true);
+    EXPECT_TRUE(disk_manager_->is_read_only(fd));
+    char expected[PAGE_SIZE];
+    // 页数多于帧数, 帧被反复换出并重新指向映射中的其他页面
+    for (int round = 0; round < 2; round++) {
+        for (int i = 0; i < num_pages; i++) {
+            PageId page_id = {.fd = fd, .page_no = i};
+            Page *page = bpm->FetchPage(page_id);
+            ASSERT_NE(nullptr, page);
+            EXPECT_EQ(disk_manager_->get_mapped_page(fd, i), page->GetData());
+            snprintf(expected, PAGE_SIZE, "page %d", i);
+            EXPECT_STREQ(expected, page->GetData());
+            // 映射中的页面不会被置脏, 淘汰时不写回
+            EXPECT_EQ(true, bpm->UnpinPage(page_id, true));
+            EXPECT_FALSE(page->IsDirty());
+        }
+    }
+    EXPECT_EQ(2 * num_pages, bpm->GetStats().mapped_reads);
+    EXPECT_THROW(disk_manager_->write_page(fd, 0, expected, PAGE_SIZE), FileReadOnlyError);
+    bpm->FlushAllPages(fd);
+
+    bpm->DiscardPages(fd);
+    disk_manager_->close_file(fd);
+    EXPECT_EQ(nullptr, disk_manager_->get_mapped_page(fd, 0));
+
+    // 丢弃后帧重新使用PageArena中的内存, 新页面可写
+    fd = disk_manager_->open_file(filename);
+    for (size_t i = 0; i < buffer_pool_size; i++) {
+        PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+        Page *page = bpm->NewPage(&page_id);
+        ASSERT_NE(nullptr, page);
+        memset(page->GetData(), 'a', PAGE_SIZE);
+        EXPECT_EQ(true, bpm->UnpinPage(page_id, true));
+    }
+    bpm->FlushAllPages(fd);
+    disk_manager_->close_file(fd);
+    disk_manager_->destroy_file(filename);
+}
+
+/**
+ * @brief 帧的页面数据位于PageArena中, 每个帧按PAGE_SIZE对齐且初始为0; 请求大页失败时退回普通页
+ */
+TEST_F(BufferPoolManagerTest, PageArenaTest) {
+    const size_t buffer_pool_size = 16;
+    auto bpm = std::make_unique<BufferPoolManagerInstance>(buffer_pool_size, disk_manager_.get());
+    const std::string filename = "page_arena_test";
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+
+    std::vector<char *> datas;
+    for (size_t i = 0; i < buffer_pool_size; i++) {
+        PageId tmp_page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+        auto *page = bpm->NewPage(&tmp_page_id);
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ(0, reinterpret_cast<uintptr_t>(page->GetData()) % PAGE_SIZE);
+        datas.push_back(page->GetData());
+    }
+    std::sort(datas.begin(), datas.end());
+    for (size_t i = 1; i < datas.size(); i++) {
+        EXPECT_EQ(PAGE_SIZE, datas[i] - datas[i - 1]);
+    }
+    for (size_t i = 0; i < buffer_pool_size; i++) {
+        EXPECT_EQ(true, bpm->UnpinPage({.fd = fd, .page_no = static_cast<int>(i)}, false));
+    }
+    disk_manager_->close_file(fd);
+    disk_manager_->destroy_file(filename);
+
+    PageArena arena(buffer_pool_size, true);
+    for (size_t i = 0; i < buffer_pool_size; i++) {
+        char *data = arena.GetFrame(i);
+        EXPECT_EQ(0, reinterpret_cast<uintptr_t>(data) % PAGE_SIZE);
+        EXPECT_EQ(0, data[0]);
+        EXPECT_EQ(0, data[PAGE_SIZE - 1]);
+        memset(data, 'a', PAGE_SIZE);
+    }
+}
+
+/**
+ * @brief 缓冲池配置可以由命令行参数和配置文件设置, 不合法的配置项抛出ConfigError
+ */
+TEST(BufferPoolOptionsTest, ParseTest) {
+    const std::string config_file = "buffer_pool_options_test.conf";
+    {
+        std::ofstream ofs(config_file);
+        ofs << "# buffer pool\n"
+            << "buffer_pool_size = 1024\n"
+            << "replacer = CLOCK   # comment\n"
+            << "\n"
+            << "bg_cleaner = off\n";
+    }
+    BufferPoolOptions options;
+    std::string args[] = {"rucbase", "--config=" + config_file, "--replacer=LRU-K", "--bg_cleaner_dirty_ratio=0.5",
+                          "db"};
+    std::vector<char *> argv;
+    for (auto &arg : args) {
+        argv.push_back(arg.data());
+    }
+    std::vector<std::string> rest = options.ParseArgs(static_cast<int>(argv.size()), argv.data());
+    EXPECT_EQ(std::vector<std::string>{"db"}, rest);
+    EXPECT_EQ(1024, options.pool_size);
+    EXPECT_EQ("LRU-K", options.replacer);
+    EXPECT_EQ(false, options.enable_cleaner);
+    EXPECT_EQ(0.5, options.cleaner_dirty_ratio);
+    EXPECT_EQ(BUFFER_POOL_INSTANCES, options.num_instances);
+    unlink(config_file.c_str());
+
+    EXPECT_THROW(options.Set("no_such_option", "1"), ConfigError);
+    EXPECT_THROW(options.Set("buffer_pool_size", "-1"), ConfigError);
+    EXPECT_THROW(options.Set("buffer_pool_size", "12abc"), ConfigError);
+    EXPECT_THROW(options.Set("replacer", "FIFO"), ConfigError);
+    EXPECT_THROW(options.Set("bg_cleaner_dirty_ratio", "2"), ConfigError);
+    EXPECT_THROW(options.LoadFile("no_such_file.conf"), FileNotFoundError);
+    options.Set("buffer_pool_instances", "2048");
+    EXPECT_THROW(options.Validate(), ConfigError);
+
+    // 每种替换策略都可以用于缓冲池
+    auto disk_manager = std::make_unique<DiskManager>();
+    BufferPoolOptions saved = buffer_pool_options;
+    for (const char *replacer : {"LRU", "CLOCK", "LRU-K", "LOCK_FREE_CLOCK"}) {
+        buffer_pool_options.Set("replacer", replacer);
+        BufferPoolManagerInstance bpm(4, disk_manager.get());
+        PageId page_id = {.fd = 0, .page_no = INVALID_PAGE_ID};
+        EXPECT_NE(nullptr, bpm.NewPage(&page_id));
+    }
+    buffer_pool_options = saved;
+}
@@ -0,0 +1,153 @@
+#include "buffer_pool_options.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include "errors.h"
+
+BufferPoolOptions buffer_pool_options;
+
+static const std::vector<std::string> REPLACER_TYPES = {"LRU", "CLOCK", "LRU-K", "LOCK_FREE_CLOCK"};
+static const std::vector<std::string> IO_BACKENDS = {"io_uring", "threads"};
+
+static std::string Trim(const std::string &str) {
+    size_t begin = str.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) return "";
+    size_t end = str.find_last_not_of(" \t\r");
+    return str.substr(begin, end - begin + 1);
+}
+
+static size_t ParseSize(const std::string &key, const std::string &value, size_t min_value) {
+    size_t pos = 0;
+    unsigned long long result = 0;
+    try {
+        result = std::stoull(value, &pos);
+    } catch (std::exception &) {
+        pos = 0;
+    }
+    if (pos == 0 || pos != value.size() || value[0] == '-' || result < min_value) {
+        throw ConfigError(key, value);
+    }
+    return static_cast<size_t>(result);
+}
+
+static bool ParseBool(const std::string &key, const std::string &value) {
+    if (value == "true" || value == "on" || value == "1") return true;
+    if (value == "false" || value == "off" || value == "0") return false;
+    throw ConfigError(key, value);
+}
+
+void BufferPoolOptions::Set(const std::string &key, const std::string &value) {
+    if (key == "buffer_pool_size") {
+        pool_size = ParseSize(key, value, 1);
+    } else if (key == "buffer_pool_max_size") {
+        max_pool_size = ParseSize(key, value, 0);
+    } else if (key == "buffer_pool_instances") {
+        num_instances = ParseSize(key, value, 1);
+    } else if (key == "replacer") {
+        bool found = false;
+        for (auto &type : REPLACER_TYPES) found = found || type == value;
+        if (!found) throw ConfigError(key, value);
+        replacer = value;
+    } else if (key == "lru_k") {
+        lru_k = ParseSize(key, value, 1);
+    } else if (key == "bg_cleaner") {
+        enable_cleaner = ParseBool(key, value);
+    } else if (key == "bg_cleaner_interval_ms") {
+        cleaner_interval = std::chrono::milliseconds(ParseSize(key, value, 1));
+    } else if (key == "bg_cleaner_dirty_ratio") {
+        size_t pos = 0;
+        double ratio = -1;
+        try {
+            ratio = std::stod(value, &pos);
+        } catch (std::exception &) {
+            pos = 0;
+        }
+        if (pos == 0 || pos != value.size() || ratio < 0 || ratio > 1) throw ConfigError(key, value);
+        cleaner_dirty_ratio = ratio;
+    } else if (key == "bg_cleaner_scan_depth") {
+        cleaner_scan_depth = ParseSize(key, value, 0);
+    } else if (key == "bg_cleaner_max_pages") {
+        cleaner_max_pages = ParseSize(key, value, 1);
+    } else if (key == "read_ahead") {
+        enable_read_ahead = ParseBool(key, value);
+    } else if (key == "compressed_cache_mb") {
+        compressed_cache_mb = ParseSize(key, value, 0);
+    } else if (key == "io_backend") {
+        if (std::find(IO_BACKENDS.begin(), IO_BACKENDS.end(), value) == IO_BACKENDS.end()) {
+            throw ConfigError(key, value);
+        }
+        io_backend = value;
+    } else if (key == "mmap_read_only") {
+        mmap_read_only = ParseBool(key, value);
+    } else if (key == "direct_io") {
+        direct_io = ParseBool(key, value);
+    } else {
+        throw ConfigError(key);
+    }
+}
+
+void BufferPoolOptions::Validate() const {
+    if (num_instances > pool_size) {
+        throw ConfigError("buffer_pool_instances", std::to_string(num_instances));
+    }
+    if (max_pool_size != 0 && max_pool_size < pool_size) {
+        throw ConfigError("buffer_pool_max_size", std::to_string(max_pool_size));
+    }
+}
+
+void BufferPoolOptions::LoadFile(const std::string &path) {
+    std::ifstream ifs(path);
+    if (!ifs) throw FileNotFoundError(path);
+    std::string line;
+    while (std::getline(ifs, line)) {
+        line = Trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+        size_t eq = line.find('=');
+        if (eq == std::string::npos) throw ConfigError(line);
+        Set(Trim(line.substr(0, eq)), Trim(line.substr(eq + 1)));
+    }
+}
+
+std::vector<std::string> BufferPoolOptions::ParseArgs(int argc, char **argv) {
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.compare(0, 2, "--") != 0) {
+            args.push_back(arg);
+            continue;
+        }
+        size_t eq = arg.find('=');
+        if (eq == std::string::npos) throw ConfigError(arg.substr(2));
+        std::string key = arg.substr(2, eq - 2);
+        std::string value = arg.substr(eq + 1);
+        if (key == "config") {
+            LoadFile(value);
+        } else {
+            Set(key, value);
+        }
+    }
+    Validate();
+    return args;
+}
+
+std::string BufferPoolOptions::ToString() const {
+    std::stringstream ss;
+    ss << "buffer_pool_size = " << pool_size << " (" << pool_size * PAGE_SIZE / (1024 * 1024) << " MB)\n"
+       << "buffer_pool_max_size = " << max_pool_size << "\n"
+       << "buffer_pool_instances = " << num_instances << "\n"
+       << "replacer = " << replacer << "\n"
+       << "lru_k = " << lru_k << "\n"
+       << "bg_cleaner = " << (enable_cleaner ? "true" : "false") << "\n"
+       << "bg_cleaner_interval_ms = " << cleaner_interval.count() << "\n"
+       << "bg_cleaner_dirty_ratio = " << cleaner_dirty_ratio << "\n"
+       << "bg_cleaner_scan_depth = " << cleaner_scan_depth << "\n"
+       << "bg_cleaner_max_pages = " << cleaner_max_pages << "\n"
+       << "read_ahead = " << (enable_read_ahead ? "true" : "false") << "\n"
+       << "compressed_cache_mb = " << compressed_cache_mb << "\n"
+       << "io_backend = " << io_backend << "\n"
+       << "mmap_read_only = " << (mmap_read_only ? "true" : "false") << "\n"
+       << "direct_io = " << (direct_io ? "true" : "false") << "\n";
+    return ss.str();
+}
@@ -0,0 +1,73 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Rucbase
+//
+// buffer_pool_options.h
+//
+// Identification: src/storage/buffer_pool_options.h
+//
+// Copyright (c) 2022, RUC Deke Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <chrono>  // NOLINT
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+
+/**
+ * @brief 缓冲池的运行时配置, 默认值为config.h中的常量
+ * @note rucbase启动时从配置文件和命令行参数设置, 之后创建的缓冲池读取这些值; 调整缓冲池大小,
+ * 替换策略和后台写回参数不需要重新编译. PAGE_SIZE决定了页面和记录的内存布局, 仍是编译期常量.
+ */
+struct BufferPoolOptions {
+    size_t pool_size = BUFFER_POOL_SIZE;             // 所有分片的帧数之和
+    size_t num_instances = BUFFER_POOL_INSTANCES;    // 分片数
+    size_t max_pool_size = 0;                        // Resize可达到的最大帧数, 0表示pool_size的BUFFER_POOL_MAX_GROWTH倍
+    std::string replacer = REPLACER_TYPE;            // LRU, CLOCK, LRU-K, LOCK_FREE_CLOCK
+    size_t lru_k = LRUK_REPLACER_K;                  // LRU-K的K
+    bool enable_cleaner = ENABLE_BG_CLEANER;
+    std::chrono::milliseconds cleaner_interval = BG_CLEANER_INTERVAL;
+    double cleaner_dirty_ratio = BG_CLEANER_DIRTY_RATIO;
+    size_t cleaner_scan_depth = BG_CLEANER_SCAN_DEPTH;
+    size_t cleaner_max_pages = BG_CLEANER_MAX_PAGES;
+    bool enable_read_ahead = ENABLE_READ_AHEAD;
+    size_t compressed_cache_mb = COMPRESSED_CACHE_MB;  // 第二级压缩缓存的大小(MB), 0表示不使用
+    std::string io_backend = ASYNC_IO_BACKEND;         // 异步I/O的实现, io_uring或threads
+    bool mmap_read_only = MMAP_READ_ONLY;              // 只读打开数据库中的数据文件, 页面直接从内存映射中访问
+    bool direct_io = DIRECT_IO;                        // 用O_DIRECT读写数据文件, 页面不再同时缓存在内核页缓存中
+
+    /**
+     * @brief 设置一个配置项, 配置项名与配置文件中的一致
+     * @throw ConfigError 未知的配置项或不合法的值
+     */
+    void Set(const std::string &key, const std::string &value);
+
+    /**
+     * @brief 检查配置项之间的约束: 每个分片至少有一个帧, max_pool_size不小于pool_size
+     * @throw ConfigError
+     */
+    void Validate() const;
+
+    /**
+     * @brief 读取配置文件, 每行为"key = value", #之后为注释
+     * @throw ConfigError 文件不存在或某一行不合法
+     */
+    void LoadFile(const std::string &path);
+
+    /**
+     * @brief 解析命令行参数: --config=<file>读取配置文件, --<key>=<value>设置配置项, 按出现顺序生效, 最后调用Validate
+     * @return 其余的参数, 不含argv[0]
+     * @throw ConfigError
+     */
+    std::vector<std::string> ParseArgs(int argc, char **argv);
+
+    /** @return 所有配置项的当前值, 每行一个"key = value" */
+    std::string ToString() const;
+};
+
+/** 进程的缓冲池配置, BufferPoolManagerInstance构造时读取替换策略和后台写回参数 */
+extern BufferPoolOptions buffer_pool_options;
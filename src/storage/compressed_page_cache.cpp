@@ -0,0 +1,86 @@
+#include "compressed_page_cache.h"
+
+#include <cstring>
+
+#include "lz_codec.h"
+
+// 不使用make_unique, 避免构造时将整个arena_清零
+CompressedPageCache::CompressedPageCache(size_t capacity) : capacity_(capacity), arena_(new char[capacity]) {}
+
+void CompressedPageCache::Put(PageId page_id, const char *data) {
+    char buf[MAX_COMPRESSED_SIZE];
+    size_t size = LZCodec::Compress(data, PAGE_SIZE, buf, sizeof(buf));
+    std::scoped_lock lock{latch_};
+    EraseLocked(page_id);
+    if (size == 0 || size > capacity_) return;
+    if (head_ + size > capacity_) {
+        // 末尾放不下时回到开头, 末尾剩余的页面是上一轮写入的, 也是最早写入的
+        while (!entries_.empty() && entries_.front().offset >= head_) PopOldest();
+        head_ = 0;
+    }
+    // 按写入顺序覆盖[head_, head_ + size)中的页面
+    while (!entries_.empty() && entries_.front().offset < head_ + size &&
+           head_ < entries_.front().offset + entries_.front().size) {
+        PopOldest();
+    }
+    memcpy(arena_.get() + head_, buf, size);
+    entries_.push_back(Entry{page_id, head_, size});
+    index_[page_id] = std::prev(entries_.end());
+    head_ += size;
+    used_bytes_ += size;
+}
+
+bool CompressedPageCache::Get(PageId page_id, char *data) {
+    char buf[MAX_COMPRESSED_SIZE];
+    size_t size = 0;
+    {
+        std::scoped_lock lock{latch_};
+        auto it = index_.find(page_id);
+        if (it == index_.end()) return false;
+        size = it->second->size;
+        memcpy(buf, arena_.get() + it->second->offset, size);
+        EraseLocked(page_id);
+    }
+    return LZCodec::Decompress(buf, size, data, PAGE_SIZE);
+}
+
+void CompressedPageCache::Erase(PageId page_id) {
+    std::scoped_lock lock{latch_};
+    EraseLocked(page_id);
+}
+
+void CompressedPageCache::EraseFile(int fd) {
+    std::scoped_lock lock{latch_};
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        auto next = std::next(it);
+        if (it->page_id.fd == fd) EraseLocked(it->page_id);
+        it = next;
+    }
+}
+
+size_t CompressedPageCache::Size() {
+    std::scoped_lock lock{latch_};
+    return entries_.size();
+}
+
+size_t CompressedPageCache::UsedBytes() {
+    std::scoped_lock lock{latch_};
+    return used_bytes_;
+}
+
+/**
+ * @brief 移除page_id的副本, 其占用的空间在之后覆盖时回收
+ */
+void CompressedPageCache::EraseLocked(PageId page_id) {
+    auto it = index_.find(page_id);
+    if (it == index_.end()) return;
+    used_bytes_ -= it->second->size;
+    entries_.erase(it->second);
+    index_.erase(it);
+}
+
+void CompressedPageCache::PopOldest() {
+    index_.erase(entries_.front().page_id);
+    used_bytes_ -= entries_.front().size;
+    entries_.pop_front();
+}
@@ -0,0 +1,87 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Rucbase
+//
+// compressed_page_cache.h
+//
+// Identification: src/storage/compressed_page_cache.h
+//
+// Copyright (c) 2022, RUC Deke Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <unordered_map>
+
+#include "common/macros.h"
+#include "page.h"
+
+/**
+ * @brief 缓冲池之后的第二级缓存, 保存被淘汰页面的压缩副本
+ * @note 缓冲池淘汰页面时将其磁盘上的内容(干净页, 或写回后的脏页)压缩后放入; 之后缺页时先在这里查找,
+ * 命中则解压到帧中并移除副本, 不再读磁盘. 工作集略大于缓冲池时, 用少量内存换取大部分磁盘读.
+ * 压缩数据按写入顺序追加到固定大小的环形区域中, 空间不足时覆盖最早写入的页面.
+ * 压缩和解压在内部的latch_之外进行, 可由多个缓冲池分片共用.
+ */
+class CompressedPageCache {
+   public:
+    /** 压缩后超过该大小的页面不放入缓存, 节省的内存太少 */
+    static constexpr size_t MAX_COMPRESSED_SIZE = PAGE_SIZE * 3 / 4;
+
+    /**
+     * @param capacity 存放压缩数据的内存大小(字节)
+     */
+    explicit CompressedPageCache(size_t capacity);
+
+    DISALLOW_COPY(CompressedPageCache);
+
+    /**
+     * @brief 放入page_id的内容, 替换之前的副本
+     * @param data 页面在磁盘上的内容, PAGE_SIZE字节
+     */
+    void Put(PageId page_id, const char *data);
+
+    /**
+     * @brief 取出page_id的内容并移除副本
+     * @param data 解压到的帧, PAGE_SIZE字节
+     * @return 是否命中
+     */
+    bool Get(PageId page_id, char *data);
+
+    /** @brief 移除page_id的副本, 页面被读入缓冲池或被删除时调用 */
+    void Erase(PageId page_id);
+
+    /** @brief 移除文件fd的所有副本, 关闭文件前调用 */
+    void EraseFile(int fd);
+
+    /** @return 缓存的页面数 */
+    size_t Size();
+
+    /** @return 缓存的页面压缩后的总字节数 */
+    size_t UsedBytes();
+
+   private:
+    struct Entry {
+        PageId page_id;
+        size_t offset;  // 压缩数据在arena_中的位置
+        size_t size;    // 压缩数据的长度
+    };
+
+    void EraseLocked(PageId page_id);
+
+    void PopOldest();
+
+    std::mutex latch_;
+    const size_t capacity_;
+    std::unique_ptr<char[]> arena_;
+    /** 下一个页面的写入位置 */
+    size_t head_ = 0;
+    size_t used_bytes_ = 0;
+    /** 按写入顺序排列, 也就是在arena_中从head_开始的环形顺序 */
+    std::list<Entry> entries_;
+    std::unordered_map<PageId, std::list<Entry>::iterator, PageIdHash> index_;
+};
@@ -0,0 +1,143 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Rucbase
+//
+// compressed_page_cache_test.cpp
+//
+// Identification: src/storage/compressed_page_cache_test.cpp
+//
+// Copyright (c) 2022, RUC Deke Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "compressed_page_cache.h"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "lz_codec.h"
+
+/**
+ * @brief 压缩后解压得到原数据, 返回压缩后的长度; 压缩结果超过dst_capacity时返回0
+ */
+static size_t RoundTrip(const std::vector<char> &src, size_t dst_capacity) {
+    std::vector<char> compressed(dst_capacity);
+    size_t size = LZCodec::Compress(src.data(), src.size(), compressed.data(), dst_capacity);
+    if (size == 0) return 0;
+    std::vector<char> decompressed(src.size());
+    EXPECT_EQ(true, LZCodec::Decompress(compressed.data(), size, decompressed.data(), decompressed.size()));
+    EXPECT_EQ(src, decompressed);
+    return size;
+}
+
+/**
+ * @brief 各种数据压缩后都能还原; 重复的数据压缩后变小, 随机数据超出输出缓冲区时返回0
+ */
+TEST(LZCodecTest, RoundTripTest) {
+    std::mt19937 rng(15445);
+    std::vector<char> zeros(PAGE_SIZE, 0);
+    EXPECT_LT(RoundTrip(zeros, PAGE_SIZE), 64);
+
+    std::vector<char> text(PAGE_SIZE);
+    for (int i = 0; i < PAGE_SIZE; i++) {
+        text[i] = "rucbase page "[i % 13];
+    }
+    EXPECT_LT(RoundTrip(text, PAGE_SIZE), 128);
+
+    // 一半为记录, 一半为空闲空间的页面
+    std::vector<char> records(PAGE_SIZE, 0);
+    for (int i = 0; i < PAGE_SIZE / 2; i++) {
+        records[i] = static_cast<char>(i % 64 < 8 ? rng() : 'a' + i % 7);
+    }
+    size_t size = RoundTrip(records, PAGE_SIZE);
+    EXPECT_GT(size, 0);
+    EXPECT_LT(size, PAGE_SIZE / 2);
+
+    std::vector<char> random(PAGE_SIZE);
+    for (auto &ch : random) ch = static_cast<char>(rng());
+    EXPECT_EQ(0, RoundTrip(random, PAGE_SIZE * 3 / 4));
+    EXPECT_GT(RoundTrip(random, PAGE_SIZE * 2), PAGE_SIZE);
+
+    // 很短的输入只有字面量
+    for (size_t length : {0, 1, 5, 12}) {
+        RoundTrip(std::vector<char>(text.begin(), text.begin() + length), 64);
+    }
+
+    // 截断或长度不符的输入解压失败
+    std::vector<char> compressed(PAGE_SIZE);
+    size = LZCodec::Compress(text.data(), text.size(), compressed.data(), compressed.size());
+    std::vector<char> decompressed(PAGE_SIZE);
+    EXPECT_EQ(false, LZCodec::Decompress(compressed.data(), size - 1, decompressed.data(), PAGE_SIZE));
+    EXPECT_EQ(false, LZCodec::Decompress(compressed.data(), size, decompressed.data(), PAGE_SIZE - 1));
+}
+
+/**
+ * @brief 取出页面后副本被移除; 空间不足时覆盖最早放入的页面; 不可压缩的页面不放入
+ */
+TEST(CompressedPageCacheTest, PutGetTest) {
+    const int fd = 3;
+    const int num_pages = 64;
+    auto fill_page = [](char *data, int page_no) {
+        memset(data, 0, PAGE_SIZE);
+        for (int i = 0; i < PAGE_SIZE; i += 16) {
+            snprintf(data + i, 16, "page %08d", page_no);
+        }
+    };
+    char data[PAGE_SIZE];
+    char expected[PAGE_SIZE];
+    fill_page(data, 0);
+    std::vector<char> compressed(PAGE_SIZE);
+    size_t page_size = LZCodec::Compress(data, PAGE_SIZE, compressed.data(), compressed.size());
+    ASSERT_GT(page_size, 0);
+
+    // 大约可以放下16个页面, 保留的是最后放入的页面
+    const size_t capacity = page_size * 16;
+    CompressedPageCache cache(capacity);
+    for (int i = 0; i < num_pages; i++) {
+        fill_page(data, i);
+        cache.Put(PageId{.fd = fd, .page_no = i}, data);
+    }
+    int num_cached = static_cast<int>(cache.Size());
+    EXPECT_GE(num_cached, 12);
+    EXPECT_LE(num_cached, 17);
+    EXPECT_LE(cache.UsedBytes(), capacity);
+    EXPECT_EQ(false, cache.Get(PageId{.fd = fd, .page_no = num_pages - num_cached - 1}, data));
+    for (int i = num_pages - num_cached; i < num_pages; i++) {
+        ASSERT_EQ(true, cache.Get(PageId{.fd = fd, .page_no = i}, data));
+        fill_page(expected, i);
+        EXPECT_EQ(0, memcmp(expected, data, PAGE_SIZE));
+        EXPECT_EQ(false, cache.Get(PageId{.fd = fd, .page_no = i}, data));
+    }
+    EXPECT_EQ(0, cache.Size());
+    EXPECT_EQ(0, cache.UsedBytes());
+
+    // 替换同一页面的副本
+    fill_page(data, 1);
+    cache.Put(PageId{.fd = fd, .page_no = 0}, data);
+    fill_page(data, 2);
+    cache.Put(PageId{.fd = fd, .page_no = 0}, data);
+    EXPECT_EQ(1, cache.Size());
+    ASSERT_EQ(true, cache.Get(PageId{.fd = fd, .page_no = 0}, data));
+    fill_page(expected, 2);
+    EXPECT_EQ(0, memcmp(expected, data, PAGE_SIZE));
+
+    // 不可压缩的页面
+    std::mt19937 rng(15445);
+    for (auto &ch : data) ch = static_cast<char>(rng());
+    cache.Put(PageId{.fd = fd, .page_no = 0}, data);
+    EXPECT_EQ(0, cache.Size());
+
+    // 按文件移除
+    for (int i = 0; i < 8; i++) {
+        fill_page(data, i);
+        cache.Put(PageId{.fd = i % 2 == 0 ? fd : fd + 1, .page_no = i}, data);
+    }
+    cache.EraseFile(fd);
+    EXPECT_EQ(4, cache.Size());
+    EXPECT_EQ(false, cache.Get(PageId{.fd = fd, .page_no = 0}, data));
+    EXPECT_EQ(true, cache.Get(PageId{.fd = fd + 1, .page_no = 1}, data));
+    cache.Erase(PageId{.fd = fd + 1, .page_no = 3});
+    EXPECT_EQ(2, cache.Size());
+}
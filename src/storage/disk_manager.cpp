@@ -2,14 +2,73 @@
 
 #include <assert.h>    // for assert
 #include <string.h>    // for memset
+#include <sys/mman.h>  // for mmap
 #include <sys/stat.h>  // for stat
+#include <sys/uio.h>   // for preadv
 #include <unistd.h>    // for lseek
 #include <fcntl.h>
 
+#include <algorithm>
+#include <climits>  // for IOV_MAX
+#include <cstdint>
+#include <cstdlib>  // for aligned_alloc
+#include <vector>
+
 #include "defs.h"
 
+namespace {
+
+/** @return 当前线程的中转页面, 按PAGE_SIZE对齐, 用于O_DIRECT下不对齐的读写 */
+char *bounce_page() {
+    struct Deleter {
+        void operator()(char *page) const { free(page); }
+    };
+    thread_local std::unique_ptr<char, Deleter> page(static_cast<char *>(aligned_alloc(PAGE_SIZE, PAGE_SIZE)));
+    if (page == nullptr) throw std::bad_alloc();
+    return page.get();
+}
+
+/** @return buf和num_bytes是否满足O_DIRECT的对齐要求 */
+bool is_aligned(const void *buf, size_t num_bytes) {
+    return reinterpret_cast<uintptr_t>(buf) % PAGE_SIZE == 0 && num_bytes % PAGE_SIZE == 0;
+}
+
+}  // namespace
+
 DiskManager::DiskManager() { memset(fd2pageno_, 0, MAX_FD * (sizeof(std::atomic<page_id_t>) / sizeof(char))); }
 
+ssize_t DiskManager::pread_page(int fd, char *buf, int num_bytes, off_t off) {
+    if (!direct_io_[fd].load() || is_aligned(buf, num_bytes)) return pread(fd, buf, num_bytes, off);
+    char *page = bounce_page();
+    ssize_t bytes = pread(fd, page, PAGE_SIZE, off);
+    if (bytes < 0) return bytes;
+    bytes = std::min<ssize_t>(bytes, num_bytes);
+    memcpy(buf, page, bytes);
+    return bytes;
+}
+
+ssize_t DiskManager::pwrite_page(int fd, const char *buf, int num_bytes, off_t off) {
+    if (!direct_io_[fd].load() || is_aligned(buf, num_bytes)) return pwrite(fd, buf, num_bytes, off);
+    // O_DIRECT只能写整个页面: 先读出页面中不被覆盖的部分, 超出文件末尾的部分补0
+    char *page = bounce_page();
+    if (num_bytes < PAGE_SIZE) {
+        ssize_t bytes = pread(fd, page, PAGE_SIZE, off);
+        if (bytes < 0) return bytes;
+        memset(page + bytes, 0, PAGE_SIZE - bytes);
+    }
+    memcpy(page, buf, num_bytes);
+    ssize_t bytes = pwrite(fd, page, PAGE_SIZE, off);
+    return bytes < 0 ? bytes : std::min<ssize_t>(bytes, num_bytes);
+}
+
+bool DiskManager::fallback_from_direct_io(int fd, int err) {
+    if (err != EINVAL || !direct_io_[fd].load()) return false;
+    int flags = fcntl(fd, F_GETFL);
+    if (flags < 0 || fcntl(fd, F_SETFL, flags & ~O_DIRECT) < 0) return false;
+    direct_io_[fd] = false;
+    return true;
+}
+
 /**
  * @brief Write the contents of the specified page into disk file
  *
@@ -19,10 +78,50 @@ void DiskManager::write_page(int fd, page_id_t page_no, const char *offset, int
     // 1.lseek()定位到文件头，通过(fd,page_no)可以定位指定页面及其在磁盘文件中的偏移量
     // 2.调用write()函数
     // 注意处理异常
-    if(page_no < 0) return;
-    int off = page_no * PAGE_SIZE;
-    int curpos = lseek(fd, off, SEEK_SET);
-    write(fd, offset, num_bytes);
+    // 使用pwrite代替lseek+write, 多个缓冲池分片并发访问同一fd时不会互相改写文件偏移
+    check_page_range(fd, page_no, 1);
+    if(is_read_only(fd)) throw FileReadOnlyError(GetFileName(fd));
+    assert(num_bytes <= PAGE_SIZE);
+    off_t off = static_cast<off_t>(page_no) * PAGE_SIZE;
+    while(pwrite_page(fd, offset, num_bytes, off) < 0) {
+        if(!fallback_from_direct_io(fd, errno)) throw UnixError();
+    }
+}
+
+/**
+ * @brief Write several consecutive pages from separate memory areas with vectored writes
+ */
+void DiskManager::write_pages(int fd, page_id_t start_page_no, const char *const *bufs, int num_pages) {
+    check_page_range(fd, start_page_no, num_pages);
+    if(is_read_only(fd)) throw FileReadOnlyError(GetFileName(fd));
+    if(direct_io_[fd].load() && !std::all_of(bufs, bufs + num_pages, [](const char *buf) { return is_aligned(buf, PAGE_SIZE); })) {
+        // 有不对齐的buffer时逐页经中转页面写入
+        for(int i = 0; i < num_pages; i++) write_page(fd, start_page_no + i, bufs[i], PAGE_SIZE);
+        return;
+    }
+    std::vector<iovec> iov;
+    // 每次pwritev最多IOV_MAX个页面
+    for(int done = 0; done < num_pages;) {
+        int count = std::min(num_pages - done, IOV_MAX);
+        iov.resize(count);
+        for(int i = 0; i < count; i++) {
+            iov[i].iov_base = const_cast<char *>(bufs[done + i]);
+            iov[i].iov_len = PAGE_SIZE;
+        }
+        off_t off = static_cast<off_t>(start_page_no + done) * PAGE_SIZE;
+        ssize_t bytes = pwritev(fd, iov.data(), count, off);
+        if(bytes < 0) {
+            if(fallback_from_direct_io(fd, errno)) continue;
+            throw UnixError();
+        }
+        int num_written = static_cast<int>(bytes / PAGE_SIZE);
+        if(num_written < count) {
+            // 未写完的页面单独重写
+            write_page(fd, start_page_no + done + num_written, bufs[done + num_written], PAGE_SIZE);
+            num_written++;
+        }
+        done += num_written;
+    }
 }
 
 /**
@@ -33,28 +132,248 @@ void DiskManager::read_page(int fd, page_id_t page_no, char *offset, int num_byt
     // 1.lseek()定位到文件头，通过(fd,page_no)可以定位指定页面及其在磁盘文件中的偏移量
     // 2.调用read()函数
     // 注意处理异常
-    if(page_no < 0) return;
-    int off = page_no * PAGE_SIZE;
-    int curpos = lseek(fd, off, SEEK_SET);
-    read(fd, offset, num_bytes);
+    check_page_range(fd, page_no, 1);
+    assert(num_bytes <= PAGE_SIZE);
+    off_t off = static_cast<off_t>(page_no) * PAGE_SIZE;
+    while(pread_page(fd, offset, num_bytes, off) < 0) {
+        if(!fallback_from_direct_io(fd, errno)) throw UnixError();
+    }
+}
+
+/**
+ * @brief Read several consecutive pages into separate memory areas with a single preadv
+ */
+int DiskManager::read_pages(int fd, page_id_t start_page_no, char *const *bufs, int num_pages) {
+    if(num_pages <= 0) return 0;
+    check_page_range(fd, start_page_no, num_pages);
+    if(direct_io_[fd].load() && !std::all_of(bufs, bufs + num_pages, [](const char *buf) { return is_aligned(buf, PAGE_SIZE); })) {
+        // 有不对齐的buffer时逐页经中转页面读取, 直到读到文件末尾
+        for(int i = 0; i < num_pages; i++) {
+            ssize_t bytes;
+            off_t off = static_cast<off_t>(start_page_no + i) * PAGE_SIZE;
+            while((bytes = pread_page(fd, bufs[i], PAGE_SIZE, off)) < 0) {
+                if(!fallback_from_direct_io(fd, errno)) throw UnixError();
+            }
+            if(bytes < PAGE_SIZE) return i;
+        }
+        return num_pages;
+    }
+    std::vector<iovec> iov(num_pages);
+    for(int i = 0; i < num_pages; i++) {
+        iov[i].iov_base = bufs[i];
+        iov[i].iov_len = PAGE_SIZE;
+    }
+    off_t off = static_cast<off_t>(start_page_no) * PAGE_SIZE;
+    ssize_t bytes;
+    while((bytes = preadv(fd, iov.data(), num_pages, off)) < 0) {
+        if(!fallback_from_direct_io(fd, errno)) throw UnixError();
+    }
+    return static_cast<int>(bytes / PAGE_SIZE);
+}
+
+AsyncIO *DiskManager::get_async_io() {
+    std::call_once(async_io_once_, [this] {
+        if (async_io_ == nullptr) async_io_ = AsyncIO::Create(ASYNC_IO_BACKEND, ASYNC_IO_QUEUE_DEPTH, ASYNC_IO_THREADS);
+    });
+    return async_io_.get();
+}
+
+void DiskManager::submit_io(IOBatch *batch) {
+    for (auto &request : batch->Requests()) {
+        check_page_range(request.fd, request.start_page_no, request.num_pages);
+    }
+    get_async_io()->Submit(batch);
+}
+
+void DiskManager::wait_io(IOBatch *batch) {
+    batch->Wait();
+    for (auto &request : batch->Requests()) {
+        if (request.result < 0 && fallback_from_direct_io(request.fd, static_cast<int>(-request.result))) {
+            // 文件系统不支持O_DIRECT, 去掉O_DIRECT后同步重做整个请求
+            std::vector<char *> bufs;
+            for (auto &iov : request.iov) bufs.push_back(static_cast<char *>(iov.iov_base));
+            try {
+                if (request.op == IOOpType::READ) {
+                    request.result = static_cast<ssize_t>(read_pages(request.fd, request.start_page_no, bufs.data(),
+                                                                     request.num_pages)) * PAGE_SIZE;
+                } else {
+                    write_pages(request.fd, request.start_page_no, bufs.data(), request.num_pages);
+                    request.result = static_cast<ssize_t>(request.num_pages) * PAGE_SIZE;
+                }
+            } catch (UnixError &e) {
+                request.result = -errno;
+            }
+            continue;
+        }
+        if (request.op != IOOpType::WRITE || request.result < 0 ||
+            request.result == static_cast<ssize_t>(request.num_pages) * PAGE_SIZE) {
+            continue;
+        }
+        // 未写完的页面(包括只写了一部分的页面)同步重写
+        int done = request.PagesDone();
+        std::vector<const char *> bufs;
+        for (int i = done; i < request.num_pages; i++) {
+            bufs.push_back(static_cast<const char *>(request.iov[i].iov_base));
+        }
+        try {
+            write_pages(request.fd, request.start_page_no + done, bufs.data(), static_cast<int>(bufs.size()));
+            request.result = static_cast<ssize_t>(request.num_pages) * PAGE_SIZE;
+        } catch (UnixError &e) {
+            request.result = -errno;
+        }
+    }
 }
 
 /**
  * @brief Allocate new page (operations like create index/table)
- * For now just keep an increasing counter
+ * 先从空闲页面位图中取编号最小的页面, 没有空闲页面时在文件末尾分配
  */
 page_id_t DiskManager::AllocatePage(int fd) {
-    // Todo:
-    // 简单的自增分配策略，指定文件的页面编号加1
-    return fd2pageno_[fd]++;
+    std::scoped_lock lock{alloc_latch_};
+    FreeMap &free_map = free_maps_[fd];
+    if (free_map.num_free > 0) {
+        for (size_t i = 0; i < free_map.words.size(); i++) {
+            uint64_t word = free_map.words[i];
+            if (word == 0) continue;
+            free_map.words[i] = word & (word - 1);
+            free_map.num_free--;
+            return static_cast<page_id_t>(i * 64 + __builtin_ctzll(word));
+        }
+    }
+    page_id_t page_no = fd2pageno_[fd].load();
+    if (page_no == MAX_PAGE_NO) throw PageOutOfRangeError(fd, page_no, MAX_PAGE_NO);
+    fd2pageno_[fd] = page_no + 1;
+    if (DISK_EXTENT_PAGES > 0 && page_no >= free_map.prealloc_end) {
+        // 一次为之后的DISK_EXTENT_PAGES个页面预留连续的磁盘空间, 不改变文件大小;
+        // 文件系统不支持时之后由写入分配空间, 不影响正确性
+        page_id_t extent = std::min<page_id_t>(DISK_EXTENT_PAGES, MAX_PAGE_NO - page_no);
+        fallocate(fd, FALLOC_FL_KEEP_SIZE, static_cast<off_t>(page_no) * PAGE_SIZE,
+                  static_cast<off_t>(extent) * PAGE_SIZE);
+        free_map.prealloc_end = page_no + extent;
+    }
+    return page_no;
+}
+
+/**
+ * @brief 检查[page_no, page_no + num_pages)是否都是文件fd中已分配的页面
+ * @throw PageOutOfRangeError
+ */
+void DiskManager::check_page_range(int fd, page_id_t page_no, int num_pages) {
+    page_id_t allocated = fd2pageno_[fd].load();
+    if (page_no < 0 || num_pages < 0 || page_no > allocated - num_pages) {
+        throw PageOutOfRangeError(fd, page_no, allocated);
+    }
 }
 
 /**
  * @brief Deallocate page (operations like drop index/table)
- * Need bitmap in header page for tracking pages
- * This does not actually need to do anything for now.
+ * 在空闲页面位图中标记页面, 文件末尾连续的空闲页面从位图中移除并减小fd2pageno_, 关闭文件时截断
+ */
+void DiskManager::DeallocatePage(int fd, page_id_t page_no) {
+    std::scoped_lock lock{alloc_latch_};
+    page_id_t num_pages = fd2pageno_[fd].load();
+    if (page_no < 0 || page_no >= num_pages) throw PageOutOfRangeError(fd, page_no, num_pages);
+    FreeMap &free_map = free_maps_[fd];
+    if (free_map.words.size() <= static_cast<size_t>(page_no / 64)) free_map.words.resize(page_no / 64 + 1, 0);
+    uint64_t &word = free_map.words[page_no / 64];
+    if (word & (1ULL << (page_no % 64))) return;
+    word |= 1ULL << (page_no % 64);
+    free_map.num_free++;
+    if (page_no != num_pages - 1) return;
+    while (num_pages > 0 && (free_map.words[(num_pages - 1) / 64] & (1ULL << ((num_pages - 1) % 64)))) {
+        num_pages--;
+        free_map.words[num_pages / 64] &= ~(1ULL << (num_pages % 64));
+        free_map.num_free--;
+    }
+    while (!free_map.words.empty() && free_map.words.back() == 0) free_map.words.pop_back();
+    fd2pageno_[fd] = num_pages;
+    free_map.shrunk = true;
+}
+
+size_t DiskManager::get_free_page_count(int fd) {
+    std::scoped_lock lock{alloc_latch_};
+    auto it = free_maps_.find(fd);
+    return it == free_maps_.end() ? 0 : it->second.num_free;
+}
+
+void DiskManager::set_fd2pageno(int fd, int start_page_no) {
+    std::scoped_lock lock{alloc_latch_};
+    fd2pageno_[fd] = start_page_no;
+    auto it = free_maps_.find(fd);
+    if (it == free_maps_.end()) return;
+    FreeMap &free_map = it->second;
+    size_t num_words = (static_cast<size_t>(std::max(start_page_no, 0)) + 63) / 64;
+    if (free_map.words.size() > num_words) free_map.words.resize(num_words);
+    if (free_map.words.size() == num_words && start_page_no % 64 != 0) {
+        free_map.words.back() &= (1ULL << (start_page_no % 64)) - 1;
+    }
+    free_map.num_free = 0;
+    for (uint64_t word : free_map.words) free_map.num_free += __builtin_popcountll(word);
+}
+
+/**
+ * @brief 读入open_file打开的文件的空闲页面位图, 读入后删除附属文件
+ * @note 附属文件只在正常关闭时写入, 因此崩溃后已释放的页面不会被重新分配, 但也不会被重复分配
  */
-void DiskManager::DeallocatePage(__attribute__((unused)) page_id_t page_id) {}
+void DiskManager::load_free_map(int fd, const std::string &path) {
+    std::string map_path = path + FREE_MAP_SUFFIX;
+    if (!is_file(map_path)) return;
+    std::ifstream in(map_path, std::ios::binary);
+    page_id_t num_pages = INVALID_PAGE_ID;
+    in.read(reinterpret_cast<char *>(&num_pages), sizeof(num_pages));
+    std::vector<uint64_t> words;
+    uint64_t word;
+    while (in.read(reinterpret_cast<char *>(&word), sizeof(word))) words.push_back(word);
+    in.close();
+    unlink(map_path.c_str());
+    // 文件在关闭后被改动过时丢弃位图, 其中的页面不再重新分配
+    if (num_pages != fd2pageno_[fd].load() || words.size() > (static_cast<size_t>(num_pages) + 63) / 64) return;
+    std::scoped_lock lock{alloc_latch_};
+    FreeMap &free_map = free_maps_[fd];
+    free_map.words = std::move(words);
+    free_map.num_free = 0;
+    for (uint64_t w : free_map.words) free_map.num_free += __builtin_popcountll(w);
+}
+
+/**
+ * @brief 关闭文件前写出空闲页面位图, 并截断文件末尾已释放的页面和多余的预分配空间
+ */
+void DiskManager::save_free_map(int fd, const std::string &path) {
+    std::scoped_lock lock{alloc_latch_};
+    auto it = free_maps_.find(fd);
+    if (it == free_maps_.end()) return;
+    FreeMap &free_map = it->second;
+    page_id_t num_pages = fd2pageno_[fd].load();
+    if (free_map.num_free > 0) {
+        std::ofstream out(path + FREE_MAP_SUFFIX, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char *>(&num_pages), sizeof(num_pages));
+        out.write(reinterpret_cast<const char *>(free_map.words.data()), free_map.words.size() * sizeof(uint64_t));
+    }
+    if (free_map.shrunk || free_map.prealloc_end > 0) {
+        // 只截断释放的页面; 未释放过页面时文件大小不变, 仅回收超出文件末尾的预分配空间
+        off_t file_size = GetFileSize(path);
+        off_t size = free_map.shrunk ? std::min<off_t>(file_size, static_cast<off_t>(num_pages) * PAGE_SIZE) : file_size;
+        if (size >= 0 && ftruncate(fd, size) < 0) throw UnixError();
+    }
+    free_maps_.erase(it);
+}
+
+const char *DiskManager::get_mapped_page(int fd, page_id_t page_no) {
+    if(fd < 0 || fd >= MAX_FD || mappings_[fd].addr == nullptr) return nullptr;
+    check_page_range(fd, page_no, 1);
+    const Mapping &mapping = mappings_[fd];
+    if(page_no >= mapping.num_pages) return nullptr;
+    return mapping.addr + static_cast<size_t>(page_no) * PAGE_SIZE;
+}
+
+void DiskManager::advise_mapped_pages(int fd, page_id_t start_page_no, int num_pages) {
+    if(fd < 0 || fd >= MAX_FD || mappings_[fd].addr == nullptr) return;
+    const Mapping &mapping = mappings_[fd];
+    auto end = static_cast<page_id_t>(std::min<int64_t>(mapping.num_pages, int64_t{start_page_no} + num_pages));
+    if(start_page_no < 0 || start_page_no >= end) return;
+    madvise(mapping.addr + static_cast<size_t>(start_page_no) * PAGE_SIZE,
+            static_cast<size_t>(end - start_page_no) * PAGE_SIZE, MADV_WILLNEED);
+}
 
 bool DiskManager::is_dir(const std::string &path) {
     struct stat st;
@@ -114,12 +433,13 @@ void DiskManager::destroy_file(const std::string &path) {
     if(!is_file(path)) throw FileNotFoundError(path);
     if(path2fd_.count(path)) throw FileNotClosedError(path);
     int fd = unlink(path.c_str());
+    if(is_file(path + FREE_MAP_SUFFIX)) unlink((path + FREE_MAP_SUFFIX).c_str());
 }
 
 /**
  * @brief 用于打开指定路径文件
  */
-int DiskManager::open_file(const std::string &path) {
+int DiskManager::open_file(const std::string &path, bool read_only, bool direct_io) {
     // Todo:
     // 调用open()函数，使用O_RDWR模式
     // 注意不能重复打开相同文件，并且需要更新文件打开列表
@@ -131,13 +451,43 @@ int DiskManager::open_file(const std::string &path) {
         throw FileNotClosedError(path);
         return -1;
     }
-    int fd = open(path.c_str(), O_RDWR);
+    int flags = read_only ? O_RDONLY : O_RDWR;
+    int fd = open(path.c_str(), direct_io ? flags | O_DIRECT : flags);
+    if(fd == -1 && direct_io && errno == EINVAL) {
+        // 文件系统不支持O_DIRECT
+        direct_io = false;
+        fd = open(path.c_str(), flags);
+    }
     if(fd == -1) {
         throw FileNotOpenError(fd);
         return -1;
     }
+    if(fd >= MAX_FD) {
+        close(fd);
+        throw FileNotOpenError(fd);
+    }
     fd2path_[fd] = path;
     path2fd_[path] = fd;
+    direct_io_[fd] = direct_io;
+    // 文件中已有的页面都视为已分配, 包括最后一个不完整的页面
+    off_t file_size = GetFileSize(path);
+    fd2pageno_[fd] = static_cast<page_id_t>((std::max<off_t>(file_size, 0) + PAGE_SIZE - 1) / PAGE_SIZE);
+    Mapping &mapping = mappings_[fd];
+    mapping = Mapping{};
+    if(read_only) {
+        // 只映射完整的页面, 访问超出文件末尾的映射会产生SIGBUS; 只读文件不分配也不释放页面, 不读取空闲页面位图
+        mapping.read_only = true;
+        auto num_pages = static_cast<page_id_t>(std::max<off_t>(file_size, 0) / PAGE_SIZE);
+        if(num_pages > 0) {
+            void *addr = mmap(nullptr, static_cast<size_t>(num_pages) * PAGE_SIZE, PROT_READ, MAP_SHARED, fd, 0);
+            if(addr != MAP_FAILED) {
+                mapping.addr = static_cast<char *>(addr);
+                mapping.num_pages = num_pages;
+            }
+        }
+    } else {
+        load_free_map(fd, path);
+    }
     return fd;
 }
 
@@ -153,12 +503,20 @@ void DiskManager::close_file(int fd) {
         return;
     }
     std::string path = fd2path_[fd];
+    Mapping &mapping = mappings_[fd];
+    if(mapping.read_only) {
+        if(mapping.addr != nullptr) munmap(mapping.addr, static_cast<size_t>(mapping.num_pages) * PAGE_SIZE);
+        mapping = Mapping{};
+    } else {
+        save_free_map(fd, path);
+    }
+    direct_io_[fd] = false;
     fd2path_.erase(fd);
     path2fd_.erase(path.c_str());
     close(fd);
 }
 
-int DiskManager::GetFileSize(const std::string &file_name) {
+off_t DiskManager::GetFileSize(const std::string &file_name) {
     struct stat stat_buf;
     int rc = stat(file_name.c_str(), &stat_buf);
     return rc == 0 ? stat_buf.st_size : -1;
@@ -178,20 +536,19 @@ int DiskManager::GetFileFd(const std::string &file_name) {
     return path2fd_[file_name];
 }
 
-bool DiskManager::ReadLog(char *log_data, int size, int offset, int prev_log_end) {
+bool DiskManager::ReadLog(char *log_data, int size, off_t offset, off_t prev_log_end) {
     // read log file from the previous end
     if (log_fd_ == -1) {
         log_fd_ = open_file(LOG_FILE_NAME);
     }
     offset += prev_log_end;
-    int file_size = GetFileSize(LOG_FILE_NAME);
+    off_t file_size = GetFileSize(LOG_FILE_NAME);
     if (offset >= file_size) {
         return false;
     }
 
-    size = std::min(size, file_size - offset);
-    lseek(log_fd_, offset, SEEK_SET);
-    ssize_t bytes_read = read(log_fd_, log_data, size);
+    size = static_cast<int>(std::min<off_t>(size, file_size - offset));
+    ssize_t bytes_read = pread(log_fd_, log_data, size, offset);
     if (bytes_read != size) {
         throw UnixError();
     }
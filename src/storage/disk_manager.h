@@ -19,16 +19,31 @@
 #include <atomic>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>  // NOLINT
 #include <string>
 #include <unordered_map>
+#include <vector>
 
+#include "async_io.h"
 #include "common/config.h"
 #include "errors.h"  // for throw Exception
 
+static_assert(sizeof(off_t) == 8, "DiskManager requires 64-bit file offsets");
+
 /**
  * @brief DiskManager takes care of the allocation and deallocation of pages within a database. It performs the reading
  * and writing of pages to and from disk, providing a logical file layer within the context of a database management
  * system.
+ * @note 页面编号为32位的page_id_t, 文件偏移量按64位的off_t计算, 单个文件最多MAX_PAGE_NO个页面
+ * (PAGE_SIZE为4KB时约8TB). 读写的页面必须已分配, 即小于该文件的fd2pageno_, 否则抛出PageOutOfRangeError.
+ * 每个打开的文件有一个空闲页面位图, DeallocatePage释放的页面由AllocatePage优先重新分配, 文件末尾的空闲页面直接归还,
+ * 关闭文件时截断; 位图在close_file时写入文件名加FREE_MAP_SUFFIX的附属文件, 下次open_file时读回.
+ * @note 只读打开的文件被整体映射到内存(mmap), 缓冲池的帧直接指向映射中的页面, 不再复制到帧中.
+ * @note 以direct_io打开的文件用O_DIRECT读写, 绕过内核的页缓存, 页面只缓存在缓冲池中. O_DIRECT要求buffer地址,
+ * 文件偏移和长度都按块对齐: 缓冲池的帧已按PAGE_SIZE对齐, 其他不对齐的读写(如文件头)经每个线程的中转页面完成;
+ * 文件系统不支持O_DIRECT时(打开失败或读写返回EINVAL)退回普通读写.
  */
 class DiskManager {
    public:
@@ -41,6 +56,16 @@ class DiskManager {
      */
     void write_page(int fd, page_id_t page_no, const char *offset, int num_bytes);
 
+    /**
+     * @brief 用pwritev将多个buffer写入从start_page_no开始的连续页面
+     *
+     * @param fd 页面所在文件开启后的文件描述符
+     * @param start_page_no 第一个页面编号
+     * @param bufs 每个页面的内容, 各自PAGE_SIZE字节, 不要求相邻
+     * @param num_pages 页面个数
+     */
+    void write_pages(int fd, page_id_t start_page_no, const char *const *bufs, int num_pages);
+
     /**
      * @brief 读取指定编号的页面部分字节到buffer中
      *
@@ -51,17 +76,52 @@ class DiskManager {
      */
     void read_page(int fd, page_id_t page_no, char *offset, int num_bytes);
 
+    /**
+     * @brief 用一次preadv读取从start_page_no开始的连续num_pages个页面
+     *
+     * @param fd 页面所在文件开启后的文件描述符
+     * @param start_page_no 第一个页面编号
+     * @param bufs 每个页面的内容写入的buffer, 各自PAGE_SIZE字节, 不要求相邻
+     * @param num_pages 页面个数
+     * @return 完整读出的页面个数, 读到文件末尾时小于num_pages
+     */
+    int read_pages(int fd, page_id_t start_page_no, char *const *bufs, int num_pages);
+
+    /**
+     * @brief 提交batch中的读写请求, 不等待完成
+     * @note 缓冲池的预读, 后台写回和FlushAllPages用它将多个不相邻的读写合并为一次提交
+     */
+    void submit_io(IOBatch *batch);
+
+    /**
+     * @brief 等待submit_io提交的请求完成; 写请求只写了一部分时, 同步写完剩余的页面
+     * @note 之后由调用者检查每个请求的result, 读请求读到文件末尾时result小于请求的字节数
+     */
+    void wait_io(IOBatch *batch);
+
+    /**
+     * @brief 设置异步I/O引擎, 需在第一次submit_io之前调用; 未设置时按config.h中的默认值创建
+     */
+    void set_async_io(std::unique_ptr<AsyncIO> async_io) { async_io_ = std::move(async_io); }
+
+    AsyncIO *get_async_io();
+
     /**
      * @brief Allocate a page on disk.
      * @return the page_no of the allocated page
+     * @note 优先分配编号最小的空闲页面, 没有空闲页面时在文件末尾分配; 文件增长时按DISK_EXTENT_PAGES个页面预分配磁盘空间
      */
     page_id_t AllocatePage(int fd);
 
     /**
      * @brief Deallocate a page on disk.
-     * @param page_id id of the page to deallocate
+     * @param fd 页面所在文件开启后的文件描述符
+     * @param page_no 要释放的页面编号, 必须已分配; 重复释放同一页面没有影响
      */
-    void DeallocatePage(page_id_t page_id);
+    void DeallocatePage(int fd, page_id_t page_no);
+
+    /** @return 文件fd中已释放, 尚未重新分配的页面个数 */
+    size_t get_free_page_count(int fd);
 
     // 目录操作
     bool is_dir(const std::string &path);
@@ -77,18 +137,40 @@ class DiskManager {
 
     void destroy_file(const std::string &path);
 
-    int open_file(const std::string &path);
+    /**
+     * @brief 打开文件
+     * @param read_only 只读打开, 并将文件中完整的页面映射到内存; 映射失败时仍按普通方式读取
+     * @param direct_io 用O_DIRECT读写页面, 文件系统不支持时按普通方式读写
+     */
+    int open_file(const std::string &path, bool read_only = false, bool direct_io = false);
+
+    /** @return 文件当前是否用O_DIRECT读写 */
+    bool is_direct_io(int fd) const { return fd >= 0 && fd < MAX_FD && direct_io_[fd].load(); }
+
+    /** @return 文件是否为只读打开 */
+    bool is_read_only(int fd) const { return fd >= 0 && fd < MAX_FD && mappings_[fd].read_only; }
+
+    /**
+     * @brief 返回只读映射中页面page_no的地址
+     * @return 文件未被映射, 或页面不在映射范围内(文件末尾不完整的页面)时返回nullptr
+     * @throw PageOutOfRangeError 页面未分配
+     */
+    const char *get_mapped_page(int fd, page_id_t page_no);
+
+    /** @brief 提示内核预读映射中的[start_page_no, start_page_no + num_pages), 文件未被映射时不做任何事 */
+    void advise_mapped_pages(int fd, page_id_t start_page_no, int num_pages);
 
     void close_file(int fd);
 
-    int GetFileSize(const std::string &file_name);
+    /** @return 文件的字节数, 文件不存在时返回-1 */
+    off_t GetFileSize(const std::string &file_name);
 
     std::string GetFileName(int fd);
 
     int GetFileFd(const std::string &file_name);
 
     // LOG操作
-    bool ReadLog(char *log_data, int size, int offset, int prev_log_end);
+    bool ReadLog(char *log_data, int size, off_t offset, off_t prev_log_end);
 
     void WriteLog(char *log_data, int size);
 
@@ -96,18 +178,69 @@ class DiskManager {
 
     int GetLogFd() { return log_fd_; }
 
-    // 在fd对应文件中，从start_page_no开始分配page_no
-    void set_fd2pageno(int fd, int start_page_no) { fd2pageno_[fd] = start_page_no; }
+    // 在fd对应文件中，从start_page_no开始分配page_no, 不小于start_page_no的空闲页面不再记录
+    void set_fd2pageno(int fd, int start_page_no);
 
     page_id_t get_fd2pageno(int fd) { return fd2pageno_[fd]; }
 
     static constexpr int MAX_FD = 8192;
 
+    /** 单个文件的最大页面数 */
+    static constexpr page_id_t MAX_PAGE_NO = std::numeric_limits<page_id_t>::max();
+
+    /** 保存空闲页面位图的附属文件的后缀 */
+    static constexpr const char *FREE_MAP_SUFFIX = ".free";
+
    private:
+    /** 只读打开的文件的内存映射 */
+    struct Mapping {
+        char *addr = nullptr;     // 映射的起始地址, 未映射时为nullptr
+        page_id_t num_pages = 0;  // 映射的完整页面数
+        bool read_only = false;
+    };
+
+    /** 一个打开的文件的空闲页面位图, 第i位为1表示页面i已释放 */
+    struct FreeMap {
+        std::vector<uint64_t> words;
+        size_t num_free = 0;         // 位图中1的个数
+        page_id_t prealloc_end = 0;  // 已用fallocate预分配到的页面(不含)
+        bool shrunk = false;         // 是否归还过文件末尾的页面, 关闭时需要截断文件
+    };
+
+    void check_page_range(int fd, page_id_t page_no, int num_pages);
+
+    /**
+     * @brief 读写文件fd中从off开始的num_bytes(不超过PAGE_SIZE)个字节, O_DIRECT下不对齐时经中转页面
+     * @return 读写的字节数, 失败时为-1并设置errno
+     */
+    ssize_t pread_page(int fd, char *buf, int num_bytes, off_t off);
+
+    ssize_t pwrite_page(int fd, const char *buf, int num_bytes, off_t off);
+
+    /**
+     * @brief 读写返回err后调用: err为EINVAL且文件以O_DIRECT打开时, 去掉O_DIRECT以便重试
+     * @return 是否去掉了O_DIRECT, 为false时应报告错误
+     */
+    bool fallback_from_direct_io(int fd, int err);
+
+    void load_free_map(int fd, const std::string &path);
+
+    void save_free_map(int fd, const std::string &path);
+
     // 文件打开列表，用于记录文件是否被打开
     std::unordered_map<std::string, int> path2fd_;  //<Page文件磁盘路径,Page fd>哈希表
     std::unordered_map<int, std::string> fd2path_;  //<Page fd,Page文件磁盘路径>哈希表
 
+    std::unique_ptr<AsyncIO> async_io_;  // 异步I/O引擎, 第一次使用时创建
+    std::once_flag async_io_once_;
+
     int log_fd_ = -1;                             // log file
-    std::atomic<page_id_t> fd2pageno_[MAX_FD]{};  // 在文件fd中分配的page no个数
+    std::atomic<page_id_t> fd2pageno_[MAX_FD]{};  // 在文件fd中分配的page no个数, 修改时持有alloc_latch_
+
+    Mapping mappings_[MAX_FD];  // 只在open_file/close_file中修改, 此时该fd上没有其他访问
+
+    std::atomic<bool> direct_io_[MAX_FD]{};  // 文件是否以O_DIRECT读写, 读写时可能因退回普通读写被清除
+
+    std::mutex alloc_latch_;                      // 保护free_maps_和fd2pageno_的修改
+    std::unordered_map<int, FreeMap> free_maps_;  // fd -> 空闲页面位图
 };
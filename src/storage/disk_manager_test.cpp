@@ -14,6 +14,7 @@
 
 #include <cassert>
 #include <cstring>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -159,3 +160,279 @@ TEST_F(DiskManagerTest, PageOperation) {
     disk_manager_->destroy_file(filename);
     EXPECT_EQ(disk_manager_->is_file(filename), false);
 }
+
+/**
+ * @brief 测试异步I/O: 一批不相邻的读写请求, 超过队列长度的请求数, 多个线程同时提交, 读到文件末尾
+ * @note io_uring和线程池两种实现都测试; 内核不支持io_uring时两次测试的都是线程池
+ */
+TEST_F(DiskManagerTest, AsyncIO) {
+    const int num_threads = 4;
+    const int pages_per_thread = 64;
+    for (const char *backend : {"io_uring", "threads"}) {
+        const std::string filename = std::string("AsyncIOTestFile_") + backend;
+        if (disk_manager_->is_file(filename)) {
+            disk_manager_->destroy_file(filename);
+        }
+        disk_manager_->create_file(filename);
+        auto disk_manager = std::make_unique<DiskManager>();
+        // 队列长度小于一批的请求数, 提交时需要等待之前的请求完成
+        disk_manager->set_async_io(AsyncIO::Create(backend, 8, 2));
+        int fd = disk_manager->open_file(filename);
+        const int num_pages = num_threads * pages_per_thread;
+        // 多分配两个页面但不写入, 读这两个页面时读到文件末尾
+        disk_manager->set_fd2pageno(fd, num_pages + 2);
+
+        // 每个线程写入间隔的页面, 每个页面单独一个请求; 再用一个请求读回所有页面
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; t++) {
+            threads.emplace_back([&, t] {
+                std::vector<std::vector<char>> data(pages_per_thread, std::vector<char>(PAGE_SIZE));
+                IOBatch write_batch;
+                for (int i = 0; i < pages_per_thread; i++) {
+                    page_id_t page_no = i * num_threads + t;
+                    memset(data[i].data(), 'a' + page_no % 26, PAGE_SIZE);
+                    memcpy(data[i].data(), &page_no, sizeof(page_no));
+                    const char *buf = data[i].data();
+                    write_batch.AddWrite(fd, page_no, &buf, 1);
+                }
+                disk_manager->submit_io(&write_batch);
+                disk_manager->wait_io(&write_batch);
+                for (auto &request : write_batch.Requests()) {
+                    EXPECT_EQ(PAGE_SIZE, request.result);
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        std::vector<std::vector<char>> pages(num_pages + 2, std::vector<char>(PAGE_SIZE));
+        std::vector<char *> bufs;
+        for (auto &page : pages) {
+            bufs.push_back(page.data());
+        }
+        IOBatch read_batch;
+        // 最后一个请求超出文件末尾
+        read_batch.AddRead(fd, 0, bufs.data(), num_pages / 2);
+        read_batch.AddRead(fd, num_pages / 2, bufs.data() + num_pages / 2, num_pages / 2 + 2);
+        disk_manager->submit_io(&read_batch);
+        disk_manager->wait_io(&read_batch);
+        EXPECT_EQ(num_pages / 2, read_batch.Requests()[0].PagesDone());
+        EXPECT_EQ(num_pages / 2, read_batch.Requests()[1].PagesDone());
+        for (page_id_t page_no = 0; page_no < num_pages; page_no++) {
+            page_id_t stored;
+            memcpy(&stored, pages[page_no].data(), sizeof(stored));
+            EXPECT_EQ(page_no, stored);
+            EXPECT_EQ('a' + page_no % 26, pages[page_no][PAGE_SIZE - 1]);
+        }
+
+        // 空的batch和已关闭的fd
+        IOBatch empty_batch;
+        disk_manager->submit_io(&empty_batch);
+        disk_manager->wait_io(&empty_batch);
+        disk_manager->close_file(fd);
+        IOBatch bad_batch;
+        bad_batch.AddRead(fd, 0, bufs.data(), 1);
+        disk_manager->submit_io(&bad_batch);
+        disk_manager->wait_io(&bad_batch);
+        EXPECT_EQ(-EBADF, bad_batch.Requests()[0].result);
+        disk_manager_->destroy_file(filename);
+    }
+}
+
+/**
+ * @brief 测试超过2GB的文件偏移量, 以及读写未分配的页面
+ */
+TEST_F(DiskManagerTest, LargeFileOffset) {
+    const std::string filename = "LargeFileOffsetTestFile";
+    if (disk_manager_->is_file(filename)) {
+        disk_manager_->destroy_file(filename);
+    }
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+    EXPECT_EQ(0, disk_manager_->get_fd2pageno(fd));
+
+    // 第600000页的偏移量超过2^31, 文件中间为空洞, 不占用磁盘空间
+    const page_id_t page_no = 600000;
+    disk_manager_->set_fd2pageno(fd, page_no + 1);
+    char data[PAGE_SIZE];
+    char buf[PAGE_SIZE] = {0};
+    rand_buf(data, PAGE_SIZE);
+    disk_manager_->write_page(fd, page_no, data, PAGE_SIZE);
+    disk_manager_->read_page(fd, page_no, buf, PAGE_SIZE);
+    EXPECT_EQ(0, memcmp(data, buf, PAGE_SIZE));
+    EXPECT_EQ(static_cast<off_t>(page_no + 1) * PAGE_SIZE, disk_manager_->GetFileSize(filename));
+    EXPECT_GT(disk_manager_->GetFileSize(filename), std::numeric_limits<int32_t>::max());
+
+    // 重新打开后按文件大小恢复已分配的页面数
+    disk_manager_->close_file(fd);
+    fd = disk_manager_->open_file(filename);
+    EXPECT_EQ(page_no + 1, disk_manager_->get_fd2pageno(fd));
+    EXPECT_EQ(page_no + 1, disk_manager_->AllocatePage(fd));
+
+    // 未分配的页面和负数页号
+    EXPECT_THROW(disk_manager_->read_page(fd, page_no + 2, buf, PAGE_SIZE), PageOutOfRangeError);
+    EXPECT_THROW(disk_manager_->write_page(fd, -1, data, PAGE_SIZE), PageOutOfRangeError);
+    char *bufs[] = {buf, buf, buf};
+    EXPECT_THROW(disk_manager_->read_pages(fd, page_no, bufs, 3), PageOutOfRangeError);
+    IOBatch batch;
+    batch.AddRead(fd, page_no + 2, bufs, 1);
+    EXPECT_THROW(disk_manager_->submit_io(&batch), PageOutOfRangeError);
+
+    disk_manager_->set_fd2pageno(fd, DiskManager::MAX_PAGE_NO);
+    EXPECT_THROW(disk_manager_->AllocatePage(fd), PageOutOfRangeError);
+
+    disk_manager_->close_file(fd);
+    disk_manager_->destroy_file(filename);
+}
+
+/**
+ * @brief 测试释放页面后的重新分配, 文件末尾空闲页面的截断, 以及空闲页面位图的持久化
+ */
+TEST_F(DiskManagerTest, FreePageReuse) {
+    const std::string filename = "FreePageReuseTestFile";
+    const std::string map_filename = filename + DiskManager::FREE_MAP_SUFFIX;
+    if (disk_manager_->is_file(filename)) {
+        disk_manager_->destroy_file(filename);
+    }
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+
+    const page_id_t num_pages = 10;
+    char data[PAGE_SIZE];
+    for (page_id_t i = 0; i < num_pages; i++) {
+        EXPECT_EQ(i, disk_manager_->AllocatePage(fd));
+        rand_buf(data, PAGE_SIZE);
+        disk_manager_->write_page(fd, i, data, PAGE_SIZE);
+    }
+
+    // 中间的页面进入空闲位图, 末尾连续的空闲页面直接归还
+    disk_manager_->DeallocatePage(fd, 5);
+    disk_manager_->DeallocatePage(fd, 2);
+    disk_manager_->DeallocatePage(fd, 2);
+    disk_manager_->DeallocatePage(fd, 8);
+    EXPECT_EQ(3, disk_manager_->get_free_page_count(fd));
+    EXPECT_EQ(num_pages, disk_manager_->get_fd2pageno(fd));
+    disk_manager_->DeallocatePage(fd, 9);
+    EXPECT_EQ(2, disk_manager_->get_free_page_count(fd));
+    EXPECT_EQ(8, disk_manager_->get_fd2pageno(fd));
+    EXPECT_THROW(disk_manager_->DeallocatePage(fd, 8), PageOutOfRangeError);
+
+    // 关闭时截断文件, 空闲位图写入附属文件
+    disk_manager_->close_file(fd);
+    EXPECT_EQ(static_cast<off_t>(8) * PAGE_SIZE, disk_manager_->GetFileSize(filename));
+    EXPECT_TRUE(disk_manager_->is_file(map_filename));
+
+    // 重新打开后读回空闲位图, 先按页号从小到大复用空闲页面, 再在末尾分配
+    fd = disk_manager_->open_file(filename);
+    EXPECT_FALSE(disk_manager_->is_file(map_filename));
+    EXPECT_EQ(8, disk_manager_->get_fd2pageno(fd));
+    EXPECT_EQ(2, disk_manager_->get_free_page_count(fd));
+    EXPECT_EQ(2, disk_manager_->AllocatePage(fd));
+    EXPECT_EQ(5, disk_manager_->AllocatePage(fd));
+    EXPECT_EQ(8, disk_manager_->AllocatePage(fd));
+    EXPECT_EQ(0, disk_manager_->get_free_page_count(fd));
+
+    // 删除文件时一并删除附属文件
+    disk_manager_->DeallocatePage(fd, 3);
+    disk_manager_->close_file(fd);
+    EXPECT_TRUE(disk_manager_->is_file(map_filename));
+    disk_manager_->destroy_file(filename);
+    EXPECT_FALSE(disk_manager_->is_file(map_filename));
+}
+
+/**
+ * @brief 测试O_DIRECT读写: 对齐的页面, 不对齐的buffer, 不足一页的文件头, 以及异步I/O
+ * @note 文件系统不支持O_DIRECT时退回普通读写, 读写结果相同
+ */
+TEST_F(DiskManagerTest, DirectIO) {
+    const std::string filename = "DirectIOTestFile";
+    if (disk_manager_->is_file(filename)) {
+        disk_manager_->destroy_file(filename);
+    }
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename, false, true);
+    RecordProperty("direct_io", disk_manager_->is_direct_io(fd) ? "enabled" : "fallback");
+
+    const int num_pages = 8;
+    // 每个页面占两页的空间: 偶数页面按PAGE_SIZE对齐, 奇数页面偏移一个字节不对齐
+    const size_t arena_size = 2 * num_pages * PAGE_SIZE;
+    auto aligned = static_cast<char *>(aligned_alloc(PAGE_SIZE, arena_size));
+    auto slot = [aligned](int i) { return aligned + 2 * i * PAGE_SIZE + i % 2; };
+    std::vector<char> expected(num_pages * PAGE_SIZE);
+    rand_buf(expected.data(), num_pages * PAGE_SIZE);
+    for (int i = 0; i < num_pages; i++) {
+        EXPECT_EQ(i, disk_manager_->AllocatePage(fd));
+    }
+    const char *write_bufs[num_pages];
+    for (int i = 0; i < num_pages; i++) {
+        char *buf = slot(i);
+        memcpy(buf, expected.data() + i * PAGE_SIZE, PAGE_SIZE);
+        write_bufs[i] = buf;
+    }
+    disk_manager_->write_page(fd, 0, write_bufs[0], PAGE_SIZE);
+    disk_manager_->write_page(fd, 1, write_bufs[1], PAGE_SIZE);
+    disk_manager_->write_pages(fd, 2, write_bufs + 2, num_pages - 2);
+
+    // 不足一页的写入只覆盖页面开头, 页面其余部分不变
+    const char header[] = "file header";
+    disk_manager_->write_page(fd, 0, header, sizeof(header));
+    memcpy(expected.data(), header, sizeof(header));
+
+    std::vector<char> page(PAGE_SIZE + 1);
+    char read_header[sizeof(header)];
+    disk_manager_->read_page(fd, 0, read_header, sizeof(read_header));
+    EXPECT_STREQ(header, read_header);
+    disk_manager_->read_page(fd, 1, page.data() + 1, PAGE_SIZE);
+    EXPECT_EQ(0, memcmp(expected.data() + PAGE_SIZE, page.data() + 1, PAGE_SIZE));
+    char *read_bufs[num_pages];
+    for (int i = 0; i < num_pages; i++) {
+        read_bufs[i] = slot(i);
+    }
+    memset(aligned, 0, arena_size);
+    EXPECT_EQ(num_pages, disk_manager_->read_pages(fd, 0, read_bufs, num_pages));
+    for (int i = 0; i < num_pages; i++) {
+        EXPECT_EQ(0, memcmp(expected.data() + i * PAGE_SIZE, read_bufs[i], PAGE_SIZE));
+    }
+
+    // 异步I/O读写对齐的页面
+    char *even_bufs[num_pages / 2];
+    for (int i = 0; i < num_pages / 2; i++) {
+        even_bufs[i] = slot(2 * i);
+        memset(even_bufs[i], 'a' + i, PAGE_SIZE);
+        memset(expected.data() + 2 * i * PAGE_SIZE, 'a' + i, PAGE_SIZE);
+    }
+    IOBatch write_batch;
+    for (int i = 0; i < num_pages / 2; i++) {
+        write_batch.AddWrite(fd, 2 * i, &even_bufs[i], 1);
+    }
+    disk_manager_->submit_io(&write_batch);
+    disk_manager_->wait_io(&write_batch);
+    for (auto &request : write_batch.Requests()) {
+        EXPECT_EQ(PAGE_SIZE, request.result);
+    }
+    memset(aligned, 0, arena_size);
+    IOBatch read_batch;
+    read_batch.AddRead(fd, 0, even_bufs, 1);
+    read_batch.AddRead(fd, 2, even_bufs + 1, 1);
+    disk_manager_->submit_io(&read_batch);
+    disk_manager_->wait_io(&read_batch);
+    for (auto &request : read_batch.Requests()) {
+        EXPECT_EQ(1, request.PagesDone());
+    }
+    EXPECT_EQ(0, memcmp(expected.data(), even_bufs[0], PAGE_SIZE));
+    EXPECT_EQ(0, memcmp(expected.data() + 2 * PAGE_SIZE, even_bufs[1], PAGE_SIZE));
+    disk_manager_->close_file(fd);
+    free(aligned);
+
+    // 用普通读写打开, 读到相同的内容
+    fd = disk_manager_->open_file(filename);
+    EXPECT_FALSE(disk_manager_->is_direct_io(fd));
+    EXPECT_EQ(num_pages, disk_manager_->get_fd2pageno(fd));
+    for (int i = 0; i < num_pages; i++) {
+        disk_manager_->read_page(fd, i, page.data(), PAGE_SIZE);
+        EXPECT_EQ(0, memcmp(expected.data() + i * PAGE_SIZE, page.data(), PAGE_SIZE));
+    }
+    disk_manager_->close_file(fd);
+    disk_manager_->destroy_file(filename);
+}
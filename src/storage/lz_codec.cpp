@@ -0,0 +1,141 @@
+#include "lz_codec.h"
+
+#include <cstdint>
+#include <cstring>
+
+/** 最短的匹配长度 */
+static constexpr size_t MIN_MATCH = 4;
+/** 输入末尾的这些字节总是作为字面量输出, 查找匹配时不会读越界 */
+static constexpr size_t LAST_LITERALS = 5;
+static constexpr int HASH_BITS = 12;
+
+static inline uint32_t Load32(const char *p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline uint32_t Hash(uint32_t sequence) { return (sequence * 2654435761U) >> (32 - HASH_BITS); }
+
+/**
+ * @brief 输出长度length中超出token的部分, 每字节最多255
+ * @return 输出后的位置, 超出end时返回nullptr
+ */
+static char *WriteLength(char *op, char *end, size_t length) {
+    for (; length >= 255; length -= 255) {
+        if (op >= end) return nullptr;
+        *op++ = static_cast<char>(255);
+    }
+    if (op >= end) return nullptr;
+    *op++ = static_cast<char>(length);
+    return op;
+}
+
+/**
+ * @brief 输出一个序列: 字面量[literal, literal + literal_length), 以及偏移为offset, 长度为match_length的匹配
+ * @note match_length为0表示最后一个只有字面量的序列
+ * @return 输出后的位置, 超出end时返回nullptr
+ */
+static char *WriteSequence(char *op, char *end, const char *literal, size_t literal_length, size_t offset,
+                           size_t match_length) {
+    if (op >= end) return nullptr;
+    char *token = op++;
+    size_t match_code = match_length == 0 ? 0 : match_length - MIN_MATCH;
+    *token = static_cast<char>(((literal_length < 15 ? literal_length : 15) << 4) | (match_code < 15 ? match_code : 15));
+    if (literal_length >= 15 && (op = WriteLength(op, end, literal_length - 15)) == nullptr) return nullptr;
+    if (static_cast<size_t>(end - op) < literal_length) return nullptr;
+    memcpy(op, literal, literal_length);
+    op += literal_length;
+    if (match_length == 0) return op;
+    if (end - op < 2) return nullptr;
+    *op++ = static_cast<char>(offset & 0xff);
+    *op++ = static_cast<char>(offset >> 8);
+    if (match_code >= 15 && (op = WriteLength(op, end, match_code - 15)) == nullptr) return nullptr;
+    return op;
+}
+
+size_t LZCodec::Compress(const char *src, size_t src_size, char *dst, size_t dst_capacity) {
+    if (src_size > MAX_INPUT_SIZE) return 0;
+    // 记录每个哈希值最近出现的位置+1, 0表示没有出现过
+    uint16_t table[1 << HASH_BITS];
+    memset(table, 0, sizeof(table));
+    char *op = dst;
+    char *end = dst + dst_capacity;
+    size_t anchor = 0;
+    size_t ip = 0;
+    while (src_size >= LAST_LITERALS + MIN_MATCH && ip + MIN_MATCH + LAST_LITERALS <= src_size) {
+        uint32_t sequence = Load32(src + ip);
+        uint32_t h = Hash(sequence);
+        size_t candidate = table[h];
+        table[h] = static_cast<uint16_t>(ip + 1);
+        if (candidate == 0 || Load32(src + candidate - 1) != sequence) {
+            ip++;
+            continue;
+        }
+        size_t ref = candidate - 1;
+        size_t match_length = MIN_MATCH;
+        while (ip + match_length + LAST_LITERALS < src_size && src[ref + match_length] == src[ip + match_length]) {
+            match_length++;
+        }
+        op = WriteSequence(op, end, src + anchor, ip - anchor, ip - ref, match_length);
+        if (op == nullptr) return 0;
+        ip += match_length;
+        anchor = ip;
+    }
+    op = WriteSequence(op, end, src + anchor, src_size - anchor, 0, 0);
+    return op == nullptr ? 0 : static_cast<size_t>(op - dst);
+}
+
+/**
+ * @brief 读取token之后的长度扩展字节
+ * @return 输入在扩展字节中间结束时返回false
+ */
+static bool ReadLength(const char **ip, const char *end, size_t *length) {
+    uint8_t byte;
+    do {
+        if (*ip >= end) return false;
+        byte = static_cast<uint8_t>(*(*ip)++);
+        *length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+bool LZCodec::Decompress(const char *src, size_t src_size, char *dst, size_t dst_size) {
+    const char *ip = src;
+    const char *ip_end = src + src_size;
+    char *op = dst;
+    char *op_end = dst + dst_size;
+    while (ip < ip_end) {
+        auto token = static_cast<uint8_t>(*ip++);
+        size_t literal_length = token >> 4;
+        if (literal_length == 15 && !ReadLength(&ip, ip_end, &literal_length)) return false;
+        if (static_cast<size_t>(ip_end - ip) < literal_length || static_cast<size_t>(op_end - op) < literal_length) {
+            return false;
+        }
+        memcpy(op, ip, literal_length);
+        ip += literal_length;
+        op += literal_length;
+        // 最后一个序列只有字面量
+        if (ip == ip_end) break;
+        if (ip_end - ip < 2) return false;
+        size_t offset = static_cast<uint8_t>(ip[0]) | (static_cast<size_t>(static_cast<uint8_t>(ip[1])) << 8);
+        ip += 2;
+        size_t match_length = token & 15;
+        if (match_length == 15 && !ReadLength(&ip, ip_end, &match_length)) return false;
+        match_length += MIN_MATCH;
+        if (offset == 0 || offset > static_cast<size_t>(op - dst) || static_cast<size_t>(op_end - op) < match_length) {
+            return false;
+        }
+        // 匹配与输出重叠(offset < match_length)时逐字节复制, 重复前面的offset个字节
+        const char *ref = op - offset;
+        if (offset >= match_length) {
+            memcpy(op, ref, match_length);
+        } else {
+            for (size_t i = 0; i < match_length; i++) {
+                op[i] = ref[i];
+            }
+        }
+        op += match_length;
+    }
+    return op == op_end;
+}
@@ -0,0 +1,41 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Rucbase
+//
+// lz_codec.h
+//
+// Identification: src/storage/lz_codec.h
+//
+// Copyright (c) 2022, RUC Deke Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @brief 面向页面的LZ77压缩算法, 格式与LZ4 block类似
+ * @note 压缩结果由若干序列组成, 每个序列为: 1字节token(高4位为字面量长度, 低4位为匹配长度-4),
+ * 长度>=15时后接若干扩展字节(每字节累加, 直到某字节小于255), 字面量, 2字节小端匹配偏移, 匹配长度的扩展字节.
+ * 最后一个序列只有字面量. 匹配用4字节哈希查找, 输入不超过64KB, 不需要额外的内存分配.
+ */
+class LZCodec {
+   public:
+    /** 可压缩的最大输入长度, 偏移量用2字节表示 */
+    static constexpr size_t MAX_INPUT_SIZE = 65535;
+
+    /**
+     * @brief 压缩src
+     * @param dst 输出缓冲区, 大小为dst_capacity
+     * @return 压缩后的长度; 压缩结果超过dst_capacity时返回0
+     */
+    static size_t Compress(const char *src, size_t src_size, char *dst, size_t dst_capacity);
+
+    /**
+     * @brief 解压Compress的输出
+     * @param dst 输出缓冲区, 解压结果必须恰好为dst_size字节
+     * @return 输入合法且解压后的长度等于dst_size时返回true
+     */
+    static bool Decompress(const char *src, size_t src_size, char *dst, size_t dst_size);
+};
@@ -0,0 +1,135 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Rucbase
+//
+// mmap_benchmark.cpp
+//
+// Identification: src/storage/mmap_benchmark.cpp
+//
+// Copyright (c) 2022, RUC Deke Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <unistd.h>
+
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "buffer_pool_manager_instance.h"
+#include "gtest/gtest.h"
+
+const std::string BENCH_DB_NAME = "MmapBenchmark_db";
+
+/**
+ * @brief 文件页数为缓冲池帧数的8倍, 缺页时分别走pread拷贝路径和mmap路径
+ */
+class MmapBenchmark : public ::testing::Test {
+   public:
+    static constexpr int NUM_PAGES = 8192;
+    static constexpr size_t POOL_SIZE = 1024;
+    const std::string filename_ = "bench_file";
+    std::unique_ptr<DiskManager> disk_manager_;
+
+    void SetUp() override {
+        disk_manager_ = std::make_unique<DiskManager>();
+        if (disk_manager_->is_dir(BENCH_DB_NAME)) {
+            disk_manager_->destroy_dir(BENCH_DB_NAME);
+        }
+        disk_manager_->create_dir(BENCH_DB_NAME);
+        if (chdir(BENCH_DB_NAME.c_str()) < 0) {
+            throw UnixError();
+        }
+        disk_manager_->create_file(filename_);
+        int fd = disk_manager_->open_file(filename_);
+        std::vector<char> buf(PAGE_SIZE);
+        for (int i = 0; i < NUM_PAGES; i++) {
+            page_id_t page_no = disk_manager_->AllocatePage(fd);
+            for (int j = 0; j < PAGE_SIZE; j += sizeof(int)) {
+                *reinterpret_cast<int *>(&buf[j]) = page_no + j;
+            }
+            disk_manager_->write_page(fd, page_no, buf.data(), PAGE_SIZE);
+        }
+        disk_manager_->close_file(fd);
+    }
+
+    void TearDown() override {
+        disk_manager_->destroy_file(filename_);
+        if (chdir("..") < 0) {
+            throw UnixError();
+        }
+        disk_manager_->destroy_dir(BENCH_DB_NAME);
+    }
+
+    /**
+     * @brief 以read_only方式打开文件, 按page_nos的顺序FetchPage并读取整个页面
+     * @return 耗时(秒), checksum为读到的所有页面内容之和, mapped_reads为直接指向映射的缺页次数
+     */
+    double Run(bool read_only, const std::vector<page_id_t> &page_nos, uint64_t *checksum, size_t *mapped_reads) {
+        auto bpm = std::make_unique<BufferPoolManagerInstance>(POOL_SIZE, disk_manager_.get());
+        int fd = disk_manager_->open_file(filename_, read_only);
+        *checksum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (page_id_t page_no : page_nos) {
+            PageId page_id = {.fd = fd, .page_no = page_no};
+            Page *page = bpm->FetchPage(page_id);
+            EXPECT_NE(nullptr, page);
+            const int *data = reinterpret_cast<const int *>(page->GetData());
+            for (size_t j = 0; j < PAGE_SIZE / sizeof(int); j++) {
+                *checksum += data[j];
+            }
+            bpm->UnpinPage(page_id, false);
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        *mapped_reads = bpm->GetStats().mapped_reads;
+        bpm->DiscardPages(fd);
+        disk_manager_->close_file(fd);
+        return elapsed.count();
+    }
+
+    /**
+     * @brief 分别用拷贝路径和mmap路径访问page_nos, 输出吞吐量并检查两者读到的内容相同
+     */
+    void Compare(const char *name, const std::vector<page_id_t> &page_nos) {
+        uint64_t copy_sum, mmap_sum;
+        size_t copy_mapped, mmap_mapped;
+        double copy_time = Run(false, page_nos, &copy_sum, &copy_mapped);
+        double mmap_time = Run(true, page_nos, &mmap_sum, &mmap_mapped);
+        double mb = static_cast<double>(page_nos.size()) * PAGE_SIZE / (1024 * 1024);
+        printf("%-12s copy: %8.3fs %9.1f MB/s   mmap: %8.3fs %9.1f MB/s\n", name, copy_time, mb / copy_time,
+               mmap_time, mb / mmap_time);
+
+        EXPECT_EQ(copy_sum, mmap_sum);
+        EXPECT_EQ(0, copy_mapped);
+        EXPECT_GT(mmap_mapped, 0);
+    }
+};
+
+/**
+ * @brief 顺序扫描整个文件若干遍
+ */
+TEST_F(MmapBenchmark, SequentialScanTest) {
+    std::vector<page_id_t> page_nos;
+    for (int round = 0; round < 4; round++) {
+        for (int i = 0; i < NUM_PAGES; i++) {
+            page_nos.push_back(i);
+        }
+    }
+    Compare("sequential", page_nos);
+}
+
+/**
+ * @brief 均匀随机访问, 缓冲池只能容纳1/8的页面
+ */
+TEST_F(MmapBenchmark, RandomLookupTest) {
+    std::vector<page_id_t> page_nos;
+    std::default_random_engine rng{15445};
+    std::uniform_int_distribution<page_id_t> page_dist(0, NUM_PAGES - 1);
+    for (int i = 0; i < 4 * NUM_PAGES; i++) {
+        page_nos.push_back(page_dist(rng));
+    }
+    Compare("random", page_nos);
+}
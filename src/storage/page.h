@@ -24,9 +24,14 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstring>
+
 #include "common/config.h"
 #include "common/rwlatch.h"
 
+class BufferAccessStrategy;
+
 /**
  @brief 存储层每个Page的id的声明
  */
@@ -46,13 +51,14 @@ struct PageIdHash {
  @brief Page类声明, Page是rucbase数据块的单位.
  @note Page是负责数据操作Record模块的操作对象.
  @note Page对象在磁盘上有文件存储, 若在Buffer中则有帧偏移, 并非特指Buffer或Disk上的数据
+ @note Page对象只是帧的描述符, 页面数据存放在缓冲池的PageArena中, 由data_指向
  */
 class Page {
-    friend class BufferPoolManager;
+    friend class BufferPoolManagerInstance;
 
    public:
-    /** Constructor. Zeros out the page data. */
-    Page() { ResetMemory(); }
+    /** Constructor. The page data is attached by the buffer pool. */
+    Page() = default;
 
     /** Default destructor. */
     ~Page() = default;
@@ -67,6 +73,9 @@ class Page {
     /** Acquire the page write latch. */
     inline void WLatch() { rwlatch_.WLock(); }
 
+    /** Try to acquire the page write latch without waiting, @return false if the latch is held */
+    inline bool TryWLatch() { return rwlatch_.TryWLock(); }
+
     /** Release the page write latch. */
     inline void WUnlatch() { rwlatch_.WUnlock(); }
 
@@ -76,6 +85,16 @@ class Page {
     /** Release the page read latch. */
     inline void RUnlatch() { rwlatch_.RUnlock(); }
 
+    /**
+     * @brief 不加读锁, 乐观地读取页面: 记录页面当前的版本号
+     * @return false表示有写者正持有写锁, 应重试或改用RLatch
+     * @note 读取结束后必须调用ValidateOptimisticLatch, 校验失败时读到的数据可能不一致, 需要丢弃
+     */
+    inline bool TryOptimisticLatch(uint64_t *version) const { return rwlatch_.TryOptimisticRead(version); }
+
+    /** @return 自TryOptimisticLatch以来没有写者修改过本页, 期间读到的数据一致 */
+    inline bool ValidateOptimisticLatch(uint64_t version) const { return rwlatch_.ValidateOptimisticRead(version); }
+
     static constexpr size_t OFFSET_PAGE_START = 0;
     static constexpr size_t OFFSET_LSN = 0;
     static constexpr size_t OFFSET_PAGE_HDR = 4;
@@ -87,19 +106,39 @@ class Page {
    private:
     void ResetMemory() { memset(data_, OFFSET_PAGE_START, PAGE_SIZE); }  // 将data_的PAGE_SIZE个字节填充为0
 
+    // 淘汰, 写回时扫描的字段放在对象开头, 相邻帧的这些字段位于连续的内存中
+
     /** page的唯一标识符 */
     PageId id_;
 
-    /** The actual data that is stored within a page.
-     *  该页面在bufferPool中的偏移地址
+    /**
+     * @brief The pin count of this page.
+     * @note 由缓冲池的latch_保护; FetchPinnedPage不持有latch_, 只将大于0的值原子地加1
      */
-    char data_[PAGE_SIZE] = {};
+    std::atomic<int> pin_count_{0};
 
     /** 脏页判断 */
     bool is_dirty_ = false;
 
-    /** The pin count of this page. */
-    int pin_count_ = 0;
+    /** 帧正在进行磁盘读写(写回旧页或读入新页), 此时缓冲池latch已释放, 其他线程需在io_cv_上等待 */
+    std::atomic<bool> io_in_progress_{false};
+
+    /** 本帧由预读线程读入且尚未被访问, 第一次命中时通知预读线程继续预读 */
+    std::atomic<bool> prefetched_{false};
+
+    /** 持有本帧的扫描ring, nullptr表示普通帧; ring中的帧解除固定后不进入replacer */
+    BufferAccessStrategy *ring_owner_ = nullptr;
+
+    /** data_指向只读文件的内存映射而不是PageArena中的帧, 页面不可修改, 也不需要写回 */
+    bool mapped_ = false;
+
+    /** The actual data that is stored within a page.
+     *  该页面在bufferPool的PageArena中的地址, 按PAGE_SIZE对齐; mapped_时为映射中的地址
+     */
+    char *data_ = nullptr;
+
+    /** 等待本帧I/O完成的条件变量, 与缓冲池的latch配合使用 */
+    std::condition_variable io_cv_;
 
     /** Page latch. */
     ReaderWriterLatch rwlatch_;
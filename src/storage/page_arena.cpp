@@ -0,0 +1,42 @@
+#include "page_arena.h"
+
+#include <sys/mman.h>
+
+#include <algorithm>
+
+#include "errors.h"
+
+/** MAP_HUGETLB使用的大页大小 */
+static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+PageArena::PageArena(size_t num_pages, bool huge_pages) : data_(nullptr), size_(num_pages * PAGE_SIZE) {
+    void *addr = MAP_FAILED;
+    if (huge_pages) {
+        size_t huge_size = (size_ + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+        addr = mmap(nullptr, huge_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (addr != MAP_FAILED) {
+            size_ = huge_size;
+            huge_pages_ = true;
+        }
+    }
+    if (addr == MAP_FAILED) {
+        // 没有预留大页时退回普通页, mmap返回的内存按系统页对齐且已清零; 只预留地址空间, 不计入内存承诺
+        addr = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (addr == MAP_FAILED) throw UnixError();
+#ifdef MADV_HUGEPAGE
+        if (huge_pages) madvise(addr, size_, MADV_HUGEPAGE);
+#endif
+    }
+    data_ = static_cast<char *>(addr);
+}
+
+void PageArena::Release(size_t begin, size_t end) {
+    if (begin >= end) return;
+    // MAP_HUGETLB的区域只能按大页归还, 不足一个大页的部分保留; 归还失败不影响正确性, 忽略错误
+    size_t unit = huge_pages_ ? HUGE_PAGE_SIZE : PAGE_SIZE;
+    size_t first = (begin * PAGE_SIZE + unit - 1) / unit * unit;
+    size_t last = std::min(end * PAGE_SIZE, size_) / unit * unit;
+    if (first < last) madvise(data_ + first, last - first, MADV_DONTNEED);
+}
+
+PageArena::~PageArena() { munmap(data_, size_); }
@@ -0,0 +1,54 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Rucbase
+//
+// page_arena.h
+//
+// Identification: src/storage/page_arena.h
+//
+// Copyright (c) 2022, RUC Deke Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+
+#include "common/config.h"
+#include "common/macros.h"
+
+/**
+ * @brief 缓冲池所有帧的页面数据所在的连续内存区域
+ * @note 由mmap分配, 起始地址和每个帧都按PAGE_SIZE对齐, 可直接用于O_DIRECT读写.
+ * 帧的元数据(Page对象)单独存放, 扫描元数据时不会每4KB跨一次cache line.
+ * 构造时按缓冲池的最大帧数预留地址空间, 物理内存在帧第一次被访问时才分配, 缓冲池扩容时地址不变.
+ */
+class PageArena {
+   public:
+    /**
+     * @param num_pages 最大帧数
+     * @param huge_pages 是否尝试使用大页(MAP_HUGETLB), 失败时退回普通页并建议内核使用透明大页
+     */
+    PageArena(size_t num_pages, bool huge_pages);
+
+    ~PageArena();
+
+    DISALLOW_COPY(PageArena);
+
+    /** @return 第frame_id个帧的页面数据 */
+    char *GetFrame(size_t frame_id) { return data_ + frame_id * PAGE_SIZE; }
+
+    /**
+     * @brief 归还[begin, end)帧占用的物理内存, 保留地址空间, 之后再访问时读到全0
+     * @note 缓冲池缩容后调用, 调用者需保证这些帧不再被使用
+     */
+    void Release(size_t begin, size_t end);
+
+    /** @return 是否由MAP_HUGETLB大页分配 */
+    bool IsHugePage() const { return huge_pages_; }
+
+   private:
+    char *data_;
+    size_t size_;
+    bool huge_pages_ = false;
+};
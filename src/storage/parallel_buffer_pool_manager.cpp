@@ -0,0 +1,161 @@
+#include "parallel_buffer_pool_manager.h"
+
+#include <algorithm>
+
+ParallelBufferPoolManager::ParallelBufferPoolManager(size_t num_instances, size_t pool_size,
+                                                     DiskManager *disk_manager, bool enable_cleaner,
+                                                     bool enable_read_ahead)
+    : num_instances_(num_instances), disk_manager_(disk_manager) {
+    assert(num_instances_ > 0);
+    size_t max_pool_size = (buffer_pool_options.max_pool_size + num_instances_ - 1) / num_instances_;
+    for (size_t i = 0; i < num_instances_; ++i) {
+        instances_.push_back(new BufferPoolManagerInstance(pool_size, disk_manager_, enable_cleaner, max_pool_size));
+    }
+    if (enable_read_ahead) {
+        prefetcher_ = std::make_unique<Prefetcher>(
+            disk_manager_, [this](PageId page_id) { return GetBufferPoolManager(page_id); });
+        for (auto instance : instances_) {
+            instance->SetPrefetcher(prefetcher_.get());
+        }
+    }
+    if (buffer_pool_options.compressed_cache_mb > 0) {
+        compressed_cache_ = std::make_unique<CompressedPageCache>(buffer_pool_options.compressed_cache_mb * 1024 * 1024);
+        for (auto instance : instances_) {
+            instance->SetCompressedCache(compressed_cache_.get());
+        }
+    }
+}
+
+ParallelBufferPoolManager::~ParallelBufferPoolManager() {
+    // 先停止预读线程, 它可能仍在访问各个分片
+    prefetcher_.reset();
+    for (auto instance : instances_) {
+        delete instance;
+    }
+}
+
+size_t ParallelBufferPoolManager::GetPoolSize() {
+    size_t pool_size = 0;
+    for (auto instance : instances_) {
+        pool_size += instance->GetPoolSize();
+    }
+    return pool_size;
+}
+
+Page *ParallelBufferPoolManager::FetchPage(PageId page_id, BufferAccessStrategy *strategy) {
+    return GetBufferPoolManager(page_id)->FetchPage(page_id, strategy);
+}
+
+bool ParallelBufferPoolManager::UnpinPage(PageId page_id, bool is_dirty) {
+    return GetBufferPoolManager(page_id)->UnpinPage(page_id, is_dirty);
+}
+
+bool ParallelBufferPoolManager::FlushPage(PageId page_id) { return GetBufferPoolManager(page_id)->FlushPage(page_id); }
+
+/**
+ * @brief 在新页面的page_no对应的分片中创建新页面
+ * @note DiskManager::AllocatePage可能重新分配已释放的页面, 无法预测, 因此先分配page_no,
+ * 再由其对应的分片创建页面; 分片已满时归还page_no并返回nullptr
+ */
+Page *ParallelBufferPoolManager::NewPage(PageId *page_id) {
+    page_id->page_no = disk_manager_->AllocatePage(page_id->fd);
+    Page *page = GetBufferPoolManager(*page_id)->CreatePage(*page_id);
+    if (page == nullptr) {
+        disk_manager_->DeallocatePage(page_id->fd, page_id->page_no);
+        page_id->page_no = INVALID_PAGE_ID;
+    }
+    return page;
+}
+
+bool ParallelBufferPoolManager::DeletePage(PageId page_id) {
+    return GetBufferPoolManager(page_id)->DeletePage(page_id);
+}
+
+/**
+ * @brief 写回文件fd在所有分片中的脏页
+ * @note 相邻的页面分布在不同的分片上, 因此先从所有分片取出需要写回的帧, 统一排序后合并为pwritev
+ */
+void ParallelBufferPoolManager::FlushAllPages(int fd) {
+    std::vector<Page *> pages;
+    for (auto instance : instances_) {
+        std::vector<Page *> instance_pages = instance->BeginFlush(fd);
+        pages.insert(pages.end(), instance_pages.begin(), instance_pages.end());
+    }
+    std::vector<bool> written;
+    std::exception_ptr error = BufferPoolManagerInstance::WritePages(disk_manager_, &pages, &written);
+    for (auto instance : instances_) {
+        instance->EndFlush(pages, written);
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+void ParallelBufferPoolManager::ReleaseAccessStrategy(BufferAccessStrategy *strategy) {
+    for (auto instance : instances_) {
+        instance->ReleaseAccessStrategy(strategy);
+    }
+}
+
+void ParallelBufferPoolManager::Prefetch(PageId start, int num_pages, BufferAccessStrategy *strategy) {
+    if (prefetcher_ != nullptr) prefetcher_->Prefetch(start, num_pages, strategy);
+}
+
+BufferPoolStats ParallelBufferPoolManager::GetStats() {
+    BufferPoolStats stats;
+    for (auto instance : instances_) {
+        stats += instance->GetStats();
+    }
+    return stats;
+}
+
+void ParallelBufferPoolManager::CancelPrefetch(int fd) {
+    if (prefetcher_ != nullptr) prefetcher_->Forget(fd);
+}
+
+void ParallelBufferPoolManager::DropCompressedPages(int fd) {
+    if (compressed_cache_ != nullptr) compressed_cache_->EraseFile(fd);
+}
+
+std::vector<PageId> ParallelBufferPoolManager::GetResidentPages() {
+    std::vector<std::vector<PageId>> instance_pages;
+    size_t max_size = 0;
+    for (auto instance : instances_) {
+        instance_pages.push_back(instance->GetResidentPages());
+        max_size = std::max(max_size, instance_pages.back().size());
+    }
+    std::vector<PageId> page_ids;
+    for (size_t i = 0; i < max_size; i++) {
+        for (auto &pages : instance_pages) {
+            if (i < pages.size()) page_ids.push_back(pages[i]);
+        }
+    }
+    return page_ids;
+}
+
+size_t ParallelBufferPoolManager::Resize(size_t new_size) {
+    size_t pool_size = 0;
+    for (size_t i = 0; i < num_instances_; i++) {
+        size_t instance_size = new_size / num_instances_ + (i < new_size % num_instances_ ? 1 : 0);
+        pool_size += instances_[i]->Resize(instance_size);
+    }
+    return pool_size;
+}
+
+void ParallelBufferPoolManager::SetFileQuota(int fd, size_t max_frames) {
+    for (auto instance : instances_) {
+        instance->SetFileQuota(fd, (max_frames + num_instances_ - 1) / num_instances_);
+    }
+}
+
+size_t ParallelBufferPoolManager::GetFileFrames(int fd) {
+    size_t num_frames = 0;
+    for (auto instance : instances_) {
+        num_frames += instance->GetFileFrames(fd);
+    }
+    return num_frames;
+}
+
+void ParallelBufferPoolManager::DiscardPages(int fd) {
+    for (auto instance : instances_) {
+        instance->DiscardPages(fd);
+    }
+}
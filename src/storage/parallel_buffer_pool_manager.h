@@ -0,0 +1,122 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// parallel_buffer_pool_manager.h
+//
+// Identification: src/include/buffer/parallel_buffer_pool_manager.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+//===----------------------------------------------------------------------===//
+//
+//                         Rucbase
+//
+// parallel_buffer_pool_manager.h
+//
+// Identification: src/storage/parallel_buffer_pool_manager.h
+//
+// Copyright (c) 2022, RUC Deke Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "buffer_pool_manager.h"
+#include "buffer_pool_manager_instance.h"
+
+/**
+ * @brief 将缓冲池划分为num_instances个独立加锁的BufferPoolManagerInstance
+ * @note 每个PageId由PageIdHash映射到唯一的分片, 各分片拥有自己的page_table_, free_list_和replacer_,
+ * 访问不同分片的线程之间不会竞争同一把latch
+ */
+class ParallelBufferPoolManager : public BufferPoolManager {
+   public:
+    /**
+     * @brief Creates a new ParallelBufferPoolManager.
+     * @param num_instances the number of individual BufferPoolManagerInstances to store
+     * @param pool_size the pool size of each BufferPoolManagerInstance
+     * @note 各分片Resize可达到的最大帧数由buffer_pool_options.max_pool_size均分
+     * @param disk_manager the disk manager
+     * @param enable_cleaner 是否为每个分片启动后台写回线程
+     * @param enable_read_ahead 是否启动所有分片共用的预读线程
+     */
+    ParallelBufferPoolManager(size_t num_instances, size_t pool_size, DiskManager *disk_manager,
+                              bool enable_cleaner = false, bool enable_read_ahead = false);
+
+    /**
+     * @brief Destroys an existing ParallelBufferPoolManager.
+     */
+    ~ParallelBufferPoolManager() override;
+
+    /** @return size of the buffer pool, the sum of all instances */
+    size_t GetPoolSize() override;
+
+    Page *FetchPage(PageId page_id, BufferAccessStrategy *strategy = nullptr) override;
+
+    bool UnpinPage(PageId page_id, bool is_dirty) override;
+
+    bool FlushPage(PageId page_id) override;
+
+    Page *NewPage(PageId *page_id) override;
+
+    bool DeletePage(PageId page_id) override;
+
+    void FlushAllPages(int fd) override;
+
+    void ReleaseAccessStrategy(BufferAccessStrategy *strategy) override;
+
+    void Prefetch(PageId start, int num_pages, BufferAccessStrategy *strategy = nullptr) override;
+
+    /** @return 所有分片的统计计数之和 */
+    BufferPoolStats GetStats() override;
+
+    void CancelPrefetch(int fd) override;
+
+    void DropCompressedPages(int fd) override;
+
+    /**
+     * @return 依次轮流取各分片中的页面, 分片之间没有统一的访问顺序, 轮流合并使各分片按相同比例保留热点页面
+     */
+    std::vector<PageId> GetResidentPages() override;
+
+    /**
+     * @brief 将new_size均分给各分片, 依次调整各分片的帧数
+     * @return 所有分片调整后的帧数之和
+     */
+    size_t Resize(size_t new_size) override;
+
+    /**
+     * @brief 文件的页面分布在所有分片上, 每个分片的配额为max_frames均分后向上取整
+     */
+    void SetFileQuota(int fd, size_t max_frames) override;
+
+    /** @return 所有分片中文件fd占用的帧数之和 */
+    size_t GetFileFrames(int fd) override;
+
+    void DiscardPages(int fd) override;
+
+   private:
+    /**
+     * @brief 找到负责page_id的分片
+     */
+    BufferPoolManagerInstance *GetBufferPoolManager(PageId page_id) {
+        return instances_[PageIdHash()(page_id) % num_instances_];
+    }
+
+    size_t num_instances_;
+    DiskManager *disk_manager_;
+    std::vector<BufferPoolManagerInstance *> instances_;
+    /**
+     * @brief 所有分片共用的预读线程
+     * @note 相邻的页面分布在不同的分片上, 由一个预读线程统一检测顺序访问并合并读请求
+     */
+    std::unique_ptr<Prefetcher> prefetcher_;
+    /** 所有分片共用的压缩缓存, buffer_pool_options.compressed_cache_mb为0时为nullptr */
+    std::unique_ptr<CompressedPageCache> compressed_cache_;
+};
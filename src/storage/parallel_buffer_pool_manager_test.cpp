@@ -0,0 +1,205 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Rucbase
+//
+// parallel_buffer_pool_manager_test.cpp
+//
+// Identification: src/storage/parallel_buffer_pool_manager_test.cpp
+//
+// Copyright (c) 2022, RUC Deke Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "parallel_buffer_pool_manager.h"
+
+#include <cassert>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+const std::string TEST_DB_NAME = "ParallelBufferPoolManagerTest_db";  // 以TEST_DB_NAME作为存放测试文件的根目录名
+
+class ParallelBufferPoolManagerTest : public ::testing::Test {
+   public:
+    std::unique_ptr<DiskManager> disk_manager_;
+
+   public:
+    // This function is called before every test.
+    void SetUp() override {
+        ::testing::Test::SetUp();
+        disk_manager_ = std::make_unique<DiskManager>();
+        // 如果测试目录存在，则先删除原目录
+        if (disk_manager_->is_dir(TEST_DB_NAME)) {
+            disk_manager_->destroy_dir(TEST_DB_NAME);
+        }
+        disk_manager_->create_dir(TEST_DB_NAME);
+        assert(disk_manager_->is_dir(TEST_DB_NAME));
+        if (chdir(TEST_DB_NAME.c_str()) < 0) {
+            throw UnixError();
+        }
+    }
+
+    // This function is called after every test.
+    void TearDown() override {
+        if (chdir("..") < 0) {
+            throw UnixError();
+        }
+        assert(disk_manager_->is_dir(TEST_DB_NAME));
+    };
+};
+
+/**
+ * @brief 测试分片缓冲池的基本功能（单文件）
+ */
+TEST_F(ParallelBufferPoolManagerTest, SimpleTest) {
+    const std::string filename = "simple_test";
+
+    const size_t num_instances = 5;
+    const size_t pool_size = 10;
+    auto bpm = std::make_unique<ParallelBufferPoolManager>(num_instances, pool_size, disk_manager_.get());
+    EXPECT_EQ(num_instances * pool_size, bpm->GetPoolSize());
+
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+    PageId tmp_page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+
+    // Scenario: consecutive page_no are spread over all instances, so we can fill up the whole pool.
+    std::vector<PageId> page_ids;
+    for (size_t i = 0; i < bpm->GetPoolSize(); ++i) {
+        auto *page = bpm->NewPage(&tmp_page_id);
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ(static_cast<page_id_t>(i), tmp_page_id.page_no);
+        snprintf(page->GetData(), PAGE_SIZE, "Hello %d", tmp_page_id.page_no);
+        page_ids.push_back(tmp_page_id);
+    }
+
+    // Scenario: once every instance is full, no page_no should be consumed by a failed NewPage.
+    EXPECT_EQ(nullptr, bpm->NewPage(&tmp_page_id));
+    EXPECT_EQ(static_cast<page_id_t>(bpm->GetPoolSize()), disk_manager_->get_fd2pageno(fd));
+
+    // Scenario: unpin everything, flood the pool with new pages, and read back the old ones from disk.
+    for (auto &page_id : page_ids) {
+        EXPECT_EQ(true, bpm->UnpinPage(page_id, true));
+    }
+    for (size_t i = 0; i < bpm->GetPoolSize(); ++i) {
+        ASSERT_NE(nullptr, bpm->NewPage(&tmp_page_id));
+        EXPECT_EQ(true, bpm->UnpinPage(tmp_page_id, false));
+    }
+    for (auto &page_id : page_ids) {
+        auto *page = bpm->FetchPage(page_id);
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ(0, strcmp(page->GetData(), ("Hello " + std::to_string(page_id.page_no)).c_str()));
+        EXPECT_EQ(true, bpm->UnpinPage(page_id, false));
+        EXPECT_EQ(true, bpm->DeletePage(page_id));
+    }
+
+    bpm->FlushAllPages(fd);
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 多线程并发访问不同分片
+ */
+TEST_F(ParallelBufferPoolManagerTest, ConcurrencyTest) {
+    const int num_threads = 8;
+    const int num_pages = 256;
+    const int num_runs = 2000;
+    const std::string filename = "concurrency_test";
+
+    auto bpm = std::make_unique<ParallelBufferPoolManager>(4, 32, disk_manager_.get());
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+
+    for (int i = 0; i < num_pages; i++) {
+        PageId tmp_page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+        auto *page = bpm->NewPage(&tmp_page_id);
+        ASSERT_NE(nullptr, page);
+        strcpy(page->GetData(), std::to_string(tmp_page_id.page_no).c_str());
+        EXPECT_EQ(true, bpm->UnpinPage(tmp_page_id, true));
+    }
+
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.emplace_back([&bpm, tid, fd]() {
+            for (int r = 0; r < num_runs; r++) {
+                PageId page_id = {.fd = fd, .page_no = (tid * 31 + r * 7) % num_pages};
+                auto *page = bpm->FetchPage(page_id);
+                while (page == nullptr) {
+                    page = bpm->FetchPage(page_id);
+                }
+                page->RLatch();
+                EXPECT_EQ(0, strcmp(page->GetData(), std::to_string(page_id.page_no).c_str()));
+                page->RUnlatch();
+                EXPECT_EQ(true, bpm->UnpinPage(page_id, false));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    bpm->FlushAllPages(fd);
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 顺序访问触发预读, 显式的Prefetch提示将页面读入缓冲池
+ */
+TEST_F(ParallelBufferPoolManagerTest, ReadAheadTest) {
+    const int num_pages = 4 * READ_AHEAD_PAGES;
+    const std::string filename = "read_ahead_test";
+
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+    {
+        auto bpm = std::make_unique<ParallelBufferPoolManager>(4, 64, disk_manager_.get());
+        for (int i = 0; i < num_pages; i++) {
+            PageId tmp_page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+            auto *page = bpm->NewPage(&tmp_page_id);
+            ASSERT_NE(nullptr, page);
+            strcpy(page->GetData(), std::to_string(tmp_page_id.page_no).c_str());
+            EXPECT_EQ(true, bpm->UnpinPage(tmp_page_id, true));
+        }
+        bpm->FlushAllPages(fd);
+    }
+
+    auto bpm = std::make_unique<ParallelBufferPoolManager>(4, 64, disk_manager_.get(), false, true);
+    auto wait_prefetched = [&bpm](size_t num) {
+        for (int i = 0; i < 1000 && bpm->GetStats().prefetched_pages < num; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        EXPECT_EQ(num, bpm->GetStats().prefetched_pages);
+    };
+    auto fetch = [&bpm, fd](int page_no) {
+        PageId page_id = {.fd = fd, .page_no = page_no};
+        auto *page = bpm->FetchPage(page_id);
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ(0, strcmp(page->GetData(), std::to_string(page_no).c_str()));
+        EXPECT_EQ(true, bpm->UnpinPage(page_id, false));
+    };
+
+    // 顺序访问READ_AHEAD_TRIGGER个页面后, 之后的READ_AHEAD_PAGES个页面被预读
+    for (int i = 0; i < READ_AHEAD_TRIGGER; i++) {
+        fetch(i);
+    }
+    wait_prefetched(READ_AHEAD_PAGES);
+    for (int i = READ_AHEAD_TRIGGER; i < READ_AHEAD_TRIGGER + READ_AHEAD_PAGES / 2; i++) {
+        fetch(i);
+    }
+    EXPECT_EQ(READ_AHEAD_PAGES / 2, bpm->GetStats().prefetch_hits);
+
+    // 显式预读文件末尾的页面, 超出文件末尾的部分被忽略
+    bpm->Prefetch(PageId{fd, num_pages - 8}, 16);
+    wait_prefetched(READ_AHEAD_PAGES + 8);
+    size_t hits = bpm->GetStats().prefetch_hits;
+    for (int i = num_pages - 8; i < num_pages; i++) {
+        fetch(i);
+    }
+    EXPECT_EQ(hits + 8, bpm->GetStats().prefetch_hits);
+
+    bpm->FlushAllPages(fd);
+    disk_manager_->close_file(fd);
+}
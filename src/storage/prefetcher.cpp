@@ -0,0 +1,163 @@
+#include "prefetcher.h"
+
+#include <algorithm>
+
+#include "buffer_pool_manager_instance.h"
+
+Prefetcher::Prefetcher(DiskManager *disk_manager, Router router)
+    : disk_manager_(disk_manager), router_(std::move(router)) {
+    worker_ = std::thread(&Prefetcher::Run, this);
+}
+
+Prefetcher::~Prefetcher() {
+    {
+        std::scoped_lock lock{latch_};
+        stop_ = true;
+    }
+    cv_.notify_all();
+    worker_.join();
+}
+
+void Prefetcher::Prefetch(PageId start, int num_pages, BufferAccessStrategy *strategy) {
+    if (num_pages <= 0) return;
+    {
+        std::scoped_lock lock{latch_};
+        Stream &stream = streams_[start.fd];
+        stream.prefetched_until = std::max(stream.prefetched_until, start.page_no + num_pages);
+        requests_.push_back({start, num_pages, strategy});
+    }
+    cv_.notify_one();
+}
+
+void Prefetcher::RecordAccess(PageId page_id, BufferAccessStrategy *strategy) {
+    {
+        std::scoped_lock lock{latch_};
+        Stream &stream = streams_[page_id.fd];
+        // 中间的页面可能已在缓冲池中(命中时不会调用RecordAccess), 小范围的向前跳跃也视为顺序访问
+        if (page_id.page_no > stream.last_page_no && page_id.page_no - stream.last_page_no <= READ_AHEAD_PAGES) {
+            stream.run++;
+        } else {
+            stream.run = 1;
+            stream.prefetched_until = page_id.page_no + 1;
+        }
+        stream.last_page_no = page_id.page_no;
+        // 已预读但尚未访问的页面不足半个窗口时, 继续预读下一段
+        if (stream.run < READ_AHEAD_TRIGGER || stream.prefetched_until - page_id.page_no > READ_AHEAD_PAGES / 2) {
+            return;
+        }
+        page_id_t start = std::max(stream.prefetched_until, page_id.page_no + 1);
+        page_id_t end = page_id.page_no + 1 + READ_AHEAD_PAGES;
+        stream.prefetched_until = end;
+        requests_.push_back({PageId{page_id.fd, start}, end - start, strategy});
+    }
+    cv_.notify_one();
+}
+
+void Prefetcher::Forget(BufferAccessStrategy *strategy) {
+    std::unique_lock lock{latch_};
+    requests_.erase(std::remove_if(requests_.begin(), requests_.end(),
+                                   [strategy](const Request &request) { return request.strategy == strategy; }),
+                    requests_.end());
+    idle_cv_.wait(lock, [this, strategy] { return !busy_ || busy_strategy_ != strategy; });
+}
+
+void Prefetcher::Forget(int fd) {
+    std::unique_lock lock{latch_};
+    requests_.erase(std::remove_if(requests_.begin(), requests_.end(),
+                                   [fd](const Request &request) { return request.start.fd == fd; }),
+                    requests_.end());
+    streams_.erase(fd);
+    idle_cv_.wait(lock, [this, fd] { return !busy_ || busy_fd_ != fd; });
+}
+
+/**
+ * @brief 预读线程的主循环
+ */
+void Prefetcher::Run() {
+    std::unique_lock lock{latch_};
+    while (true) {
+        cv_.wait(lock, [this] { return stop_ || !requests_.empty(); });
+        if (stop_) break;
+        Request request = requests_.front();
+        requests_.pop_front();
+        busy_ = true;
+        busy_strategy_ = request.strategy;
+        busy_fd_ = request.start.fd;
+        lock.unlock();
+        Process(request);
+        lock.lock();
+        busy_ = false;
+        busy_strategy_ = nullptr;
+        busy_fd_ = -1;
+        idle_cv_.notify_all();
+    }
+}
+
+/**
+ * @brief 为请求范围内不在缓冲池中的页面预留帧, 再将它们作为一批读请求读入
+ * @note 只预读已分配的页面(page_no < fd2pageno), 超出文件末尾的页面在读入后丢弃
+ */
+void Prefetcher::Process(const Request &request) {
+    const int fd = request.start.fd;
+    if (disk_manager_->is_read_only(fd)) {
+        // 只读文件的页面由映射直接访问, 不需要读入帧, 只提示内核预读映射
+        disk_manager_->advise_mapped_pages(fd, request.start.page_no, request.num_pages);
+        return;
+    }
+    page_id_t end = std::min(request.start.page_no + request.num_pages, disk_manager_->get_fd2pageno(fd));
+    // 已在缓冲池中或没有可用帧的页面断开连续的读, 每段连续的页面为一个读请求
+    std::vector<std::pair<BufferPoolManagerInstance *, Page *>> pages;
+    std::vector<size_t> run_begins;
+    for (page_id_t page_no = request.start.page_no; page_no < end; page_no++) {
+        PageId page_id{fd, page_no};
+        BufferPoolManagerInstance *bpm = router_(page_id);
+        Page *page = nullptr;
+        try {
+            page = bpm->ReservePage(page_id, request.strategy);
+        } catch (RedBaseError &e) {
+            page = nullptr;
+        }
+        if (page == nullptr) continue;
+        if (pages.empty() || pages.back().second->GetPageId().page_no != page_no - 1) {
+            run_begins.push_back(pages.size());
+        }
+        pages.emplace_back(bpm, page);
+    }
+    ReadPages(pages, run_begins);
+}
+
+/**
+ * @brief 将预留的页面读入帧中, 并结束这些帧的I/O状态
+ * @param pages 预留的页面, 按page_no排序
+ * @param run_begins 每段连续页面在pages中的起始位置
+ */
+void Prefetcher::ReadPages(const std::vector<std::pair<BufferPoolManagerInstance *, Page *>> &pages,
+                           const std::vector<size_t> &run_begins) {
+    if (pages.empty()) return;
+    IOBatch batch;
+    std::vector<char *> bufs;
+    for (size_t i = 0; i < run_begins.size(); i++) {
+        size_t run_end = i + 1 < run_begins.size() ? run_begins[i + 1] : pages.size();
+        bufs.clear();
+        for (size_t j = run_begins[i]; j < run_end; j++) {
+            bufs.push_back(pages[j].second->GetData());
+        }
+        batch.AddRead(pages[run_begins[i]].second->GetPageId().fd, pages[run_begins[i]].second->GetPageId().page_no,
+                      bufs.data(), static_cast<int>(bufs.size()));
+    }
+    try {
+        disk_manager_->submit_io(&batch);
+    } catch (RedBaseError &e) {
+        // 预留帧之后文件末尾的页面被释放, 放弃这次预读
+        for (auto &[bpm, page] : pages) bpm->CompleteReservedPage(page, false);
+        return;
+    }
+    disk_manager_->wait_io(&batch);
+    // 请求与pages按顺序对应, 每个请求中完整读出的页面读入成功
+    size_t index = 0;
+    for (auto &request : batch.Requests()) {
+        for (int i = 0; i < request.num_pages; i++, index++) {
+            pages[index].first->CompleteReservedPage(pages[index].second, i < request.PagesDone());
+        }
+    }
+}
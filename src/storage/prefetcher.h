@@ -0,0 +1,106 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Rucbase
+//
+// prefetcher.h
+//
+// Identification: src/storage/prefetcher.h
+//
+// Copyright (c) 2022, RUC Deke Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <functional>
+#include <mutex>   // NOLINT
+#include <thread>  // NOLINT
+#include <unordered_map>
+#include <vector>
+
+#include "common/macros.h"
+#include "disk_manager.h"
+#include "page.h"
+
+class BufferAccessStrategy;
+class BufferPoolManagerInstance;
+
+/**
+ * @brief 缓冲池的预读线程
+ * @note 检测每个文件上的顺序访问, 提前将之后的READ_AHEAD_PAGES个页面读入缓冲池; 也接受上层显式的Prefetch提示.
+ * 相邻的页面合并为一个读请求, 一次预读的所有请求作为一批异步提交, 读入期间帧处于io_in_progress_状态, 访问这些页面的线程等待读入完成.
+ * 这样冷数据上的全表扫描由大块读驱动, 不再每缺一页就同步读4KB.
+ */
+class Prefetcher {
+   public:
+    /** 返回负责page_id的缓冲池分片 */
+    using Router = std::function<BufferPoolManagerInstance *(PageId)>;
+
+    Prefetcher(DiskManager *disk_manager, Router router);
+
+    ~Prefetcher();
+
+    DISALLOW_COPY(Prefetcher);
+
+    /**
+     * @brief 异步预读[start.page_no, start.page_no + num_pages)中不在缓冲池中的页面
+     * @param strategy 读入页面时使用的访问策略, 可以为nullptr
+     */
+    void Prefetch(PageId start, int num_pages, BufferAccessStrategy *strategy);
+
+    /**
+     * @brief 记录一次页面访问, 检测到顺序访问时提交下一段预读
+     * @note 缓冲池只在缺页或第一次命中预读的页面时调用, 普通的命中不经过预读线程
+     */
+    void RecordAccess(PageId page_id, BufferAccessStrategy *strategy);
+
+    /**
+     * @brief 丢弃使用strategy的预读请求, 并等待正在进行的使用strategy的预读结束
+     * @note strategy析构前调用, 之后预读线程不会再访问strategy
+     */
+    void Forget(BufferAccessStrategy *strategy);
+
+    /**
+     * @brief 丢弃文件fd上的预读请求和顺序访问状态, 并等待正在进行的fd上的预读结束
+     * @note 关闭文件前调用
+     */
+    void Forget(int fd);
+
+   private:
+    struct Request {
+        PageId start;
+        int num_pages;
+        BufferAccessStrategy *strategy;
+    };
+
+    /** 一个文件上的顺序访问状态 */
+    struct Stream {
+        page_id_t last_page_no = INVALID_PAGE_ID;  // 上一次访问的页面
+        int run = 0;                               // 连续顺序访问的次数
+        page_id_t prefetched_until = 0;            // 已提交预读的页面的上界(不含)
+    };
+
+    void Run();
+
+    void Process(const Request &request);
+
+    void ReadPages(const std::vector<std::pair<BufferPoolManagerInstance *, Page *>> &pages,
+                   const std::vector<size_t> &run_begins);
+
+    DiskManager *disk_manager_;
+    Router router_;
+
+    std::mutex latch_;                 // 保护以下成员
+    std::condition_variable cv_;       // 有新的请求或需要退出
+    std::condition_variable idle_cv_;  // 当前请求处理完毕
+    std::deque<Request> requests_;
+    std::unordered_map<int, Stream> streams_;  // fd -> Stream
+    bool busy_ = false;                         // 是否正在处理请求
+    BufferAccessStrategy *busy_strategy_ = nullptr;
+    int busy_fd_ = -1;
+    bool stop_ = false;
+
+    std::thread worker_;
+};
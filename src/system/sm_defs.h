@@ -4,3 +4,4 @@
 #include <string>
 
 static const std::string DB_META_NAME = "db.meta";
+static const std::string DB_WARM_PAGES_NAME = "db.warm";  // 关闭数据库时缓冲池中的页面, 重启后用于预热
@@ -1,11 +1,16 @@
 #undef NDEBUG
 
 #include <cassert>
+#include <chrono>  // NOLINT
+#include <fstream>
 #include <string>
+#include <thread>  // NOLINT
 
 #include "gtest/gtest.h"
 #include "record/rm_manager.h"
 #include "sm.h"
+#include "storage/buffer_pool_manager_instance.h"
+#include "storage/parallel_buffer_pool_manager.h"
 #define BUFFER_LENGTH 8192
 
 // 测试SmManager的函数
@@ -16,7 +21,7 @@ TEST(SystemManagerTest, SimpleTest) {
 
     // 创建SmManager类的对象sm_manager
     auto disk_manager = std::make_unique<DiskManager>();
-    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto buffer_pool_manager = std::make_unique<BufferPoolManagerInstance>(BUFFER_POOL_SIZE, disk_manager.get());
     auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
     auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
     auto sm_manager =
@@ -87,4 +92,120 @@ TEST(SystemManagerTest, SimpleTest) {
     // Clean up
     sm_manager->close_db();
     sm_manager->drop_db(db);
-}
\ No newline at end of file
+}
+// 关闭数据库时保存缓冲池中的页面, 重新打开后在后台预读这些页面
+TEST(SystemManagerTest, WarmRestartTest) {
+    std::string db = "warm_db";
+    std::string tab = "tab";
+    char *result = new char[BUFFER_LENGTH];
+    int offset = 0;
+    Context *context = new Context(nullptr, nullptr, nullptr, result, &offset);
+    std::vector<ColDef> col_defs = {{.name = "a", .type = TYPE_INT, .len = 4},
+                                    {.name = "c", .type = TYPE_STRING, .len = 256}};
+
+    auto disk_manager = std::make_unique<DiskManager>();
+    size_t num_warm_pages = 0;
+    {
+        auto buffer_pool_manager =
+            std::make_unique<ParallelBufferPoolManager>(4, 64, disk_manager.get(), false, true);
+        auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+        auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
+        SmManager sm_manager(disk_manager.get(), buffer_pool_manager.get(), rm_manager.get(), ix_manager.get());
+        if (sm_manager.is_dir(db)) {
+            sm_manager.drop_db(db);
+        }
+        sm_manager.create_db(db);
+        sm_manager.open_db(db);
+        sm_manager.create_table(tab, col_defs, context);
+        char buf[260] = {};
+        for (int i = 0; i < 600; i++) {
+            *reinterpret_cast<int *>(buf) = i;
+            sm_manager.fhs_.at(tab)->insert_record(buf, context);
+        }
+        sm_manager.close_db();
+
+        std::ifstream ifs(db + "/" + DB_WARM_PAGES_NAME);
+        std::string file_name;
+        int page_no;
+        while (ifs >> file_name >> page_no) {
+            EXPECT_EQ(file_name, tab);
+            num_warm_pages++;
+        }
+        EXPECT_GT(num_warm_pages, 0);
+    }
+
+    // 新的缓冲池模拟重启后的空缓冲池
+    auto buffer_pool_manager = std::make_unique<ParallelBufferPoolManager>(4, 64, disk_manager.get(), false, true);
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+    auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
+    SmManager sm_manager(disk_manager.get(), buffer_pool_manager.get(), rm_manager.get(), ix_manager.get());
+    sm_manager.open_db(db);
+    for (int i = 0; i < 500 && buffer_pool_manager->GetStats().prefetched_pages < num_warm_pages; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(num_warm_pages, buffer_pool_manager->GetStats().prefetched_pages);
+    EXPECT_EQ(num_warm_pages, buffer_pool_manager->GetResidentPages().size());
+    sm_manager.close_db();
+    sm_manager.drop_db(db);
+    delete context;
+    delete[] result;
+}
+
+// 为大表设置配额后, 向大表批量插入记录不会挤出其他表的页面; 配额随元数据保存
+TEST(SystemManagerTest, TableQuotaTest) {
+    std::string db = "quota_db";
+    std::string hot_tab = "hot";
+    std::string bulk_tab = "bulk";
+    const size_t quota = 8;
+    char *result = new char[BUFFER_LENGTH];
+    int offset = 0;
+    Context *context = new Context(nullptr, nullptr, nullptr, result, &offset);
+    std::vector<ColDef> col_defs = {{.name = "a", .type = TYPE_INT, .len = 4},
+                                    {.name = "c", .type = TYPE_STRING, .len = 256}};
+
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManagerInstance>(64, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+    auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
+    SmManager sm_manager(disk_manager.get(), buffer_pool_manager.get(), rm_manager.get(), ix_manager.get());
+    if (sm_manager.is_dir(db)) {
+        sm_manager.drop_db(db);
+    }
+    sm_manager.create_db(db);
+    sm_manager.open_db(db);
+    sm_manager.create_table(hot_tab, col_defs, context);
+    sm_manager.create_table(bulk_tab, col_defs, context);
+    sm_manager.set_option(bulk_tab, "buffer_pool_quota", quota, context);
+    EXPECT_THROW(sm_manager.set_option(bulk_tab, "no_such_option", 1, context), ConfigError);
+
+    char buf[260] = {};
+    for (int i = 0; i < 100; i++) {
+        *reinterpret_cast<int *>(buf) = i;
+        sm_manager.fhs_.at(hot_tab)->insert_record(buf, context);
+    }
+    int hot_fd = sm_manager.fhs_.at(hot_tab)->GetFd();
+    int bulk_fd = sm_manager.fhs_.at(bulk_tab)->GetFd();
+    size_t hot_frames = buffer_pool_manager->GetFileFrames(hot_fd);
+    EXPECT_GT(hot_frames, 0);
+    // 大表的页面数远多于缓冲池的帧数
+    for (int i = 0; i < 2000; i++) {
+        *reinterpret_cast<int *>(buf) = i;
+        sm_manager.fhs_.at(bulk_tab)->insert_record(buf, context);
+    }
+    EXPECT_EQ(hot_frames, buffer_pool_manager->GetFileFrames(hot_fd));
+    EXPECT_EQ(64 - hot_frames, buffer_pool_manager->GetFileFrames(bulk_fd));
+    EXPECT_GT(buffer_pool_manager->GetStats().quota_evictions, 0);
+
+    offset = 0;
+    sm_manager.show_option("buffer_pool", context);
+    EXPECT_NE(std::string::npos, std::string(result, offset).find(std::to_string(quota)));
+
+    sm_manager.close_db();
+    sm_manager.open_db(db);
+    EXPECT_EQ(quota, sm_manager.db_.get_table(bulk_tab).buffer_pool_quota);
+    EXPECT_EQ(0, sm_manager.db_.get_table(hot_tab).buffer_pool_quota);
+    sm_manager.close_db();
+    sm_manager.drop_db(db);
+    delete context;
+    delete[] result;
+}
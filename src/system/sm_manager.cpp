@@ -3,11 +3,13 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <fstream>
 
 #include "index/ix.h"
 #include "record/rm.h"
 #include "record_printer.h"
+#include "storage/buffer_pool_options.h"
 
 #define DEBUG 0
 
@@ -66,20 +68,25 @@ void SmManager::open_db(const std::string &db_name) {
     ifs >> db_;  // 注意：此处重载了操作符>>
     if(DEBUG) printf("success b\n");
     // Open all record files & index files
+    // mmap_read_only时只读打开并映射已有的数据文件, 用于只读的报表副本, 修改这些表时抛出FileReadOnlyError
+    const bool read_only = buffer_pool_options.mmap_read_only;
+    const bool direct_io = buffer_pool_options.direct_io;
     for (auto &entry : db_.tabs_) {
         auto &tab = entry.second;
         // fhs_[tab.name] = rm_manager_->open_file(tab.name);
-        fhs_.emplace(tab.name, rm_manager_->open_file(tab.name));
+        fhs_.emplace(tab.name, rm_manager_->open_file(tab.name, read_only, direct_io));
         for (size_t i = 0; i < tab.cols.size(); i++) {
             auto &col = tab.cols[i];
             if (col.index) {
                 auto index_name = ix_manager_->get_index_name(tab.name, i);
                 assert(ihs_.count(index_name) == 0);
                 // ihs_[index_name] = ix_manager_->open_index(tab.name, i);
-                ihs_.emplace(index_name, ix_manager_->open_index(tab.name, i));
+                ihs_.emplace(index_name, ix_manager_->open_index(tab.name, i, read_only, direct_io));
             }
         }
+        apply_buffer_pool_quota(tab);
     }
+    load_warm_pages();
     if(DEBUG) printf("end open db\n");
 }
 
@@ -90,6 +97,8 @@ void SmManager::close_db() {
     // 清理fhs_, ihs_
     // lab3 task1 Todo End
     if(DEBUG) printf("start close db\n");
+    // 必须在关闭文件之前保存, 文件关闭后其页面不再属于当前数据库
+    save_warm_pages();
     std::ofstream ofs(DB_META_NAME);
     ofs << db_;
     db_.name_.clear();
@@ -109,6 +118,78 @@ void SmManager::close_db() {
     if(DEBUG) printf("end close db\n");
 }
 
+std::unordered_map<int, std::string> SmManager::get_open_files() {
+    std::unordered_map<int, std::string> files;
+    for (auto &entry : fhs_) {
+        files[entry.second->GetFd()] = entry.first;
+    }
+    for (auto &entry : ihs_) {
+        files[entry.second->GetFd()] = entry.first;
+    }
+    return files;
+}
+
+/**
+ * @brief 将缓冲池中属于当前数据库的页面按从新到旧的顺序写入DB_WARM_PAGES_NAME, 每行为"文件名 page_no"
+ * @note 只保存页面编号, 页面内容在关闭文件时已经写回
+ */
+void SmManager::save_warm_pages() {
+    std::unordered_map<int, std::string> files = get_open_files();
+    std::ofstream ofs(DB_WARM_PAGES_NAME);
+    for (auto &page_id : buffer_pool_manager_->GetResidentPages()) {
+        auto it = files.find(page_id.fd);
+        if (it == files.end()) continue;
+        ofs << it->second << ' ' << page_id.page_no << '\n';
+    }
+}
+
+/**
+ * @brief 将表的帧数配额设置到表的记录文件和所有索引文件上
+ */
+void SmManager::apply_buffer_pool_quota(const TabMeta &tab) {
+    buffer_pool_manager_->SetFileQuota(fhs_.at(tab.name)->GetFd(), tab.buffer_pool_quota);
+    for (size_t i = 0; i < tab.cols.size(); i++) {
+        if (!tab.cols[i].index) continue;
+        auto index_name = ix_manager_->get_index_name(tab.name, i);
+        buffer_pool_manager_->SetFileQuota(ihs_.at(index_name)->GetFd(), tab.buffer_pool_quota);
+    }
+}
+
+/**
+ * @brief 用关闭数据库时保存的页面预热缓冲池
+ * @note 取最近访问的GetPoolSize()个页面, 按文件和page_no排序后将连续的页面合并为一次Prefetch,
+ * 由预读线程在后台用大块读读入; open_db不等待预热完成, 预热期间查询照常执行
+ */
+void SmManager::load_warm_pages() {
+    std::ifstream ifs(DB_WARM_PAGES_NAME);
+    if (!ifs) return;
+    std::unordered_map<std::string, int> fds;
+    for (auto &entry : get_open_files()) {
+        fds[entry.second] = entry.first;
+    }
+    std::vector<PageId> page_ids;
+    std::string file_name;
+    page_id_t page_no;
+    while (page_ids.size() < buffer_pool_manager_->GetPoolSize() && ifs >> file_name >> page_no) {
+        auto it = fds.find(file_name);
+        // 文件可能已被删除, 或在上次关闭后被截断
+        if (it == fds.end() || page_no < 0 || page_no >= disk_manager_->get_fd2pageno(it->second)) continue;
+        page_ids.push_back(PageId{it->second, page_no});
+    }
+    std::sort(page_ids.begin(), page_ids.end(), [](const PageId &a, const PageId &b) {
+        return a.fd != b.fd ? a.fd < b.fd : a.page_no < b.page_no;
+    });
+    for (size_t i = 0; i < page_ids.size();) {
+        size_t j = i + 1;
+        while (j < page_ids.size() && page_ids[j].fd == page_ids[i].fd &&
+               page_ids[j].page_no == page_ids[j - 1].page_no + 1) {
+            j++;
+        }
+        buffer_pool_manager_->Prefetch(page_ids[i], static_cast<int>(j - i));
+        i = j;
+    }
+}
+
 void SmManager::show_tables(Context *context) {    
     if(DEBUG) printf("start show table\n");
     RecordPrinter printer(1);
@@ -123,6 +204,60 @@ void SmManager::show_tables(Context *context) {
     if(DEBUG) printf("end show table\n");
 }
 
+void SmManager::set_option(const std::string &tab_name, const std::string &name, int value, Context *context) {
+    std::string result;
+    if (!tab_name.empty()) {
+        TabMeta &tab = db_.get_table(tab_name);
+        if (name != "buffer_pool_quota") throw ConfigError(tab_name + "." + name);
+        if (value < 0) throw ConfigError(tab_name + "." + name, std::to_string(value));
+        tab.buffer_pool_quota = static_cast<size_t>(value);
+        apply_buffer_pool_quota(tab);
+        result = std::to_string(tab.buffer_pool_quota);
+    } else if (name == "buffer_pool_size") {
+        if (value < 1) throw ConfigError(name, std::to_string(value));
+        buffer_pool_options.pool_size = buffer_pool_manager_->Resize(static_cast<size_t>(value));
+        result = std::to_string(buffer_pool_options.pool_size);
+    } else {
+        throw ConfigError(name);
+    }
+    RecordPrinter printer(2);
+    printer.print_separator(context);
+    printer.print_record({"Option", "Value"}, context);
+    printer.print_separator(context);
+    printer.print_record({tab_name.empty() ? name : tab_name + "." + name, result}, context);
+    printer.print_separator(context);
+}
+
+void SmManager::show_option(const std::string &name, Context *context) {
+    if (name == "buffer_pool_size") {
+        RecordPrinter printer(2);
+        printer.print_separator(context);
+        printer.print_record({"Option", "Value"}, context);
+        printer.print_separator(context);
+        printer.print_record({name, std::to_string(buffer_pool_manager_->GetPoolSize())}, context);
+        printer.print_separator(context);
+        return;
+    }
+    if (name != "buffer_pool") throw ConfigError(name);
+    RecordPrinter printer(3);
+    printer.print_separator(context);
+    printer.print_record({"File", "Frames", "Quota"}, context);
+    printer.print_separator(context);
+    for (auto &entry : db_.tabs_) {
+        auto &tab = entry.second;
+        std::string quota = tab.buffer_pool_quota == 0 ? "-" : std::to_string(tab.buffer_pool_quota);
+        int fd = fhs_.at(tab.name)->GetFd();
+        printer.print_record({tab.name, std::to_string(buffer_pool_manager_->GetFileFrames(fd)), quota}, context);
+        for (size_t i = 0; i < tab.cols.size(); i++) {
+            if (!tab.cols[i].index) continue;
+            auto index_name = ix_manager_->get_index_name(tab.name, i);
+            fd = ihs_.at(index_name)->GetFd();
+            printer.print_record({index_name, std::to_string(buffer_pool_manager_->GetFileFrames(fd)), quota}, context);
+        }
+    }
+    printer.print_separator(context);
+}
+
 void SmManager::desc_table(const std::string &tab_name, Context *context) {
     if(DEBUG) printf("start desc table\n");
     TabMeta &tab = db_.get_table(tab_name);
@@ -152,7 +287,11 @@ void SmManager::create_table(const std::string &tab_name, const std::vector<ColD
     int curr_offset = 0;
     TabMeta tab;
     tab.name = tab_name;
+    std::vector<RmVarField> var_fields;  // VARCHAR列只存储实际长度
     for (auto &col_def : col_defs) {
+        if (col_def.type == TYPE_VARCHAR) {
+            var_fields.push_back(RmVarField{.offset = curr_offset, .len = col_def.len});
+        }
         ColMeta col = {.tab_name = tab_name,
                        .name = col_def.name,
                        .type = col_def.type,
@@ -164,10 +303,10 @@ void SmManager::create_table(const std::string &tab_name, const std::vector<ColD
     }
     // Create & open record file
     int record_size = curr_offset;  // record_size就是col meta所占的大小（表的元数据也是以记录的形式进行存储的）
-    rm_manager_->create_file(tab_name, record_size);
+    rm_manager_->create_file(tab_name, record_size, var_fields);
     db_.tabs_[tab_name] = tab;
     // fhs_[tab_name] = rm_manager_->open_file(tab_name);
-    fhs_.emplace(tab_name, rm_manager_->open_file(tab_name));
+    fhs_.emplace(tab_name, rm_manager_->open_file(tab_name, false, buffer_pool_options.direct_io));
     if(DEBUG) printf("end create table\n");
 }
 
@@ -204,15 +343,26 @@ void SmManager::create_index(const std::string &tab_name, const std::string &col
     int col_idx = col - tab.cols.begin();
     ix_manager_->create_index(tab_name, col_idx, col->type, col->len);  // 这里调用了
     // Open index file
-    auto ih = ix_manager_->open_index(tab_name, col_idx);
+    auto ih = ix_manager_->open_index(tab_name, col_idx, false, buffer_pool_options.direct_io);
+    // 建索引时插入的索引页面同样受表的配额限制
+    buffer_pool_manager_->SetFileQuota(ih->GetFd(), tab.buffer_pool_quota);
     // Get record file handle
     auto file_handle = fhs_.at(tab_name).get();
     // Index all records into index
-    for (RmScan rm_scan(file_handle); !rm_scan.is_end(); rm_scan.next()) {
-        auto rec = file_handle->get_record(rm_scan.rid(), context);  // rid是record的存储位置，作为value插入到索引里
-        const char *key = rec->data + col->offset;
-        // record data里以各个属性的offset进行分隔，属性的长度为col len，record里面每个属性的数据作为key插入索引里
-        ih->insert_entry(key, rm_scan.rid(), context->txn_);
+    // 大表建索引时通过ring扫描, 避免挤出缓冲池中的热点页面
+    std::unique_ptr<BufferAccessStrategy> strategy;
+    if (BufferAccessStrategy::IsLargeScan(buffer_pool_manager_, file_handle->get_file_hdr().num_pages)) {
+        strategy = std::make_unique<BufferAccessStrategy>(buffer_pool_manager_);
+    }
+    // 按页面批量扫描, 每个页面只固定一次, 记录直接在页面中读取
+    RmScanBatch batch;
+    for (RmScan rm_scan(file_handle, strategy.get()); rm_scan.next_batch(&batch);) {
+        for (size_t i = 0; i < batch.size(); i++) {
+            RmRecordView rec = batch.get_record_view(i);  // rid是record的存储位置，作为value插入到索引里
+            const char *key = rec.data() + col->offset;
+            // record data里以各个属性的offset进行分隔，属性的长度为col len，record里面每个属性的数据作为key插入索引里
+            ih->insert_entry(key, batch.rid(i), context->txn_);
+        }
     }
     // Store index handle
     auto index_name = ix_manager_->get_index_name(tab_name, col_idx);
@@ -89,6 +89,22 @@ class SmManager {
 
     void apply_drop_index(const std::string &tab_name, const std::string &col_name, Context *context);
 
+    // Administration
+    /**
+     * @brief SET [tab_name.]name = value; 在线修改运行时配置
+     * @note 全局配置支持buffer_pool_size(在线调整缓冲池帧数), 缩容时仍被固定的帧可能使实际帧数大于value;
+     * 表的配置支持buffer_pool_quota(表的每个文件在缓冲池中最多占用的帧数, 0表示不限制). 输出修改后的实际值
+     *
+     * @param tab_name 表名, 为空表示全局配置
+     */
+    void set_option(const std::string &tab_name, const std::string &name, int value, Context *context);
+
+    /**
+     * @brief SHOW name; 显示运行时状态
+     * @note 支持buffer_pool_size, 以及buffer_pool(每个表文件和索引文件占用的帧数和配额)
+     */
+    void show_option(const std::string &name, Context *context);
+
     // Transaction rollback management
     /**
      * @brief rollback the insert operation
@@ -147,4 +163,14 @@ class SmManager {
      * @param col_name the name of the column on which index is created
      */
     void rollback_drop_index(const std::string &tab_name, const std::string &col_name, Context *context);
+
+   private:
+    /** @return 当前数据库所有已打开的表文件和索引文件, fd -> 文件名 */
+    std::unordered_map<int, std::string> get_open_files();
+
+    void save_warm_pages();
+
+    void load_warm_pages();
+
+    void apply_buffer_pool_quota(const TabMeta &tab);
 };
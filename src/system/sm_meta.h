@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <cctype>
 #include <iostream>
 #include <map>
 #include <string>
@@ -32,6 +33,7 @@ struct TabMeta {
     std::string name;
     std::vector<ColMeta> cols;
     bool delete_mark_{false};
+    size_t buffer_pool_quota = 0;  // 表的每个文件(记录文件和索引文件)在缓冲池中最多占用的帧数, 0表示不限制
     /**
      * @brief 根据列名在本表元数据结构体中查找是否有该名字的列
      *
@@ -69,6 +71,7 @@ struct TabMeta {
         for (auto &col : tab.cols) {
             os << col << '\n';  // col是ColMeta类型，然后调用重载的ColMeta的操作符<<
         }
+        os << tab.buffer_pool_quota << '\n';
         return os;
     }
 
@@ -80,6 +83,9 @@ struct TabMeta {
             is >> col;
             tab.cols.push_back(col);
         }
+        // 旧版本的元数据中没有配额; 表名以字母开头, 下一个表不会被误读为配额
+        is >> std::ws;
+        if (std::isdigit(is.peek())) is >> tab.buffer_pool_quota;
         return is;
     }
 };
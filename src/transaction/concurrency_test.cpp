@@ -2,6 +2,7 @@
 #include "transaction_manager.h"
 #include "execution/execution_manager.h"
 #include "interp.h"
+#include "storage/buffer_pool_manager_instance.h"
 #include "gtest/gtest.h"
 
 #define BUFFER_LENGTH 8192
@@ -39,7 +40,7 @@ class ConcurrencyTest : public ::testing::Test {
     void SetUp() override {
         ::testing::Test::SetUp();
         disk_manager_ = std::make_unique<DiskManager>();
-        buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager_.get());
+        buffer_pool_manager = std::make_unique<BufferPoolManagerInstance>(BUFFER_POOL_SIZE, disk_manager_.get());
         rm_manager_ = std::make_unique<RmManager>(disk_manager_.get(), buffer_pool_manager.get());
         ix_manager_ = std::make_unique<IxManager>(disk_manager_.get(), buffer_pool_manager.get());
         sm_manager_ = std::make_unique<SmManager>(disk_manager_.get(), buffer_pool_manager.get(), rm_manager_.get(),
@@ -66,12 +67,14 @@ class ConcurrencyTest : public ::testing::Test {
         YY_BUFFER_STATE yy_buffer = yy_scan_string(sql.c_str());
         assert(yyparse() == 0 && ast::parse_tree != nullptr);
         yy_delete_buffer(yy_buffer);
+        // parse_tree是全局变量, 需在释放锁之前取出, 否则可能被其他线程的解析覆盖
+        auto parse_tree = ast::parse_tree;
         lock.unlock();
         memset(result, 0, BUFFER_LENGTH);
         *offset = 0;
         Context *context = new Context(lock_manager_.get(), log_manager_.get(),
                                        nullptr, result, offset);
-        interp_->interp_sql(ast::parse_tree, txn_id, context);  // 主要执行逻辑
+        interp_->interp_sql(parse_tree, txn_id, context);  // 主要执行逻辑
     }
 
     void RunLockOperation(Transaction *txn, const LockOperation &operation) {
@@ -3,7 +3,8 @@
 #include "gtest/gtest.h"
 #include "transaction_manager.h"
 #include "concurrency/lock_manager.h"
-#include "execution/execution_manager.h"
+#include "execution/execution_manager.h"
+#include "storage/buffer_pool_manager_instance.h"
 
 const std::string TEST_DB_NAME = "LockManagerTestDB";
 
@@ -22,7 +23,7 @@ class LockManagerTest : public ::testing::Test {
     void SetUp() override {
         ::testing::Test::SetUp();
         disk_manager_ = std::make_unique<DiskManager>();
-        buffer_pool_manager_ = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager_.get());
+        buffer_pool_manager_ = std::make_unique<BufferPoolManagerInstance>(BUFFER_POOL_SIZE, disk_manager_.get());
         rm_manager_ = std::make_unique<RmManager>(disk_manager_.get(), buffer_pool_manager_.get());
         ix_manager_ = std::make_unique<IxManager>(disk_manager_.get(), buffer_pool_manager_.get());
         sm_manager_ = std::make_unique<SmManager>(disk_manager_.get(), buffer_pool_manager_.get(), rm_manager_.get(),
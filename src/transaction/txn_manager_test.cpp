@@ -2,6 +2,7 @@
 #include "transaction_manager.h"
 #include "gtest/gtest.h"
 #include "interp.h"
+#include "storage/buffer_pool_manager_instance.h"
 
 #define BUFFER_LENGTH 8192
 
@@ -28,7 +29,7 @@ public:
         ::testing::Test::SetUp();
         // For each test, we create a new BufferPoolManager...
         disk_manager_ = std::make_unique<DiskManager>();
-        buffer_pool_manager_ = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager_.get());
+        buffer_pool_manager_ = std::make_unique<BufferPoolManagerInstance>(BUFFER_POOL_SIZE, disk_manager_.get());
         rm_manager_ = std::make_unique<RmManager>(disk_manager_.get(), buffer_pool_manager_.get());
         ix_manager_ = std::make_unique<IxManager>(disk_manager_.get(), buffer_pool_manager_.get());
         sm_manager_ = std::make_unique<SmManager>(disk_manager_.get(), buffer_pool_manager_.get(), rm_manager_.get(),